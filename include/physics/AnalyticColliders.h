@@ -0,0 +1,209 @@
+#pragma once
+
+#include <vector>
+#include <glm/glm.hpp>
+#include "physics/OGCContactModel.h"
+#include "physics/Parallel.h"
+#include "physics/SweepAndPrune.h"
+
+namespace Physics {
+
+/**
+ * @brief 解析碰撞體集合 (球、膠囊、定向盒、圓角盒、圓環、平面)
+ *
+ * 每種形狀有一個批次核心，以 SoA 方式一次對 8 個粒子計算有號距離與法線，
+ * 迴圈無資料相依分支，編譯器可把 8 個粒子映射到 SIMD 通道。
+ * 檢測時粒子按區塊平行處理，每組 8 個粒子只對寬相報告的候選碰撞體求值，
+ * 適合由大量膠囊串組成的角色碰撞代理。
+ *
+ * 碰撞體可作為運動學物體移動：setTransform 更新位姿，setVelocity 設定線速度與
+ * 角速度，接觸會帶上碰撞體在接觸點的速度。寬相為增量排序掃掠，
+ * 粒子組與碰撞體的 AABB 每幀更新後以插入排序維持順序，
+ * 每幀移動數百個碰撞體只需更新其 AABB。
+ */
+class AnalyticColliders {
+public:
+    /**
+     * @brief 形狀類型
+     */
+    enum class Type {
+        SPHERE,
+        CAPSULE,
+        ORIENTED_BOX,
+        ROUNDED_BOX,
+        TORUS,
+        PLANE
+    };
+
+    AnalyticColliders() = default;
+    ~AnalyticColliders() = default;
+
+    /**
+     * @brief 添加球
+     * @param center 球心
+     * @param radius 半徑
+     * @return 碰撞體索引
+     */
+    int addSphere(const glm::vec3& center, float radius);
+
+    /**
+     * @brief 添加膠囊 (線段 + 半徑)
+     * @param pointA 線段端點 A
+     * @param pointB 線段端點 B
+     * @param radius 半徑
+     * @return 碰撞體索引
+     */
+    int addCapsule(const glm::vec3& pointA, const glm::vec3& pointB, float radius);
+
+    /**
+     * @brief 添加定向盒
+     * @param center 中心
+     * @param halfExtents 局部座標半邊長
+     * @param rotation 旋轉 (各行為局部座標軸)
+     * @return 碰撞體索引
+     */
+    int addOrientedBox(const glm::vec3& center, const glm::vec3& halfExtents, const glm::mat3& rotation);
+
+    /**
+     * @brief 添加圓角盒
+     * @param center 中心
+     * @param halfExtents 局部座標半邊長 (含圓角)
+     * @param rotation 旋轉 (各行為局部座標軸)
+     * @param roundingRadius 圓角半徑
+     * @return 碰撞體索引
+     */
+    int addRoundedBox(const glm::vec3& center, const glm::vec3& halfExtents, const glm::mat3& rotation,
+                       float roundingRadius);
+
+    /**
+     * @brief 添加圓環
+     * @param center 中心
+     * @param axis 對稱軸
+     * @param majorRadius 主半徑 (中心到管中心)
+     * @param minorRadius 管半徑
+     * @return 碰撞體索引
+     */
+    int addTorus(const glm::vec3& center, const glm::vec3& axis, float majorRadius, float minorRadius);
+
+    /**
+     * @brief 添加無限平面 (法線側為外側)
+     * @param point 平面上一點
+     * @param normal 平面法線
+     * @return 碰撞體索引
+     */
+    int addPlane(const glm::vec3& point, const glm::vec3& normal);
+
+    /**
+     * @brief 設定碰撞體位姿 (運動學碰撞體)
+     *
+     * rotation 的各行為局部座標軸；膠囊、圓環的對稱軸與平面法線取局部 Y 軸，
+     * 球只使用中心。
+     *
+     * @param collider 碰撞體索引
+     * @param center 中心 (平面為平面上一點)
+     * @param rotation 旋轉
+     */
+    void setTransform(int collider, const glm::vec3& center, const glm::mat3& rotation);
+
+    /**
+     * @brief 設定碰撞體速度 (接觸點速度 = 線速度 + 角速度 × (接觸點 - 中心))
+     * @param collider 碰撞體索引
+     * @param linearVelocity 線速度
+     * @param angularVelocity 角速度
+     */
+    void setVelocity(int collider, const glm::vec3& linearVelocity, const glm::vec3& angularVelocity);
+
+    /**
+     * @brief 清除所有碰撞體
+     */
+    void clear() { m_shapes.clear(); }
+
+    size_t getColliderCount() const { return m_shapes.size(); }
+
+    /**
+     * @brief 批次計算一組粒子到單個碰撞體的有號距離與法線
+     * @param collider 碰撞體索引
+     * @param positions 查詢位置
+     * @param count 查詢數量
+     * @param distances 輸出有號距離 (內部為負)
+     * @param normals 輸出單位法線
+     */
+    void query(int collider, const glm::vec3* positions, int count, float* distances, glm::vec3* normals) const;
+
+    /**
+     * @brief 檢測粒子與所有碰撞體的接觸並追加 (接觸帶碰撞體在接觸點的速度)
+     * @param positions 粒子位置 (碰撞座標)
+     * @param particleRadius 粒子半徑
+     * @param contacts 輸出接觸列表 (追加)
+     * @param settings 平行設定
+     */
+    void detect(const std::vector<glm::vec3>& positions, float particleRadius,
+                std::vector<OGCContact>& contacts, const ParallelSettings& settings);
+
+    /**
+     * @brief 單點到最近碰撞體表面的有號距離
+     * @param position 查詢位置
+     * @return 有號距離 (沒有碰撞體時為 FLT_MAX)
+     */
+    float distance(const glm::vec3& position) const;
+
+private:
+    /**
+     * @brief 形狀參數 (局部座標軸為 axisX/axisY/axisZ)
+     *
+     * 膠囊與圓環的對稱軸、平面的法線都存在 axisY。
+     */
+    struct Shape {
+        Type type;
+        glm::vec3 center;       // 中心 (平面為平面上一點)
+        glm::vec3 axisX;
+        glm::vec3 axisY;
+        glm::vec3 axisZ;
+        glm::vec3 halfExtents;  // 盒半邊長；膠囊為 (0, 半長, 0)
+        float radius;           // 球/膠囊/圓環管半徑；圓角盒的圓角半徑
+        float majorRadius;      // 圓環主半徑
+        glm::vec3 linearVelocity;
+        glm::vec3 angularVelocity;
+    };
+
+    /**
+     * @brief 一組 8 個粒子的 SoA 暫存
+     */
+    struct Batch;
+
+    std::vector<Shape> m_shapes;
+    std::vector<std::vector<OGCContact>> m_blockContacts;  // 每個區塊的接觸緩衝
+
+    // 寬相：每組 8 個粒子為一個探針
+    SweepAndPrune m_broadphase;
+    std::vector<SweepAndPrune::Pair> m_pairs;
+    std::vector<int> m_groupOffsets;                       // 每組候選碰撞體的起點 (長度為組數 + 1)
+    std::vector<int> m_groupColliders;                     // 按組排列的候選碰撞體 (組內遞增)
+
+    /**
+     * @brief 以寬相建立每組粒子的候選碰撞體
+     * @param positions 粒子位置
+     * @param margin AABB 的膨脹量 (粒子半徑)
+     * @param settings 平行設定
+     */
+    void buildCandidates(const std::vector<glm::vec3>& positions, float margin, const ParallelSettings& settings);
+
+    /**
+     * @brief 形狀的 AABB (平面為無界)
+     */
+    static void shapeBounds(const Shape& shape, glm::vec3& boundsMin, glm::vec3& boundsMax);
+
+    /**
+     * @brief 對一組粒子求值單個碰撞體 (依類型分派到對應核心)
+     */
+    static void evaluate(const Shape& shape, Batch& batch);
+
+    // 各形狀的 8 通道批次核心
+    static void sphereKernel(const Shape& shape, Batch& batch);
+    static void capsuleKernel(const Shape& shape, Batch& batch);
+    static void boxKernel(const Shape& shape, float roundingRadius, Batch& batch);
+    static void torusKernel(const Shape& shape, Batch& batch);
+    static void planeKernel(const Shape& shape, Batch& batch);
+};
+
+} // namespace Physics
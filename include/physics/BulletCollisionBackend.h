@@ -0,0 +1,75 @@
+#pragma once
+
+#include "physics/CollisionBackend.h"
+
+class btCollisionObject;
+class btCollisionShape;
+class btCollisionWorld;
+class btDefaultCollisionConfiguration;
+class btCollisionDispatcher;
+class btDbvtBroadphase;
+class btPersistentManifold;
+
+namespace Physics {
+
+/**
+ * @brief Bullet Physics 碰撞後端
+ *
+ * 以 Bullet 的碰撞世界做粒子與圓柱、地板的離散檢測，並把接觸流形轉換為 OGC 接觸。
+ * 三角形網格不加入 Bullet 世界，與簡化後端共用 SAH BVH 最近點查詢。
+ * 只在找到 Bullet Physics 時編譯並註冊。
+ */
+class BulletCollisionBackend : public CollisionBackend {
+public:
+    BulletCollisionBackend();
+    ~BulletCollisionBackend() override;
+
+    const char* getName() const override { return "bullet"; }
+
+    void addCylinder(const glm::vec3& center, float radius, float height) override;
+    void addFloor(const glm::vec3& center, const glm::vec3& size) override;
+    void addTriangleMesh(const std::shared_ptr<TriangleMeshCollider>& mesh) override;
+    int addParticle(int particleIndex, const glm::vec3& position, float radius) override;
+    void updateParticlePosition(int handle, const glm::vec3& position) override;
+    void removeParticle(int handle) override;
+    float getContactThreshold() const override;
+    void performCollisionDetection(std::vector<OGCContact>& contacts, const ParallelSettings& settings,
+                                   const std::vector<char>* skipMask) override;
+
+    /**
+     * @brief 獲取碰撞世界
+     * @return Bullet碰撞世界指標
+     */
+    btCollisionWorld* getCollisionWorld() { return m_collisionWorld.get(); }
+
+private:
+    std::unique_ptr<btDefaultCollisionConfiguration> m_collisionConfig;
+    std::unique_ptr<btCollisionDispatcher> m_dispatcher;
+    std::unique_ptr<btDbvtBroadphase> m_broadphase;
+    std::unique_ptr<btCollisionWorld> m_collisionWorld;
+
+    std::vector<std::unique_ptr<btCollisionShape>> m_collisionShapes;
+    std::vector<std::unique_ptr<btCollisionObject>> m_staticObjects;
+    std::vector<std::unique_ptr<btCollisionObject>> m_particleObjects;   // 句柄即索引 (已移除者為空)
+    std::vector<std::shared_ptr<TriangleMeshCollider>> m_meshColliders;
+    std::vector<std::vector<OGCContact>> m_blockContacts;  // 每個粒子區塊的網格接觸緩衝
+
+    /**
+     * @brief 以形狀建立碰撞物件並加入碰撞世界
+     * @param shape 碰撞形狀 (所有權轉移給後端)
+     * @param position 位置
+     * @param userIndex 粒子索引 (-1 表示靜態物體)
+     * @return 碰撞物件
+     */
+    std::unique_ptr<btCollisionObject> createObject(std::unique_ptr<btCollisionShape> shape,
+                                                    const glm::vec3& position, int userIndex);
+
+    /**
+     * @brief 將 Bullet 接觸點轉換為 OGC 接觸並追加
+     * @param manifold Bullet 接觸流形
+     * @param contacts 輸出接觸列表
+     */
+    void convertBulletContacts(btPersistentManifold* manifold, std::vector<OGCContact>& contacts);
+};
+
+} // namespace Physics
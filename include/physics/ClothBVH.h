@@ -0,0 +1,140 @@
+#pragma once
+
+#include <vector>
+#include <glm/glm.hpp>
+#include "physics/OGCContactModel.h"
+#include "physics/Parallel.h"
+
+namespace Physics {
+
+/**
+ * @brief 布料三角形/邊的包圍體層次結構 (BVH)
+ *
+ * 由布料網格拓撲建立一次三角形 BVH 與邊 BVH，之後每步只自底向上平行重新擬合包圍盒；
+ * 當擬合後的 SAH 成本相對建立時劣化超過閾值才完整重建。
+ * 查詢以批次方式進行：一批相鄰的查詢共用一次遍歷，每個節點只讀取一次，
+ * 產生接觸半徑內的點-面 (VF) 與邊-邊 (EE) 接近對，輸出為多粒子 OGC 接觸。
+ */
+class ClothBVH {
+public:
+    ClothBVH();
+    ~ClothBVH() = default;
+
+    /**
+     * @brief 由網格拓撲建立三角形與邊列表
+     * @param width 網格寬度 (粒子數)
+     * @param height 網格高度 (粒子數)
+     */
+    void setGridTopology(int width, int height);
+
+    /**
+     * @brief 更新 BVH (首次或品質劣化時重建，否則重新擬合)
+     * @param positions 粒子位置 (碰撞座標)
+     * @param settings 平行設定
+     */
+    void update(const std::vector<glm::vec3>& positions, const ParallelSettings& settings);
+
+    /**
+     * @brief 檢測點-面與邊-邊接近對並追加接觸
+     * @param positions 粒子位置 (碰撞座標)
+     * @param contactRadius 接觸半徑 (OGCContactModel::getContactRadius)
+     * @param contacts 輸出接觸列表 (追加)
+     * @param settings 平行設定
+     */
+    void detect(const std::vector<glm::vec3>& positions, float contactRadius,
+                std::vector<OGCContact>& contacts, const ParallelSettings& settings);
+
+    // Getter 和 Setter
+    void setRebuildThreshold(float threshold) { m_rebuildThreshold = threshold; }
+    float getRebuildThreshold() const { return m_rebuildThreshold; }
+
+    void setExcludedRingDistance(int ring) { m_excludedRingDistance = ring; }
+    int getExcludedRingDistance() const { return m_excludedRingDistance; }
+
+    int getRebuildCount() const { return m_rebuildCount; }
+    size_t getTriangleCount() const { return m_triangles.size(); }
+    size_t getEdgeCount() const { return m_edges.size(); }
+
+private:
+    /**
+     * @brief BVH 節點
+     */
+    struct Node {
+        glm::vec3 boundsMin;    // 包圍盒最小點
+        glm::vec3 boundsMax;    // 包圍盒最大點
+        int first;              // 內部節點：左子節點索引 (右子節點為 first + 1)；葉節點：首個圖元位置
+        int count;              // 葉節點圖元數 (0 表示內部節點)
+    };
+
+    /**
+     * @brief 單一圖元類型的層次結構
+     */
+    struct Hierarchy {
+        std::vector<Node> nodes;                // 節點 (子節點索引總是大於父節點)
+        std::vector<int> primitiveOrder;        // 葉節點引用的圖元索引
+        std::vector<std::vector<int>> levels;   // 按深度分組的節點，用於逐層平行擬合
+        float builtCost = 0.0f;                 // 建立時的 SAH 成本
+    };
+
+    /**
+     * @brief 建立時待切分的節點範圍
+     */
+    struct BuildTask {
+        int node, begin, end, depth;
+    };
+
+    std::vector<glm::ivec3> m_triangles;        // 三角形頂點索引
+    std::vector<glm::ivec3> m_edges;            // 邊頂點索引 (z 不使用，為 -1)
+    Hierarchy m_triangleTree;
+    Hierarchy m_edgeTree;
+
+    // 建立時的暫存 (跨次重建重用，穩態下不配置)
+    std::vector<glm::vec3> m_buildBoundsMin;
+    std::vector<glm::vec3> m_buildBoundsMax;
+    std::vector<glm::vec3> m_buildCentroids;
+    std::vector<BuildTask> m_buildStack;
+
+    int m_gridWidth;
+    float m_rebuildThreshold;                   // 重建閾值 (擬合成本 / 建立成本)
+    int m_excludedRingDistance;                 // 排除的拓撲環距離
+    int m_rebuildCount;
+    bool m_built;
+
+    std::vector<std::vector<OGCContact>> m_batchContacts;  // 每批查詢的接觸緩衝
+
+    /**
+     * @brief 建立層次結構
+     */
+    void build(Hierarchy& tree, const std::vector<glm::ivec3>& primitives,
+               const std::vector<glm::vec3>& positions);
+
+    /**
+     * @brief 自底向上重新擬合層次結構
+     */
+    void refit(Hierarchy& tree, const std::vector<glm::ivec3>& primitives,
+               const std::vector<glm::vec3>& positions, const ParallelSettings& settings);
+
+    /**
+     * @brief 計算層次結構的 SAH 成本 (內部節點表面積總和 / 根節點表面積)
+     */
+    static float computeCost(const Hierarchy& tree);
+
+    /**
+     * @brief 批次遍歷：對一批查詢包圍盒收集重疊的葉圖元
+     * @param tree 層次結構
+     * @param queryMin 查詢包圍盒最小點
+     * @param queryMax 查詢包圍盒最大點
+     * @param queryCount 查詢數量 (不超過 32)
+     * @param callback 對每個 (查詢序號, 圖元索引) 呼叫
+     */
+    template <typename Callback>
+    void traverseBatch(const Hierarchy& tree, const glm::vec3* queryMin, const glm::vec3* queryMax,
+                       int queryCount, Callback&& callback) const;
+
+    /**
+     * @brief 檢查兩個頂點是否在拓撲排除範圍內
+     */
+    bool areTopologicalNeighbours(int a, int b) const;
+};
+
+} // namespace Physics
@@ -2,14 +2,30 @@
 
 #include <vector>
 #include <memory>
+#include <cstdint>
+#include <string>
+#include <functional>
 #include <glm/glm.hpp>
 #include "physics/Particle.h"
 #include "physics/OGCContactModel.h"
+#include "physics/Parallel.h"
+#include "physics/CommandQueue.h"
+#include "physics/Span.h"
 
 namespace Physics {
 
 // 前向聲明
-class BulletIntegration;
+class CollisionBackend;
+class SelfCollision;
+class ClothBVH;
+class ContinuousCollision;
+class DisplacementBounds;
+class ContactCache;
+class NarrowBand;
+class SdfCollider;
+class TriangleMeshCollider;
+class HeightfieldCollider;
+class AnalyticColliders;
 
 /**
  * @brief 布料約束結構
@@ -29,12 +45,19 @@ struct ClothConstraint {
  * @brief 布料模擬類
  * 
  * 實現基於粒子的布料物理模擬，使用 Verlet 積分和約束求解。
- * 整合 OGC Contact Model 和 Bullet Physics 進行碰撞檢測。
+ * 整合 OGC Contact Model 和可在執行期選擇的碰撞後端 (Bullet Physics 或簡化實現) 進行碰撞檢測。
+ * 以標量類型 Real 為模板參數，見 ClothSimulation (float) 與 ClothSimulationD (double)。
  */
-class ClothSimulation {
+template <typename Real>
+class BasicClothSimulation {
 public:
-    ClothSimulation();
-    ~ClothSimulation();
+    using Scalar = Real;
+    using Vec2 = Vec2T<Real>;
+    using Vec3 = Vec3T<Real>;
+    using ParticleType = BasicParticle<Real>;
+
+    BasicClothSimulation();
+    ~BasicClothSimulation();
 
     /**
      * @brief 初始化布料模擬
@@ -46,9 +69,9 @@ public:
      * @return 是否初始化成功
      */
     bool initialize(int width, int height, 
-                   const glm::vec2& clothSize = glm::vec2(2.0f, 2.0f),
-                   const glm::vec3& position = glm::vec3(0.0f, 3.0f, 0.0f),
-                   float particleMass = 0.1f);
+                   const Vec2& clothSize = Vec2(Real(2), Real(2)),
+                   const Vec3& position = Vec3(Real(0), Real(3), Real(0)),
+                   Real particleMass = Real(0.1));
 
     /**
      * @brief 清理資源
@@ -59,7 +82,54 @@ public:
      * @brief 更新模擬
      * @param deltaTime 時間步長
      */
-    void update(float deltaTime);
+    void update(Real deltaTime);
+
+    /**
+     * @brief 場景編輯命令 (在模擬執行緒上、步與步之間執行)
+     */
+    using Command = std::function<void(BasicClothSimulation&)>;
+
+    /**
+     * @brief 提交場景編輯命令 (任意執行緒，無鎖，不阻塞模擬)
+     *
+     * 命令在下一次 update 開始前 (或 applyCommands 時) 按提交順序執行，
+     * 一個命令內的所有修改對模擬步而言是原子的。批次編輯 (例如一次釘住上萬個粒子)
+     * 應放在同一個命令內。模擬在其他執行緒運行時，所有設定都應經由此介面。
+     *
+     * @param command 命令
+     */
+    void enqueueCommand(Command command) { m_commands.push(std::move(command)); }
+
+    /**
+     * @brief 執行所有已提交的命令 (只由模擬執行緒呼叫；暫停時可單獨呼叫)
+     * @return 執行的命令數
+     */
+    int applyCommands();
+
+    /**
+     * @brief 選擇碰撞後端 (需在 initialize 之前呼叫)
+     * @param name 已註冊的後端名稱 (例如 "bullet"、"simplified"；空字串表示預設)
+     * @return 是否成功
+     */
+    bool setCollisionBackend(const std::string& name);
+
+    /**
+     * @brief 獲取碰撞後端名稱
+     * @return 使用中 (或已選擇) 的後端名稱
+     */
+    const char* getCollisionBackendName() const;
+
+    /**
+     * @brief 獲取碰撞後端
+     * @return 碰撞後端指標 (初始化前為空)
+     */
+    CollisionBackend* getCollisionBackend() { return m_collisionBackend.get(); }
+
+    /**
+     * @brief 獲取 OGC 接觸模型 (調整剛度、熱啟動與接觸合併參數)
+     * @return 接觸模型指標
+     */
+    OGCContactModel* getContactModel() { return m_ogcContactModel.get(); }
 
     /**
      * @brief 添加圓柱體碰撞體
@@ -67,32 +137,149 @@ public:
      * @param radius 半徑
      * @param height 高度
      */
-    void addCylinder(const glm::vec3& center, float radius, float height);
+    void addCylinder(const Vec3& center, float radius, float height);
 
     /**
      * @brief 添加地板碰撞體
      * @param center 地板中心
      * @param size 地板大小
      */
-    void addFloor(const glm::vec3& center, const glm::vec3& size);
+    void addFloor(const Vec3& center, const glm::vec3& size);
+
+    /**
+     * @brief 添加球碰撞體
+     * @param center 球心
+     * @param radius 半徑
+     * @return 解析碰撞體索引 (-1 表示失敗)
+     */
+    int addSphere(const Vec3& center, float radius);
+
+    /**
+     * @brief 添加膠囊碰撞體
+     * @param pointA 線段端點 A
+     * @param pointB 線段端點 B
+     * @param radius 半徑
+     * @return 解析碰撞體索引 (-1 表示失敗)
+     */
+    int addCapsule(const Vec3& pointA, const Vec3& pointB, float radius);
+
+    /**
+     * @brief 添加定向盒碰撞體
+     * @param center 中心
+     * @param halfExtents 局部座標半邊長
+     * @param rotation 旋轉 (各行為局部座標軸)
+     * @return 解析碰撞體索引 (-1 表示失敗)
+     */
+    int addOrientedBox(const Vec3& center, const glm::vec3& halfExtents, const glm::mat3& rotation);
+
+    /**
+     * @brief 添加圓角盒碰撞體
+     * @param center 中心
+     * @param halfExtents 局部座標半邊長 (含圓角)
+     * @param rotation 旋轉 (各行為局部座標軸)
+     * @param roundingRadius 圓角半徑
+     * @return 解析碰撞體索引 (-1 表示失敗)
+     */
+    int addRoundedBox(const Vec3& center, const glm::vec3& halfExtents, const glm::mat3& rotation,
+                       float roundingRadius);
+
+    /**
+     * @brief 添加圓環碰撞體
+     * @param center 中心
+     * @param axis 對稱軸
+     * @param majorRadius 主半徑
+     * @param minorRadius 管半徑
+     * @return 解析碰撞體索引 (-1 表示失敗)
+     */
+    int addTorus(const Vec3& center, const glm::vec3& axis, float majorRadius, float minorRadius);
+
+    /**
+     * @brief 添加無限平面碰撞體
+     * @param point 平面上一點
+     * @param normal 平面法線 (指向外側)
+     * @return 解析碰撞體索引 (-1 表示失敗)
+     */
+    int addPlane(const Vec3& point, const glm::vec3& normal);
+
+    /**
+     * @brief 移動解析碰撞體 (運動學碰撞體，例如人台的肢體)
+     *
+     * rotation 的各行為局部座標軸；膠囊、圓環的對稱軸與平面法線取局部 Y 軸。
+     * 碰撞體移動後位移界失效，下一步重新檢測。
+     *
+     * @param collider add* 返回的解析碰撞體索引
+     * @param center 中心 (平面為平面上一點)
+     * @param rotation 旋轉
+     */
+    void setColliderTransform(int collider, const Vec3& center, const glm::mat3& rotation);
+
+    /**
+     * @brief 設定解析碰撞體的速度 (接觸相對速度扣除碰撞體在接觸點的速度)
+     * @param collider add* 返回的解析碰撞體索引
+     * @param linearVelocity 線速度
+     * @param angularVelocity 角速度 (繞碰撞體中心)
+     */
+    void setColliderVelocity(int collider, const glm::vec3& linearVelocity, const glm::vec3& angularVelocity);
+
+    /**
+     * @brief 添加靜態三角形網格碰撞體 (SAH BVH 最近點查詢)
+     * @param vertices 網格頂點 (模擬座標)
+     * @param triangles 三角形頂點索引 (逆時針為外側)
+     */
+    void addTriangleMesh(const std::vector<Vec3>& vertices, const std::vector<glm::ivec3>& triangles);
+
+    /**
+     * @brief 添加高度場地形碰撞體 (每個粒子一次格子查詢與雙線性插值)
+     * @param heights 樣本高度 (x 最快變化，共 columns * rows 個)
+     * @param columns x 方向樣本數
+     * @param rows z 方向樣本數
+     * @param origin 樣本 (0, 0) 的位置 (模擬座標；y 為高度基準)
+     * @param cellSize 格子大小
+     * @return 是否成功
+     */
+    bool addHeightfield(const std::vector<float>& heights, int columns, int rows,
+                        const Vec3& origin, float cellSize);
+
+    /**
+     * @brief 添加有號距離場碰撞體 (由靜態三角形網格體素化)
+     * @param vertices 網格頂點 (模擬座標)
+     * @param triangles 三角形頂點索引 (逆時針為外側)
+     * @param voxelSize 體素大小
+     * @param cachePath 距離場快取檔案路徑 (空字串表示不使用快取)
+     * @return 是否成功
+     */
+    bool addSdfCollider(const std::vector<Vec3>& vertices, const std::vector<glm::ivec3>& triangles,
+                        float voxelSize, const std::string& cachePath = "");
 
     /**
      * @brief 設定重力
      * @param gravity 重力向量
      */
-    void setGravity(const glm::vec3& gravity) { m_gravity = gravity; }
+    void setGravity(const Vec3& gravity) { m_gravity = gravity; }
 
     /**
      * @brief 設定風力
      * @param wind 風力向量
      */
-    void setWind(const glm::vec3& wind) { m_wind = wind; }
+    void setWind(const Vec3& wind) { m_wind = wind; }
 
     /**
      * @brief 設定阻尼係數
      * @param damping 阻尼係數
      */
-    void setDamping(float damping) { m_damping = damping; }
+    void setDamping(Real damping) { m_damping = damping; }
+
+    /**
+     * @brief 設定每步約束迭代次數
+     * @param iterations 迭代次數 (至少 1)
+     */
+    void setConstraintIterations(int iterations) { m_constraintIterations = iterations > 1 ? iterations : 1; }
+
+    /**
+     * @brief 獲取每步約束迭代次數
+     * @return 迭代次數
+     */
+    int getConstraintIterations() const { return m_constraintIterations; }
 
     /**
      * @brief 固定粒子 (釘住布料的某些點)
@@ -101,11 +288,252 @@ public:
      */
     void setParticleFixed(int particleIndex, bool fixed);
 
+    /**
+     * @brief 批次固定或釋放粒子
+     * @param particleIndices 粒子索引列表 (越界者忽略)
+     * @param fixed 是否固定
+     */
+    void setParticlesFixed(const std::vector<int>& particleIndices, bool fixed);
+
+    /**
+     * @brief 啟用或停用布料自碰撞
+     * @param enabled 是否啟用
+     */
+    void setSelfCollisionEnabled(bool enabled) { m_selfCollisionEnabled = enabled; }
+
+    /**
+     * @brief 檢查是否啟用布料自碰撞
+     * @return 是否啟用
+     */
+    bool isSelfCollisionEnabled() const { return m_selfCollisionEnabled; }
+
+    /**
+     * @brief 獲取自碰撞檢測器
+     * @return 自碰撞檢測器指標
+     */
+    SelfCollision* getSelfCollision() { return m_selfCollision.get(); }
+
+    /**
+     * @brief 啟用或停用三角形級布料碰撞 (點-面與邊-邊)
+     * @param enabled 是否啟用
+     */
+    void setTriangleCollisionEnabled(bool enabled) { m_triangleCollisionEnabled = enabled; }
+
+    /**
+     * @brief 檢查是否啟用三角形級布料碰撞
+     * @return 是否啟用
+     */
+    bool isTriangleCollisionEnabled() const { return m_triangleCollisionEnabled; }
+
+    /**
+     * @brief 獲取布料三角形/邊 BVH
+     * @return BVH 指標
+     */
+    ClothBVH* getClothBVH() { return m_clothBvh.get(); }
+
+    /**
+     * @brief 啟用或停用對靜態碰撞體的連續碰撞檢測
+     *
+     * 只掃掠圓柱體與地板盒子；其他碰撞體類型仍為離散檢測。
+     *
+     * @param enabled 是否啟用
+     */
+    void setContinuousCollisionEnabled(bool enabled) { m_continuousCollisionEnabled = enabled; }
+
+    /**
+     * @brief 檢查是否啟用連續碰撞檢測
+     * @return 是否啟用
+     */
+    bool isContinuousCollisionEnabled() const { return m_continuousCollisionEnabled; }
+
+    /**
+     * @brief 獲取連續碰撞檢測器
+     * @return 連續碰撞檢測器指標
+     */
+    ContinuousCollision* getContinuousCollision() { return m_continuousCollision.get(); }
+
+    /**
+     * @brief 啟用或停用 OGC 保守位移界
+     *
+     * 啟用後頂點位移被截斷在上次檢測計算的位移界內，只有頂點用盡其界時才重新檢測接觸。
+     *
+     * @param enabled 是否啟用
+     */
+    void setDisplacementBoundsEnabled(bool enabled);
+
+    /**
+     * @brief 檢查是否啟用 OGC 保守位移界
+     * @return 是否啟用
+     */
+    bool isDisplacementBoundsEnabled() const { return m_displacementBoundsEnabled; }
+
+    /**
+     * @brief 獲取位移界
+     * @return 位移界指標
+     */
+    DisplacementBounds* getDisplacementBounds() { return m_displacementBounds.get(); }
+
+    /**
+     * @brief 獲取因位移界而跳過碰撞檢測的步數
+     * @return 跳過的步數
+     */
+    int getSkippedDetectionCount() const { return m_skippedDetectionCount; }
+
+    /**
+     * @brief 啟用或停用碰撞後端的窄帶活躍集
+     *
+     * 啟用後只有距後端碰撞體 (圓柱、地板、三角形網格) 在窄帶內的粒子做窄相查詢，
+     * 遠離碰撞體的布料塊以包圍球整塊剔除，粒子位移超過帶的餘量時才重建所在塊。
+     * 遮罩按粒子記錄 (不區分碰撞體)；其他碰撞體與自碰撞不受影響。
+     *
+     * @param enabled 是否啟用
+     */
+    void setNarrowBandEnabled(bool enabled);
+
+    /**
+     * @brief 檢查是否啟用窄帶活躍集
+     * @return 是否啟用
+     */
+    bool isNarrowBandEnabled() const { return m_narrowBandEnabled; }
+
+    /**
+     * @brief 獲取窄帶活躍集
+     * @return 窄帶指標
+     */
+    NarrowBand* getNarrowBand() { return m_narrowBand.get(); }
+
+    /**
+     * @brief 啟用或停用按粒子的接觸合併
+     *
+     * 啟用後每次檢測結束時，同一粒子法線相近的靜態接觸 (多個重疊碰撞體、
+     * Bullet 流形的多個點) 併為一個最深接觸加平均法線，每個粒子保留的接觸數
+     * 以接觸模型的合併預算為上限。
+     *
+     * @param enabled 是否啟用
+     */
+    void setContactReductionEnabled(bool enabled) { m_contactReductionEnabled = enabled; }
+
+    /**
+     * @brief 檢查是否啟用接觸合併
+     * @return 是否啟用
+     */
+    bool isContactReductionEnabled() const { return m_contactReductionEnabled; }
+
+    /**
+     * @brief 啟用或停用約束迭代內的接觸投影
+     *
+     * 啟用後上一步檢測到的接觸作為單側約束，在每次約束迭代後投影，約束與接觸
+     * 在同一步內互相收斂，不再跨幀拉扯。每步仍只檢測一次 (迭代結束後)，
+     * 接觸集在下一步的所有迭代中沿用，穿透深度按粒子相對檢測時位置的位移更新；
+     * 迭代中新出現的接觸由本步結束時的檢測照常處理。
+     *
+     * @param enabled 是否啟用
+     */
+    void setContactProjectionEnabled(bool enabled) { m_contactProjectionEnabled = enabled; }
+
+    /**
+     * @brief 檢查是否啟用約束迭代內的接觸投影
+     * @return 是否啟用
+     */
+    bool isContactProjectionEnabled() const { return m_contactProjectionEnabled; }
+
+    /**
+     * @brief 啟用或停用跨幀接觸快取
+     *
+     * 啟用後靜止在碰撞體上的粒子可略過後端窄相、沿用上一次的接觸，
+     * 並以上一幀的接觸力熱啟動 OGC 接觸模型。
+     *
+     * @param enabled 是否啟用
+     */
+    void setContactCacheEnabled(bool enabled);
+
+    /**
+     * @brief 檢查是否啟用跨幀接觸快取
+     * @return 是否啟用
+     */
+    bool isContactCacheEnabled() const { return m_contactCacheEnabled; }
+
+    /**
+     * @brief 獲取接觸快取
+     * @return 接觸快取指標
+     */
+    ContactCache* getContactCache() { return m_contactCache.get(); }
+
+    /**
+     * @brief 設定每步最多因用盡位移界而重新檢測的次數
+     * @param passes 次數 (之後仍超出界的頂點停在界上)
+     */
+    void setMaxBoundPasses(int passes) { m_maxBoundPasses = passes > 0 ? passes : 1; }
+    int getMaxBoundPasses() const { return m_maxBoundPasses; }
+
+    /**
+     * @brief 設定 double 精度的世界原點 (混合精度模式)
+     *
+     * 之後所有位置參數 (初始位置、碰撞體) 與粒子座標都相對於此原點，
+     * 使遠離世界原點的布料仍以小數值座標積分。應在 initialize 之前呼叫。
+     *
+     * @param origin 世界原點
+     */
+    void setWorldOrigin(const glm::dvec3& origin) { m_worldOrigin = origin; }
+
+    /**
+     * @brief 獲取世界原點
+     * @return 世界原點
+     */
+    const glm::dvec3& getWorldOrigin() const { return m_worldOrigin; }
+
+    /**
+     * @brief 獲取粒子的世界座標 (double 精度)
+     * @param particleIndex 粒子索引
+     * @return 世界座標
+     */
+    glm::dvec3 getWorldPosition(int particleIndex) const;
+
+    /**
+     * @brief 設定工作執行緒數
+     * @param threadCount 執行緒數 (至少為 1)
+     */
+    void setThreadCount(int threadCount);
+
+    /**
+     * @brief 獲取工作執行緒數
+     * @return 執行緒數
+     */
+    int getThreadCount() const { return m_parallelSettings.threadCount; }
+
+    /**
+     * @brief 設定位元級確定性模式
+     *
+     * 啟用後使用固定分塊、排序後的接觸列表和固定順序的累加，
+     * 任意執行緒數下的模擬結果逐位元相同。
+     *
+     * @param deterministic 是否啟用
+     */
+    void setDeterministic(bool deterministic) { m_parallelSettings.deterministic = deterministic; }
+
+    /**
+     * @brief 檢查是否為確定性模式
+     * @return 是否啟用確定性模式
+     */
+    bool isDeterministic() const { return m_parallelSettings.deterministic; }
+
+    /**
+     * @brief 獲取最近一步結束時的狀態雜湊
+     * @return 狀態雜湊值
+     */
+    uint64_t getStateHash() const { return m_stateHash; }
+
+    /**
+     * @brief 計算當前粒子狀態的雜湊 (FNV-1a，逐位元)
+     * @return 狀態雜湊值
+     */
+    uint64_t computeStateHash() const;
+
     /**
      * @brief 獲取粒子列表
      * @return 粒子指標列表
      */
-    const std::vector<std::unique_ptr<Particle>>& getParticles() const { return m_particles; }
+    const ParticleList<Real>& getParticles() const { return m_particles; }
 
     /**
      * @brief 獲取約束列表
@@ -113,6 +541,31 @@ public:
      */
     const std::vector<ClothConstraint>& getConstraints() const { return m_constraints; }
 
+    /**
+     * @brief 粒子位置的連續視圖 (零複製)
+     *
+     * 每次 update、reset 結束時同步為 float 的模擬座標，與 Particle::getPosition 相同。
+     * 可直接上傳為頂點緩衝；視圖在下一次 update 或 reset 前有效。
+     *
+     * @return 按粒子索引排列的位置
+     */
+    Span<const glm::vec3> getPositions() const { return m_positionView; }
+
+    /**
+     * @brief 約束邊的索引緩衝 (每條邊兩個粒子索引，可直接作為 GL_LINES 的索引)
+     *
+     * 在建立約束時生成一次，只在拓撲版本改變時需要重新上傳。
+     *
+     * @return 扁平的索引對
+     */
+    Span<const uint32_t> getEdgeIndices() const { return m_edgeIndices; }
+
+    /**
+     * @brief 拓撲版本 (粒子或約束集合改變時遞增)
+     * @return 版本號
+     */
+    uint64_t getTopologyVersion() const { return m_topologyVersion; }
+
     /**
      * @brief 獲取當前接觸列表
      * @return OGC接觸列表
@@ -133,14 +586,16 @@ public:
 private:
     // 布料參數
     int m_width, m_height;
-    glm::vec2 m_clothSize;
-    glm::vec3 m_initialPosition;
-    float m_particleMass;
+    Vec2 m_clothSize;
+    Vec3 m_initialPosition;
+    Real m_particleMass;
+    float m_particleRadius;         // 粒子碰撞半徑
+    glm::dvec3 m_worldOrigin;       // 混合精度模式的世界原點
     
     // 物理參數
-    glm::vec3 m_gravity;
-    glm::vec3 m_wind;
-    float m_damping;
+    Vec3 m_gravity;
+    Vec3 m_wind;
+    Real m_damping;
     
     // 約束參數
     float m_structuralStiffness;    // 結構約束剛度
@@ -149,35 +604,87 @@ private:
     int m_constraintIterations;     // 約束迭代次數
     
     // 模擬數據
-    std::vector<std::unique_ptr<Particle>> m_particles;
+    ParticleList<Real> m_particles;
     std::vector<ClothConstraint> m_constraints;
     std::vector<OGCContact> m_contacts;
+    std::vector<int> m_particleCollisionHandles;                 // 粒子在碰撞後端中的句柄
+    std::vector<Vec3> m_triangleWindForces;                      // 每個三角形的風力
+    std::vector<glm::vec3> m_collisionPositions;                 // 碰撞座標下的粒子位置
+    std::vector<glm::vec3> m_positionView;                       // 對外的連續位置視圖 (步結束時同步)
+    std::vector<uint32_t> m_edgeIndices;                         // 約束邊索引緩衝
+    uint64_t m_topologyVersion;
+    
+    // 場景編輯命令 (多生產者，模擬執行緒消費)
+    CommandQueue<Command> m_commands;
+    
+    // 平行與確定性
+    ParallelSettings m_parallelSettings;
+    uint64_t m_stateHash;
     
     // 碰撞檢測和接觸模型
-    std::unique_ptr<BulletIntegration> m_bulletIntegration;
+    std::string m_collisionBackendName;                 // 選擇的碰撞後端 (空表示預設)
+    std::unique_ptr<CollisionBackend> m_collisionBackend;
     std::unique_ptr<OGCContactModel> m_ogcContactModel;
+    std::unique_ptr<SelfCollision> m_selfCollision;
+    bool m_selfCollisionEnabled;
+    std::unique_ptr<ClothBVH> m_clothBvh;
+    bool m_triangleCollisionEnabled;
+    std::unique_ptr<ContinuousCollision> m_continuousCollision;
+    bool m_continuousCollisionEnabled;
+    std::vector<glm::vec3> m_previousCollisionPositions;   // 積分前位置 (碰撞座標，CCD 線段起點)
+    std::vector<std::unique_ptr<SdfCollider>> m_sdfColliders;
+    std::vector<std::shared_ptr<TriangleMeshCollider>> m_meshColliders;
+    std::vector<std::unique_ptr<HeightfieldCollider>> m_heightfieldColliders;
+    std::unique_ptr<AnalyticColliders> m_analyticColliders;
+    std::vector<float> m_colliderDistances;                // 每個頂點到靜態碰撞體表面的距離 (位移界用)
+    std::unique_ptr<DisplacementBounds> m_displacementBounds;
+    bool m_displacementBoundsEnabled;
+    int m_skippedDetectionCount;
+    int m_maxBoundPasses;                                  // 每步最多因用盡位移界而重新檢測的次數
+    std::vector<glm::vec3> m_targetPositions;              // 約束求解後、截斷前的位置
+    std::unique_ptr<ContactCache> m_contactCache;
+    bool m_contactCacheEnabled;
+    std::unique_ptr<NarrowBand> m_narrowBand;
+    bool m_narrowBandEnabled;
+    std::vector<char> m_detectionMask;                     // 窄帶與接觸快取合併後的略過遮罩
+    bool m_contactReductionEnabled;
+    bool m_contactProjectionEnabled;
+    std::vector<Vec3> m_contactAnchors;                    // 接觸檢測時的粒子位置 (投影時計算位移)
     
     /**
      * @brief 創建粒子網格
      */
     void createParticles();
     
+    /**
+     * @brief 計算網格座標對應的初始粒子位置
+     * @param x X座標
+     * @param y Y座標
+     * @return 初始位置
+     */
+    Vec3 gridPosition(int x, int y) const;
+    
     /**
      * @brief 創建約束
      */
     void createConstraints();
     
+    /**
+     * @brief 把粒子位置同步到對外的連續視圖
+     */
+    void syncPositionView();
+    
     /**
      * @brief 應用外力 (重力、風力等)
      * @param deltaTime 時間步長
      */
-    void applyForces(float deltaTime);
+    void applyForces(Real deltaTime);
     
     /**
      * @brief 更新粒子位置 (Verlet 積分)
      * @param deltaTime 時間步長
      */
-    void updateParticles(float deltaTime);
+    void updateParticles(Real deltaTime);
     
     /**
      * @brief 求解約束
@@ -189,6 +696,34 @@ private:
      */
     void handleCollisions();
     
+    /**
+     * @brief 點到後端碰撞體 (圓柱、地板、三角形網格) 表面的距離 (窄帶用)
+     */
+    float backendColliderDistance(const glm::vec3& position) const;
+    
+    /**
+     * @brief 對 m_collisionPositions 執行完整碰撞檢測並重建 m_contacts
+     */
+    void detectContacts();
+    
+    /**
+     * @brief 以 OGC 位移界截斷頂點位移，僅在頂點用盡其界時重新檢測接觸
+     */
+    void applyDisplacementBounds();
+    
+    /**
+     * @brief 碰撞場景改變後使位移界與接觸快取失效
+     */
+    void invalidateCollisionCaches();
+    
+    /**
+     * @brief 累加粒子相鄰三角形的風力 (按三角形索引順序)
+     * @param x X座標
+     * @param y Y座標
+     * @return 風力總和
+     */
+    Vec3 gatherWindForce(int x, int y) const;
+    
     /**
      * @brief 計算風力
      * @param p1 粒子1
@@ -196,7 +731,14 @@ private:
      * @param p3 粒子3
      * @return 風力向量
      */
-    glm::vec3 calculateWindForce(const Particle& p1, const Particle& p2, const Particle& p3);
+    Vec3 calculateWindForce(const ParticleType& p1, const ParticleType& p2, const ParticleType& p3);
+
+    /**
+     * @brief 將粒子位置轉換為碰撞檢測使用的 float 座標
+     * @param position 粒子位置
+     * @return float 座標
+     */
+    static glm::vec3 toCollisionSpace(const Vec3& position) { return glm::vec3(position); }
     
     /**
      * @brief 獲取粒子索引
@@ -217,4 +759,10 @@ private:
     }
 };
 
+using ClothSimulation = BasicClothSimulation<float>;
+using ClothSimulationD = BasicClothSimulation<double>;
+
+extern template class BasicClothSimulation<float>;
+extern template class BasicClothSimulation<double>;
+
 } // namespace Physics
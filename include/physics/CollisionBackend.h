@@ -0,0 +1,148 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <string>
+#include <functional>
+#include <glm/glm.hpp>
+#include "physics/OGCContactModel.h"
+#include "physics/Parallel.h"
+
+namespace Physics {
+
+class TriangleMeshCollider;
+
+/**
+ * @brief 碰撞後端介面
+ *
+ * 負責粒子與靜態碰撞體 (圓柱、地板、三角形網格) 的離散碰撞檢測，輸出 OGC 接觸。
+ * 各實現 (Bullet、簡化實現、之後的加速實現) 向 CollisionBackendRegistry 註冊，
+ * 由每個 ClothSimulation 在執行期按名稱選擇，因此可在同一個執行檔中
+ * 對相同場景比較不同後端。
+ */
+class CollisionBackend {
+public:
+    virtual ~CollisionBackend() = default;
+
+    /**
+     * @brief 後端名稱 (與註冊名稱相同)
+     */
+    virtual const char* getName() const = 0;
+
+    /**
+     * @brief 添加圓柱體碰撞體
+     * @param center 圓柱體中心位置
+     * @param radius 圓柱體半徑
+     * @param height 圓柱體高度
+     */
+    virtual void addCylinder(const glm::vec3& center, float radius, float height) = 0;
+
+    /**
+     * @brief 添加地板碰撞體
+     * @param center 地板中心位置
+     * @param size 地板大小
+     */
+    virtual void addFloor(const glm::vec3& center, const glm::vec3& size) = 0;
+
+    /**
+     * @brief 添加靜態三角形網格碰撞體
+     * @param mesh 三角形網格碰撞體
+     */
+    virtual void addTriangleMesh(const std::shared_ptr<TriangleMeshCollider>& mesh) = 0;
+
+    /**
+     * @brief 添加粒子碰撞體
+     * @param particleIndex 粒子在布料中的索引
+     * @param position 粒子初始位置
+     * @param radius 粒子半徑
+     * @return 粒子碰撞體句柄 (-1 表示失敗)
+     */
+    virtual int addParticle(int particleIndex, const glm::vec3& position, float radius) = 0;
+
+    /**
+     * @brief 更新粒子位置
+     * @param handle addParticle 返回的句柄
+     * @param position 粒子當前位置
+     */
+    virtual void updateParticlePosition(int handle, const glm::vec3& position) = 0;
+
+    /**
+     * @brief 移除粒子碰撞體 (其他句柄保持有效)
+     * @param handle addParticle 返回的句柄
+     */
+    virtual void removeParticle(int handle) = 0;
+
+    /**
+     * @brief 粒子表面之外仍輸出接觸的距離 (窄帶剔除須涵蓋此距離)
+     */
+    virtual float getContactThreshold() const { return 0.0f; }
+
+    /**
+     * @brief 執行碰撞檢測
+     *
+     * 粒子範圍分給工作執行緒，各自寫入自己的緩衝，最後以前綴和壓實到輸出。
+     * 逐粒子查詢產生的接觸按粒子句柄排序 (同一粒子的接觸按碰撞體添加順序)。
+     *
+     * 每個接觸的 featureId 為碰撞體按添加順序的編號，供接觸快取跨幀配對。
+     *
+     * @param contacts 輸出接觸列表 (先清空，保留容量)
+     * @param settings 平行設定
+     * @param skipMask 按粒子索引的略過遮罩 (非零者可不做窄相查詢，空指標表示全部查詢)
+     */
+    virtual void performCollisionDetection(std::vector<OGCContact>& contacts, const ParallelSettings& settings,
+                                           const std::vector<char>* skipMask) = 0;
+
+protected:
+    /**
+     * @brief 粒子是否被略過遮罩標記
+     */
+    static bool isSkipped(const std::vector<char>* skipMask, int particleIndex) {
+        return skipMask && particleIndex >= 0 && particleIndex < static_cast<int>(skipMask->size())
+            && (*skipMask)[particleIndex];
+    }
+};
+
+/**
+ * @brief 碰撞後端註冊表
+ *
+ * 每個後端的實現檔以靜態物件自行註冊，未編譯進執行檔的後端 (例如找不到
+ * Bullet 時) 就不會出現在列表中。未指定名稱時使用優先級最高的後端。
+ */
+class CollisionBackendRegistry {
+public:
+    using Factory = std::function<std::unique_ptr<CollisionBackend>()>;
+
+    /**
+     * @brief 註冊後端
+     * @param name 後端名稱
+     * @param priority 預設選擇的優先級 (越大越優先)
+     * @param factory 建立後端的函數
+     * @return 是否成功 (名稱重複時失敗)
+     */
+    static bool registerBackend(const std::string& name, int priority, Factory factory);
+
+    /**
+     * @brief 按名稱建立後端
+     * @param name 後端名稱 (空字串表示預設後端)
+     * @return 後端 (名稱未註冊時為空)
+     */
+    static std::unique_ptr<CollisionBackend> create(const std::string& name = "");
+
+    /**
+     * @brief 是否已註冊指定名稱的後端
+     */
+    static bool isRegistered(const std::string& name);
+
+    /**
+     * @brief 預設後端名稱
+     * @return 優先級最高的後端名稱 (沒有任何後端時為空字串)
+     */
+    static std::string getDefaultName();
+
+    /**
+     * @brief 所有已註冊的後端名稱 (按優先級由高到低)
+     */
+    static std::vector<std::string> getAvailableBackends();
+};
+
+} // namespace Physics
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <atomic>
+#include <utility>
+
+namespace Physics {
+
+/**
+ * @brief 多生產者單消費者的無鎖命令佇列
+ *
+ * 侵入式鏈結串列 (Vyukov MPSC)：生產者只做一次原子交換把節點接到頭部，
+ * 從不等待其他生產者或消費者；消費者沿尾部逐一取出。生產者交換後、
+ * 連結前的短暫空窗內，消費者只會把佇列視為較短，該命令留到下一次取出。
+ *
+ * T 須可預設構造 (用作哨兵節點)。
+ */
+template <typename T>
+class CommandQueue {
+public:
+    CommandQueue() : m_head(new Node()), m_tail(m_head.load(std::memory_order_relaxed)) {}
+
+    ~CommandQueue() {
+        T discarded;
+        while (tryPop(discarded)) {}
+        delete m_tail;
+    }
+
+    CommandQueue(const CommandQueue&) = delete;
+    CommandQueue& operator=(const CommandQueue&) = delete;
+
+    /**
+     * @brief 推入命令 (任意執行緒，無鎖)
+     */
+    void push(T value) {
+        Node* node = new Node(std::move(value));
+        Node* previous = m_head.exchange(node, std::memory_order_acq_rel);
+        previous->next.store(node, std::memory_order_release);
+    }
+
+    /**
+     * @brief 取出最早的命令 (只由消費者執行緒呼叫)
+     * @param value 輸出命令
+     * @return 是否取到命令
+     */
+    bool tryPop(T& value) {
+        Node* tail = m_tail;
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if (!next) return false;
+
+        // next 成為新的哨兵，其值移出後留空
+        value = std::move(next->value);
+        m_tail = next;
+        delete tail;
+        return true;
+    }
+
+    /**
+     * @brief 佇列是否 (在消費者看來) 為空
+     */
+    bool empty() const { return m_tail->next.load(std::memory_order_acquire) == nullptr; }
+
+private:
+    struct Node {
+        std::atomic<Node*> next;
+        T value;
+
+        Node() : next(nullptr), value() {}
+        explicit Node(T&& v) : next(nullptr), value(std::move(v)) {}
+    };
+
+    std::atomic<Node*> m_head;      // 生產者端 (最新節點)
+    Node* m_tail;                   // 消費者端 (哨兵)
+};
+
+} // namespace Physics
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include "physics/OGCContactModel.h"
+#include "physics/Span.h"
+
+namespace Physics {
+
+/**
+ * @brief 跨幀持久接觸快取
+ *
+ * 以 (粒子, 碰撞體特徵) 為鍵保存接觸，提供兩項重用：
+ * 1. 窄相重用：粒子上次做窄相時有靜態接觸，且之後相對當時位置 (錨點) 的位移
+ *    小於邊距時，本幀略過該粒子的後端窄相，沿用錨點處的接觸，穿透深度按位移
+ *    沿法線線性更新。連續略過的幀數有上限，以限制誤差累積。
+ * 2. 熱啟動：按鍵把最近一次求解後的接觸力寫入 previousForce，供接觸模型延續；
+ *    短暫分離的接觸在最大沿用幀數內保留其力，再次接觸時仍可熱啟動。
+ *
+ * 每幀流程：prepare → 後端窄相 (帶略過遮罩) → mergeNarrowphase → 其他檢測 →
+ * warmStart → 接觸處理 → store。
+ */
+class ContactCache {
+public:
+    /**
+     * @brief 構造函數
+     * @param margin 可略過窄相的最大錨點位移
+     * @param maxReuseFrames 連續略過窄相的最大幀數
+     */
+    ContactCache(float margin = 0.002f, int maxReuseFrames = 8);
+
+    ~ContactCache() = default;
+
+    /**
+     * @brief 清空快取 (碰撞體改變後呼叫)
+     */
+    void reset();
+
+    /**
+     * @brief 在後端窄相前決定哪些粒子可沿用快取接觸
+     * @param positions 粒子位置 (碰撞座標)
+     * @return 按粒子索引的略過遮罩 (非零表示略過窄相)
+     */
+    const std::vector<char>& prepare(const std::vector<glm::vec3>& positions);
+
+    /**
+     * @brief 以後端窄相結果更新快取，並為略過的粒子補回沿用接觸
+     *
+     * 輸出中靜態接觸按粒子索引排列 (同一粒子按後端輸出順序)，其餘接觸原樣附在其後。
+     *
+     * @param contacts 後端輸出的接觸列表 (原地改寫)
+     * @param positions 粒子位置 (碰撞座標)
+     */
+    void mergeNarrowphase(std::vector<OGCContact>& contacts, const std::vector<glm::vec3>& positions);
+
+    /**
+     * @brief 按鍵寫入最近一次的接觸力
+     * @param contacts 本幀的完整接觸 (原地寫入 previousForce)
+     */
+    void warmStart(Span<OGCContact> contacts);
+
+    /**
+     * @brief 記錄本幀求解後的接觸力
+     * @param contacts 已處理的接觸 (唯讀，與 warmStart 時順序相同)
+     */
+    void store(Span<const OGCContact> contacts);
+
+    /**
+     * @brief 把接觸的 featureId 標上來源編號，使不同檢測器的碰撞體特徵不相撞
+     * @param contacts 接觸列表
+     * @param begin 該檢測器輸出的起始位置
+     * @param source 來源編號 (0 保留給碰撞後端)
+     */
+    static void tagSource(Span<OGCContact> contacts, size_t begin, int source);
+
+    // Getter 和 Setter
+    void setMargin(float margin) { m_margin = margin; }
+    float getMargin() const { return m_margin; }
+
+    void setMaxReuseFrames(int frames) { m_maxReuseFrames = frames; }
+    int getMaxReuseFrames() const { return m_maxReuseFrames; }
+
+    /**
+     * @brief 最近一次 prepare 略過窄相的粒子數
+     */
+    int getReusedParticleCount() const { return m_reusedParticleCount; }
+
+    /**
+     * @brief 最近一次 warmStart 命中快取的接觸數
+     */
+    int getWarmStartedContactCount() const { return m_warmStartedContactCount; }
+
+private:
+    float m_margin;                          // 可略過窄相的最大錨點位移
+    int m_maxReuseFrames;                    // 連續略過窄相的最大幀數
+    int m_reusedParticleCount;
+    int m_warmStartedContactCount;
+
+    std::vector<glm::vec3> m_anchors;        // 每個粒子上次做窄相時的位置
+    std::vector<int> m_reuseFrames;          // 每個粒子已連續略過窄相的幀數
+    std::vector<char> m_skip;                // 本幀的略過遮罩
+    std::vector<int> m_offsets;              // 錨點接觸按粒子的起始位置 (長度為粒子數 + 1)
+    std::vector<OGCContact> m_anchorContacts;   // 錨點處的靜態接觸 (按粒子排列)
+
+    // mergeNarrowphase 的暫存 (跨幀保留容量)
+    std::vector<int> m_freshOffsets;
+    std::vector<OGCContact> m_freshContacts;
+    std::vector<OGCContact> m_otherContacts;
+    std::vector<int> m_mergedOffsets;
+    std::vector<OGCContact> m_mergedContacts;
+
+    /**
+     * @brief 快取的接觸力
+     */
+    struct CachedForce {
+        float force;    // 最近一次出現時的接觸力
+        int age;        // 距最近一次出現的幀數
+    };
+
+    /**
+     * @brief 開放定址雜湊表 (鍵 0 表示空槽)
+     *
+     * 槽陣列跨幀重用，容量只在接觸數創新高時增長，穩態下不配置。
+     */
+    template <typename Value>
+    struct KeyTable {
+        std::vector<uint64_t> keys;
+        std::vector<Value> values;
+        size_t count = 0;
+
+        /**
+         * @brief 清空並確保可容納 expected 個鍵 (負載不超過一半)
+         */
+        void clear(size_t expected) {
+            size_t capacity = 16;
+            while (capacity < 2 * expected) capacity *= 2;
+            keys.assign(capacity, 0);
+            values.resize(capacity);
+            count = 0;
+        }
+
+        /**
+         * @brief 查找鍵的槽位 (不存在時為空槽)
+         */
+        size_t slot(uint64_t key) const {
+            size_t mask = keys.size() - 1;
+            size_t index = static_cast<size_t>(key ^ (key >> 29)) & mask;
+            while (keys[index] != 0 && keys[index] != key) {
+                index = (index + 1) & mask;
+            }
+            return index;
+        }
+
+        const Value* find(uint64_t key) const {
+            if (keys.empty()) return nullptr;
+            size_t index = slot(key);
+            return keys[index] == key ? &values[index] : nullptr;
+        }
+
+        /**
+         * @brief 取得鍵的值 (不存在時以 initial 插入)
+         */
+        Value& insert(uint64_t key, const Value& initial) {
+            size_t index = slot(key);
+            if (keys[index] != key) {
+                keys[index] = key;
+                values[index] = initial;
+                ++count;
+            }
+            return values[index];
+        }
+    };
+
+    std::vector<uint64_t> m_keys;                // 最近一次 warmStart 的接觸鍵
+    KeyTable<int> m_keyCounts;                   // 同鍵接觸的序號
+    KeyTable<CachedForce> m_forces;              // 每個鍵最近一次的接觸力
+    KeyTable<CachedForce> m_nextForces;          // store 時重建的下一幀表
+
+    /**
+     * @brief 計算接觸鍵 (同鍵重複出現時按出現順序加序號區分)
+     * @param contacts 接觸列表
+     */
+    void computeKeys(Span<const OGCContact> contacts);
+
+    /**
+     * @brief 是否為可由錨點沿用的單粒子靜態接觸
+     */
+    static bool isStaticContact(const OGCContact& contact, int particleCount) {
+        return contact.particleIndexB < 0 && !contact.isStencilContact() &&
+               contact.particleIndexA >= 0 && contact.particleIndexA < particleCount;
+    }
+};
+
+} // namespace Physics
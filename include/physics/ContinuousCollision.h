@@ -0,0 +1,112 @@
+#pragma once
+
+#include <vector>
+#include <glm/glm.hpp>
+#include "physics/OGCContactModel.h"
+#include "physics/Parallel.h"
+
+namespace Physics {
+
+/**
+ * @brief 粒子對靜態碰撞體的連續碰撞檢測 (掃掠球)
+ *
+ * 以粒子上一步位置到當前位置的線段掃掠粒子球，對膨脹了粒子半徑的圓柱體與盒子
+ * 求最早的撞擊時間 (TOI)。命中的粒子以 TOI 接觸取代該粒子的離散靜態接觸，
+ * 法線取自撞擊點的表面法線，因此大步長下快速粒子也不會穿過薄碰撞體。
+ *
+ * 只涵蓋 addCylinder/addFloor 加入的圓柱體與盒子；解析碰撞體、距離場、
+ * 三角網格、高度場與布料三角形仍只有離散檢測，大步長下可能被穿透。
+ */
+class ContinuousCollision {
+public:
+    /**
+     * @brief 構造函數
+     * @param particleRadius 粒子半徑
+     */
+    ContinuousCollision(float particleRadius = 0.02f);
+
+    ~ContinuousCollision() = default;
+
+    /**
+     * @brief 添加圓柱體 (軸沿 Y)
+     * @param center 圓柱體中心位置
+     * @param radius 圓柱體半徑
+     * @param height 圓柱體高度
+     */
+    void addCylinder(const glm::vec3& center, float radius, float height);
+
+    /**
+     * @brief 添加軸對齊盒子
+     * @param center 盒子中心位置
+     * @param size 盒子大小
+     */
+    void addBox(const glm::vec3& center, const glm::vec3& size);
+
+    /**
+     * @brief 清除所有碰撞體
+     */
+    void clear() { m_colliders.clear(); }
+
+    /**
+     * @brief 掃掠檢測並以 TOI 接觸取代命中粒子的離散靜態接觸
+     * @param previousPositions 粒子本步積分前的位置 (碰撞座標，線段起點)
+     * @param positions 粒子當前位置 (碰撞座標)
+     * @param contacts 接觸列表 (原地修改)
+     * @param settings 平行設定
+     */
+    void detect(const std::vector<glm::vec3>& previousPositions, const std::vector<glm::vec3>& positions,
+                std::vector<OGCContact>& contacts, const ParallelSettings& settings);
+
+    /**
+     * @brief 點到最近靜態碰撞體表面的有號距離 (內部為負)
+     * @param position 位置 (碰撞座標)
+     * @return 有號距離；沒有碰撞體時為 float 最大值
+     */
+    float distanceToSurface(const glm::vec3& position) const;
+
+    // Getter 和 Setter
+    void setParticleRadius(float radius) { m_particleRadius = radius; }
+    float getParticleRadius() const { return m_particleRadius; }
+
+    void setSweepThreshold(float threshold) { m_sweepThreshold = threshold; }
+    float getSweepThreshold() const { return m_sweepThreshold; }
+
+    size_t getColliderCount() const { return m_colliders.size(); }
+
+private:
+    /**
+     * @brief 靜態碰撞體
+     */
+    struct Collider {
+        enum Type { CYLINDER, BOX };
+        Type type;
+        glm::vec3 center;
+        glm::vec3 size;     // 圓柱體：x=radius, y=height；盒子：完整大小
+    };
+
+    std::vector<Collider> m_colliders;
+    float m_particleRadius;             // 粒子半徑
+    float m_sweepThreshold;             // 位移小於此值的粒子交由離散檢測處理
+    std::vector<OGCContact> m_impacts;  // 每個粒子的 TOI 接觸
+    std::vector<char> m_hasImpact;      // 每個粒子是否命中
+
+    /**
+     * @brief 掃掠球對膨脹圓柱體求撞擊
+     * @param start 線段起點
+     * @param delta 線段位移
+     * @param collider 圓柱體
+     * @param toi 輸出撞擊時間 [0, 1]
+     * @param normal 輸出撞擊點表面法線
+     * @return 是否命中 (起點已在內部時不算命中)
+     */
+    bool sweepCylinder(const glm::vec3& start, const glm::vec3& delta, const Collider& collider,
+                       float& toi, glm::vec3& normal) const;
+
+    /**
+     * @brief 掃掠球對膨脹盒子求撞擊 (slab 法)
+     */
+    bool sweepBox(const glm::vec3& start, const glm::vec3& delta, const Collider& collider,
+                  float& toi, glm::vec3& normal) const;
+};
+
+} // namespace Physics
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <vector>
+#include <glm/glm.hpp>
+#include "physics/OGCContactModel.h"
+#include "physics/Parallel.h"
+
+namespace Physics {
+
+/**
+ * @brief OGC 保守逐頂點位移界
+ *
+ * 每次碰撞檢測後，以當前位置為錨點，為每個頂點計算保守位移界
+ * b = relaxation * d，其中 d 為頂點到最近的非相鄰幾何 (靜態碰撞體表面、
+ * 接觸集中的布料幾何，或布料查詢半徑) 的距離。relaxation < 0.5 時，
+ * 任意兩個幾何各自在界內移動都不可能相交，因此之後的步驟只需把頂點位移
+ * 截斷在界內即可保證無穿透，無需 CCD；只有頂點用盡其界時才重新檢測接觸。
+ * 跳過檢測的步驟中，接觸集沿用上次檢測結果，穿透深度按錨點位移線性更新。
+ */
+class DisplacementBounds {
+public:
+    /**
+     * @brief 構造函數
+     * @param relaxation 界的鬆弛係數 (需小於 0.5)
+     */
+    DisplacementBounds(float relaxation = 0.45f);
+
+    ~DisplacementBounds() = default;
+
+    /**
+     * @brief 使位移界失效，下一步強制重新檢測
+     */
+    void reset() { m_valid = false; }
+
+    /**
+     * @brief 位移界是否有效
+     * @return 是否已計算且未失效
+     */
+    bool isValid() const { return m_valid; }
+
+    /**
+     * @brief 在碰撞檢測後以當前位置為錨點計算位移界
+     * @param positions 粒子位置 (碰撞座標)
+     * @param contacts 本次檢測得到的接觸列表 (記錄參考深度)
+     * @param colliderDistances 每個頂點到靜態碰撞體表面的有號距離 (空表示沒有靜態碰撞體)
+     * @param clothQueryDistance 布料碰撞的查詢距離 (0 表示未啟用布料碰撞)
+     * @param settings 平行設定
+     */
+    void compute(const std::vector<glm::vec3>& positions, const std::vector<OGCContact>& contacts,
+                 const std::vector<float>& colliderDistances, float clothQueryDistance,
+                 const ParallelSettings& settings);
+
+    /**
+     * @brief 把超出位移界的頂點截斷到界上
+     * @param positions 粒子位置 (原地修改)
+     * @param settings 平行設定
+     * @return 被截斷的頂點數
+     */
+    int clamp(std::vector<glm::vec3>& positions, const ParallelSettings& settings);
+
+    /**
+     * @brief 按錨點位移線性更新沿用接觸的穿透深度
+     * @param contacts 上次檢測得到的接觸列表
+     * @param positions 粒子位置 (碰撞座標)
+     */
+    void updateContactDepths(std::vector<OGCContact>& contacts, const std::vector<glm::vec3>& positions) const;
+
+    /**
+     * @brief 最近一次 clamp 被截斷的頂點
+     * @return 頂點旗標 (非零表示被截斷)
+     */
+    const std::vector<char>& getClampedFlags() const { return m_clamped; }
+
+    // Getter 和 Setter
+    void setRelaxation(float relaxation) { m_relaxation = relaxation; }
+    float getRelaxation() const { return m_relaxation; }
+
+    float getBound(int vertex) const { return m_bounds[vertex]; }
+
+private:
+    float m_relaxation;                     // 鬆弛係數
+    bool m_valid;
+    std::vector<glm::vec3> m_anchors;       // 計算位移界時的頂點位置
+    std::vector<float> m_bounds;            // 每個頂點的位移界
+    std::vector<float> m_referenceDepths;   // 每個接觸在錨點處的穿透深度
+    std::vector<char> m_clamped;            // 每個頂點是否被截斷
+};
+
+} // namespace Physics
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <vector>
+
+namespace Physics {
+
+/**
+ * @brief 幀時間統計 (最近若干幀的環形緩衝與百分位數)
+ */
+class FrameTimeStats {
+public:
+    /**
+     * @brief 百分位數摘要 (秒)
+     */
+    struct Summary {
+        double p50 = 0.0;
+        double p95 = 0.0;
+        double p99 = 0.0;
+        double max = 0.0;
+        int samples = 0;
+    };
+
+    /**
+     * @brief 構造函數
+     * @param capacity 保留的樣本數
+     */
+    explicit FrameTimeStats(int capacity = 512);
+
+    ~FrameTimeStats() = default;
+
+    /**
+     * @brief 記錄一個樣本
+     * @param seconds 耗時 (秒)
+     */
+    void record(double seconds);
+
+    /**
+     * @brief 計算目前樣本的百分位數
+     */
+    Summary summarize() const;
+
+    int getSampleCount() const { return m_count; }
+
+    void clear() { m_count = 0; m_next = 0; }
+
+private:
+    std::vector<double> m_samples;          // 環形緩衝
+    mutable std::vector<double> m_sorted;   // 百分位數暫存 (跨呼叫保留容量)
+    int m_count;
+    int m_next;
+};
+
+/**
+ * @brief 固定時間步長的幀節拍器
+ *
+ * 累積實際經過的時間並換算成本次要執行的子步數，子步數有上限：
+ * 一幀落後太多時丟棄超出上限的時間 (模擬暫時變慢)，而不是越補越慢的
+ * 死亡螺旋。同時量測每個子步的實際成本，超出預算時先減少約束迭代數，
+ * 成本回落後再逐步恢復，盡量以精度換取不掉幀。
+ */
+class FramePacer {
+public:
+    /**
+     * @brief 構造函數
+     * @param fixedTimeStep 固定時間步長 (秒)
+     * @param maxSubsteps 每幀最多子步數
+     * @param budgetFraction 每步成本預算佔步長的比例
+     */
+    FramePacer(double fixedTimeStep = 1.0 / 60.0, int maxSubsteps = 4, double budgetFraction = 0.8);
+
+    ~FramePacer() = default;
+
+    /**
+     * @brief 累積經過時間並返回本幀要執行的子步數
+     * @param elapsedSeconds 距上一次呼叫的實際時間
+     * @return 子步數 (不超過 maxSubsteps)
+     */
+    int advance(double elapsedSeconds);
+
+    /**
+     * @brief 記錄一個子步的實際成本
+     * @param seconds 耗時 (秒)
+     */
+    void recordStepCost(double seconds);
+
+    /**
+     * @brief 按量測成本調整約束迭代數
+     *
+     * 平均成本超過預算時減一 (不低於 minIterations)，低於預算一半時加一
+     * (不超過 maxIterations)。兩次調整之間至少間隔若干子步，避免來回振盪。
+     *
+     * @param currentIterations 目前迭代數
+     * @param minIterations 最少迭代數
+     * @param maxIterations 最多迭代數 (通常為設定值)
+     * @return 建議的迭代數
+     */
+    int adjustIterations(int currentIterations, int minIterations, int maxIterations);
+
+    /**
+     * @brief 距離下一個子步到期的時間 (秒)
+     */
+    double timeUntilNextStep() const { return m_fixedTimeStep - m_accumulator; }
+
+    /**
+     * @brief 清空累積時間 (暫停或重置後呼叫，避免恢復時補步)
+     */
+    void resetAccumulator() { m_accumulator = 0.0; }
+
+    // Getter 和 Setter
+    void setMaxSubsteps(int maxSubsteps) { m_maxSubsteps = maxSubsteps > 1 ? maxSubsteps : 1; }
+    int getMaxSubsteps() const { return m_maxSubsteps; }
+    void setBudgetFraction(double fraction) { m_budgetFraction = fraction; }
+    double getBudgetFraction() const { return m_budgetFraction; }
+    double getFixedTimeStep() const { return m_fixedTimeStep; }
+
+    /**
+     * @brief 子步成本的平滑平均 (秒)
+     */
+    double getAverageStepCost() const { return m_averageStepCost; }
+
+    /**
+     * @brief 因子步上限而丟棄的累積模擬時間 (秒)
+     */
+    double getDroppedTime() const { return m_droppedTime; }
+
+    /**
+     * @brief 觸及子步上限的幀數
+     */
+    int getCappedFrameCount() const { return m_cappedFrameCount; }
+
+    /**
+     * @brief 子步成本統計
+     */
+    const FrameTimeStats& getStepStats() const { return m_stepStats; }
+
+private:
+    double m_fixedTimeStep;
+    int m_maxSubsteps;
+    double m_budgetFraction;
+    double m_accumulator;
+    double m_averageStepCost;       // 指數移動平均
+    double m_droppedTime;
+    int m_cappedFrameCount;
+    int m_stepsSinceAdjust;
+    FrameTimeStats m_stepStats;
+};
+
+} // namespace Physics
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <vector>
+#include <glm/glm.hpp>
+#include "physics/OGCContactModel.h"
+#include "physics/Parallel.h"
+
+namespace Physics {
+
+/**
+ * @brief 高度場地形碰撞體
+ *
+ * 地形以 XZ 平面上的規則高度網格表示 (y 向上)。每個粒子的查詢只需由
+ * XZ 座標直接算出所在格子，再做雙線性插值得到高度與解析法線，
+ * 成本與地形大小無關，不需要 BVH。網格範圍外的粒子不與地形接觸。
+ */
+class HeightfieldCollider {
+public:
+    HeightfieldCollider();
+    ~HeightfieldCollider() = default;
+
+    /**
+     * @brief 由高度網格建立碰撞體
+     * @param heights 樣本高度 (x 最快變化，共 columns * rows 個)
+     * @param columns x 方向樣本數 (至少 2)
+     * @param rows z 方向樣本數 (至少 2)
+     * @param origin 樣本 (0, 0) 的位置 (碰撞座標；y 為高度基準)
+     * @param cellSize 格子大小
+     * @return 是否成功
+     */
+    bool build(const std::vector<float>& heights, int columns, int rows,
+               const glm::vec3& origin, float cellSize);
+
+    /**
+     * @brief 批次查詢地形高度與法線 (每 8 個粒子一組，以 SoA 方式計算)
+     * @param positions 查詢位置
+     * @param count 查詢數量
+     * @param heights 輸出地形高度 (網格範圍外為 -FLT_MAX)
+     * @param normals 輸出單位法線
+     */
+    void query(const glm::vec3* positions, int count, float* heights, glm::vec3* normals) const;
+
+    /**
+     * @brief 檢測粒子與地形的接觸並追加
+     * @param positions 粒子位置 (碰撞座標)
+     * @param particleRadius 粒子半徑
+     * @param contacts 輸出接觸列表 (追加)
+     * @param settings 平行設定
+     */
+    void detect(const std::vector<glm::vec3>& positions, float particleRadius,
+                std::vector<OGCContact>& contacts, const ParallelSettings& settings);
+
+    /**
+     * @brief 單點到地形切平面的有號距離
+     * @param position 查詢位置
+     * @return 有號距離 (地形下方為負；網格範圍外為 FLT_MAX)
+     */
+    float distance(const glm::vec3& position) const;
+
+    bool isValid() const { return !m_heights.empty(); }
+    int getColumns() const { return m_columns; }
+    int getRows() const { return m_rows; }
+    float getCellSize() const { return m_cellSize; }
+
+private:
+    glm::vec3 m_origin;                 // 樣本 (0, 0) 的位置
+    int m_columns;                      // x 方向樣本數
+    int m_rows;                         // z 方向樣本數
+    float m_cellSize;                   // 格子大小
+    std::vector<float> m_heights;       // 樣本高度 (已加上 origin.y)
+    std::vector<std::vector<OGCContact>> m_blockContacts;  // 每個區塊的接觸緩衝
+};
+
+} // namespace Physics
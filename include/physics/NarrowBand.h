@@ -0,0 +1,117 @@
+#pragma once
+
+#include <vector>
+#include <functional>
+#include <glm/glm.hpp>
+#include "physics/Parallel.h"
+
+namespace Physics {
+
+/**
+ * @brief 碰撞後端的窄帶活躍集
+ *
+ * 粒子按布料格子分成小塊 (簇)，每簇以包圍球概括。重建一個簇時先查詢球心到
+ * 碰撞體的距離 D：D - 半徑 ≥ 接觸距離 + 餘量時整簇在帶外，不再逐粒子查詢；
+ * 否則逐粒子查詢，距離小於接觸距離 + 餘量者為候選。距離函數為 1-Lipschitz，
+ * 因此帶外粒子在位移不超過餘量之前不可能產生接觸。
+ *
+ * 每步只檢查各粒子相對錨點 (重建時位置) 的位移，簇內有粒子超過餘量時
+ * 才重建該簇。帶外粒子在略過遮罩中標記，後端不對其做窄相查詢，
+ * 檢測成本因此只與靠近碰撞體的粒子數相關。
+ *
+ * 範圍：只概括碰撞後端的碰撞體 (距離函數由呼叫者提供)，且按粒子而非按
+ * (粒子, 碰撞體) 對記錄——帶內粒子仍對後端所有碰撞體做窄相查詢。
+ * SDF、高度場、解析碰撞體與自碰撞不經過此遮罩。
+ */
+class NarrowBand {
+public:
+    /**
+     * @brief 點到靜態碰撞體表面的有號距離 (須為保守下界)
+     */
+    using DistanceFn = std::function<float(const glm::vec3&)>;
+
+    /**
+     * @brief 構造函數
+     * @param slack 帶的餘量 (粒子位移超過此值時重建所在簇)
+     * @param clusterSize 簇在格子上的邊長 (粒子數)
+     */
+    NarrowBand(float slack = 0.1f, int clusterSize = 8);
+
+    ~NarrowBand() = default;
+
+    /**
+     * @brief 使活躍集失效，下一步重建所有簇 (碰撞體改變後呼叫)
+     */
+    void reset() { m_anchors.clear(); }
+
+    /**
+     * @brief 設置布料格子拓撲 (簇為 clusterSize x clusterSize 的格子塊)
+     * @param width 格子寬度
+     * @param height 格子高度
+     */
+    void setGridTopology(int width, int height);
+
+    /**
+     * @brief 重建位移超過餘量的簇並返回略過遮罩
+     * @param positions 粒子位置 (碰撞座標)
+     * @param contactDistance 粒子中心到碰撞體表面產生接觸的最大距離
+     * @param distance 距離查詢函數
+     * @param settings 平行設定
+     * @return 按粒子索引的略過遮罩 (非零表示在帶外)
+     */
+    const std::vector<char>& update(const std::vector<glm::vec3>& positions, float contactDistance,
+                                    const DistanceFn& distance, const ParallelSettings& settings);
+
+    // Getter 和 Setter
+    void setSlack(float slack) { m_slack = slack; reset(); }
+    float getSlack() const { return m_slack; }
+
+    /**
+     * @brief 最近一次 update 後帶內的候選粒子數
+     */
+    int getCandidateCount() const { return m_candidateCount; }
+
+    /**
+     * @brief 最近一次 update 重建的簇數
+     */
+    int getRebuiltClusterCount() const { return m_rebuiltClusterCount; }
+
+    /**
+     * @brief 最近一次 update 以包圍球整簇剔除的簇數
+     */
+    int getCulledClusterCount() const { return m_culledClusterCount; }
+
+    int getClusterCount() const { return m_clusterOffsets.empty() ? 0 : static_cast<int>(m_clusterOffsets.size()) - 1; }
+
+private:
+    float m_slack;                          // 帶的餘量
+    int m_clusterSize;                      // 簇在格子上的邊長
+    int m_gridWidth;
+    int m_gridHeight;
+    int m_candidateCount;
+    int m_rebuiltClusterCount;
+    int m_culledClusterCount;
+    float m_bandDistance;                   // 最近一次重建時的帶寬 (接觸距離 + 餘量)
+
+    std::vector<int> m_clusterOffsets;      // 每個簇的粒子起點 (長度為簇數 + 1)
+    std::vector<int> m_clusterParticles;    // 按簇排列的粒子索引
+    std::vector<glm::vec3> m_anchors;       // 每個粒子在所屬簇重建時的位置
+    std::vector<char> m_skip;               // 略過遮罩
+    std::vector<int> m_clusterCandidates;   // 每個簇的候選粒子數
+    std::vector<char> m_clusterState;       // 每個簇本次的狀態 (0: 沿用, 1: 重建, 2: 整簇剔除)
+
+    /**
+     * @brief 按格子拓撲 (粒子數不符時按連續索引) 建立簇
+     * @param particleCount 粒子數
+     */
+    void buildClusters(int particleCount);
+
+    /**
+     * @brief 以當前位置重建一個簇
+     * @return 簇是否被包圍球整簇剔除
+     */
+    bool rebuildCluster(int cluster, const std::vector<glm::vec3>& positions, float bandDistance,
+                        const DistanceFn& distance);
+};
+
+} // namespace Physics
@@ -2,32 +2,59 @@
 
 #include <vector>
 #include <memory>
+#include <algorithm>
 #include <glm/glm.hpp>
+#include "physics/Parallel.h"
+#include "physics/Particle.h"
+#include "physics/Span.h"
 
 namespace Physics {
 
-// 前向聲明
-class Particle;
-
 /**
  * @brief OGC 接觸信息結構
+ *
+ * 以粒子索引引用布料粒子，與模擬精度無關；幾何量位於模擬的局部座標系。
  */
 struct OGCContact {
-    Particle* particleA;           // 接觸粒子A
-    Particle* particleB;           // 接觸粒子B (可能為nullptr，表示與靜態物體接觸)
+    int particleIndexA;            // 粒子A在布料中的索引
+    int particleIndexB;            // 粒子B在布料中的索引 (-1 表示與靜態物體接觸)
+    int particleIndexA1;           // 邊-邊接觸時A側的第二個粒子 (-1 表示未使用)
+    int particleIndexB1;           // 點-面/邊-邊接觸時B側的第二個粒子
+    int particleIndexB2;           // 點-面接觸時B側的第三個粒子
+    glm::vec2 weightsA;            // A側粒子的重心權重
+    glm::vec3 weightsB;            // B側粒子的重心權重
     glm::vec3 contactPoint;        // 接觸點位置
     glm::vec3 contactNormal;       // 接觸法線 (從A指向B)
     float penetrationDepth;        // 穿透深度
     float contactRadius;           // OGC接觸半徑
+    float timeOfImpact;            // 連續碰撞的撞擊時間 [0, 1] (1 表示離散接觸)
     glm::vec3 offsetGeometry;      // OGC偏移幾何
     float contactForce;            // 接觸力大小
     glm::vec3 forceDirection;      // 接觸力方向
+    int featureId;                 // 碰撞體特徵 (靜態碰撞體編號，-1 表示只以粒子區分)
+    float previousForce;           // 上一幀同一接觸的力 (熱啟動用，-1 表示新接觸)
+    glm::vec3 colliderVelocity;    // 碰撞體在接觸點的速度 (運動學碰撞體，靜態為零)
     
-    OGCContact() : particleA(nullptr), particleB(nullptr), 
+    OGCContact() : particleIndexA(-1), particleIndexB(-1),
+                   particleIndexA1(-1), particleIndexB1(-1), particleIndexB2(-1),
+                   weightsA(1.0f, 0.0f), weightsB(1.0f, 0.0f, 0.0f),
                    contactPoint(0.0f), contactNormal(0.0f, 1.0f, 0.0f),
-                   penetrationDepth(0.0f), contactRadius(0.05f),
+                   penetrationDepth(0.0f), contactRadius(0.05f), timeOfImpact(1.0f),
                    offsetGeometry(0.0f), contactForce(0.0f),
-                   forceDirection(0.0f) {}
+                   forceDirection(0.0f), featureId(-1), previousForce(-1.0f),
+                   colliderVelocity(0.0f) {}
+    
+    /**
+     * @brief 是否為多粒子 (點-面 / 邊-邊) 接觸
+     * @return A或B側是否由多個粒子組成
+     */
+    bool isStencilContact() const { return particleIndexA1 >= 0 || particleIndexB1 >= 0; }
+    
+    /**
+     * @brief 是否為連續碰撞檢測產生的撞擊接觸
+     * @return 撞擊時間是否在本步內
+     */
+    bool isImpactContact() const { return timeOfImpact < 1.0f; }
 };
 
 /**
@@ -56,10 +83,57 @@ public:
 
     /**
      * @brief 處理接觸列表
-     * @param contacts 接觸列表
+     *
+     * 分兩階段執行：先平行計算每個接觸的偏移幾何和接觸力 (只讀粒子狀態)，
+     * 再施加力和位置修正。多執行緒時第二階段按粒子歸屬分組，每個粒子由
+     * 一個執行緒按接觸順序累加，結果與單執行緒串行累加逐位相同。
+     *
+     * @param contacts 接觸視圖 (原地寫入偏移幾何與接觸力，不增減元素)
+     * @param particles 布料粒子列表
      * @param deltaTime 時間步長
+     * @param settings 平行設定
+     */
+    template <typename Real>
+    void processContacts(Span<OGCContact> contacts, ParticleList<Real>& particles,
+                         float deltaTime, const ParallelSettings& settings = ParallelSettings());
+
+    /**
+     * @brief 把接觸當作單側約束做一次位置投影 (在約束迭代內呼叫)
+     *
+     * 當前穿透深度 = 檢測時深度 - n·(Σ w Δx)，Δx 為粒子相對檢測時位置的位移；
+     * 接觸集在各次迭代間沿用，不重新檢測。先平行求每個接觸的深度，再由每個粒子
+     * 平均其仍穿透的接觸給出的完整修正 (Jacobi)，結果與執行緒數無關。
+     *
+     * @param contacts 最近一次檢測得到的接觸 (唯讀，穿透深度為檢測時的值)
+     * @param particles 布料粒子列表
+     * @param anchors 檢測時的粒子位置
+     * @param settings 平行設定
      */
-    void processContacts(std::vector<OGCContact>& contacts, float deltaTime);
+    template <typename Real>
+    void projectContacts(Span<const OGCContact> contacts, ParticleList<Real>& particles,
+                         const std::vector<Vec3T<Real>>& anchors, const ParallelSettings& settings = ParallelSettings());
+
+    /**
+     * @brief 按粒子合併近似重複的靜態接觸
+     *
+     * 同一粒子的單粒子靜態接觸按 (深度遞減, 特徵, 原順序) 排序後貪婪分簇：
+     * 法線與簇內最深接觸的夾角餘弦不小於閾值者併入該簇，否則在預算內開新簇，
+     * 預算用盡後剩下的淺接觸捨棄。每簇輸出最深接觸，法線取簇內按深度加權的
+     * 平均法線。選擇只由接觸本身決定，與執行緒數和檢測順序無關。
+     * 輸出中合併後的接觸按粒子排列，其餘接觸原樣附在其後。
+     *
+     * @param contacts 接觸列表 (原地改寫)
+     * @param particleCount 粒子數
+     * @param settings 平行設定
+     */
+    void reduceContacts(std::vector<OGCContact>& contacts, int particleCount,
+                        const ParallelSettings& settings = ParallelSettings());
+
+    /**
+     * @brief 將接觸排序為與檢測順序無關的固定順序
+     * @param contacts 接觸視圖 (原地排序)
+     */
+    static void sortContacts(Span<OGCContact> contacts);
 
     /**
      * @brief 計算OGC偏移幾何
@@ -71,22 +145,28 @@ public:
     /**
      * @brief 應用OGC接觸力
      * @param contact 接觸信息
+     * @param particles 布料粒子列表
      * @param deltaTime 時間步長
      */
-    void applyOGCForce(OGCContact& contact, float deltaTime);
+    template <typename Real>
+    void applyOGCForce(OGCContact& contact, ParticleList<Real>& particles, float deltaTime);
 
     /**
      * @brief 計算接觸力大小和方向
      * @param contact 接觸信息
+     * @param particles 布料粒子列表
      * @param deltaTime 時間步長
      */
-    void calculateContactForce(OGCContact& contact, float deltaTime);
+    template <typename Real>
+    void calculateContactForce(OGCContact& contact, const ParticleList<Real>& particles, float deltaTime);
 
     /**
      * @brief 執行位置修正以防止穿透
      * @param contact 接觸信息
+     * @param particles 布料粒子列表
      */
-    void performPositionCorrection(const OGCContact& contact);
+    template <typename Real>
+    void performPositionCorrection(const OGCContact& contact, ParticleList<Real>& particles);
 
     // Getter 和 Setter
     void setContactRadius(float radius) { m_contactRadius = radius; }
@@ -100,26 +180,120 @@ public:
     
     void setPositionCorrectionFactor(float factor) { m_positionCorrectionFactor = factor; }
     float getPositionCorrectionFactor() const { return m_positionCorrectionFactor; }
+    
+    /**
+     * @brief 設定熱啟動權重
+     *
+     * 接觸帶有上一幀的力 (previousForce >= 0) 時，新力與舊力按此權重混合，
+     * 靜止接觸不必每幀從零重建力，抖動更小。0 表示關閉。
+     *
+     * @param factor 舊力權重 [0, 1]
+     */
+    void setWarmStartFactor(float factor) { m_warmStartFactor = std::max(0.0f, std::min(1.0f, factor)); }
+    float getWarmStartFactor() const { return m_warmStartFactor; }
+    
+    /**
+     * @brief 設定接觸合併時每個粒子保留的接觸數上限 [1, 8]
+     */
+    void setReductionBudget(int budget) { m_reductionBudget = std::max(1, std::min(kMaxReductionBudget, budget)); }
+    int getReductionBudget() const { return m_reductionBudget; }
+    
+    /**
+     * @brief 設定接觸合併的法線夾角餘弦閾值 (不小於此值的接觸併為一簇)
+     */
+    void setReductionCosine(float cosine) { m_reductionCosine = cosine; }
+    float getReductionCosine() const { return m_reductionCosine; }
+    
+    /**
+     * @brief 最近一次 reduceContacts 移除的接觸數
+     */
+    int getReducedContactCount() const { return m_reducedContactCount; }
 
 private:
     float m_contactRadius;              // 接觸半徑
     float m_stiffness;                  // 接觸剛度
     float m_damping;                    // 接觸阻尼
     float m_positionCorrectionFactor;   // 位置修正係數
+    float m_warmStartFactor;            // 熱啟動時上一幀接觸力的權重
+    int m_reductionBudget;              // 接觸合併時每個粒子保留的接觸數上限
+    float m_reductionCosine;            // 接觸合併的法線夾角餘弦閾值
+    int m_reducedContactCount;
+    
+    static constexpr int kMaxReductionBudget = 8;
+    
+    /**
+     * @brief 粒子參與的接觸 (接觸索引與粒子在接觸中的槽位)
+     */
+    struct ContactIncidence {
+        int contact;
+        int slot;
+    };
+    
+    std::vector<int> m_incidenceOffsets;            // 每個粒子的條目起點 (長度為粒子數 + 1)
+    std::vector<int> m_incidenceCursor;             // 填寫條目時的游標
+    std::vector<ContactIncidence> m_incidences;     // 按粒子分組的接觸條目
+    std::vector<float> m_projectionDepths;          // 投影時每個接觸的當前穿透深度
+    
+    // 接觸合併的暫存 (跨幀保留容量)
+    std::vector<int> m_reductionOffsets;            // 每個粒子的靜態接觸起點 (長度為粒子數 + 1)
+    std::vector<int> m_reductionOrder;              // 按粒子分組的接觸索引
+    std::vector<int> m_reducedCounts;               // 每個粒子合併後的接觸數
+    std::vector<OGCContact> m_reducedContacts;      // 合併結果 (按粒子起點存放)
+    std::vector<OGCContact> m_reductionOutput;
+    
+    /**
+     * @brief 按粒子分組接觸條目 (CSR)
+     * @param contacts 接觸列表
+     * @param particleCount 粒子數
+     */
+    void buildParticleIncidence(Span<const OGCContact> contacts, int particleCount);
+    
+    /**
+     * @brief 把單一接觸對其中一個粒子的力和位置修正累加到該粒子
+     * @param contact 接觸信息
+     * @param slot 粒子在接觸中的槽位 (0: A, 1: A1, 2: B, 3: B1, 4: B2)
+     * @param particles 布料粒子列表
+     */
+    template <typename Real>
+    void applyContactToParticle(const OGCContact& contact, int slot, ParticleList<Real>& particles);
+    
+    /**
+     * @brief 計算接觸對其中一個粒子的位置修正量
+     * @param contact 接觸信息
+     * @param slot 粒子在接觸中的槽位
+     * @param magnitude 沿法線的修正大小
+     * @param particles 布料粒子列表
+     * @param delta 輸出位置修正
+     * @return 是否有修正 (粒子固定或總逆質量為零時沒有)
+     */
+    template <typename Real>
+    bool correctionDelta(const OGCContact& contact, int slot, float magnitude,
+                         const ParticleList<Real>& particles, Vec3T<Real>& delta) const;
+    
+    /**
+     * @brief 按粒子相對檢測時位置的位移計算接觸的當前穿透深度
+     */
+    template <typename Real>
+    float currentDepth(const OGCContact& contact, const ParticleList<Real>& particles,
+                       const std::vector<Vec3T<Real>>& anchors) const;
     
     /**
-     * @brief 計算相對速度
+     * @brief 計算相對速度 (靜態接觸減去碰撞體在接觸點的速度)
      * @param contact 接觸信息
+     * @param particles 布料粒子列表
      * @return 相對速度
      */
-    glm::vec3 calculateRelativeVelocity(const OGCContact& contact);
+    template <typename Real>
+    glm::vec3 calculateRelativeVelocity(const OGCContact& contact, const ParticleList<Real>& particles);
     
     /**
      * @brief 計算法線速度
      * @param contact 接觸信息
+     * @param particles 布料粒子列表
      * @return 法線方向的相對速度
      */
-    float calculateNormalVelocity(const OGCContact& contact);
+    template <typename Real>
+    float calculateNormalVelocity(const OGCContact& contact, const ParticleList<Real>& particles);
 };
 
 } // namespace Physics
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <type_traits>
+#include <vector>
+#include <algorithm>
+
+namespace Physics {
+
+/**
+ * @brief 平行執行設定
+ */
+struct ParallelSettings {
+    int threadCount;        // 工作執行緒數 (1 表示單執行緒)
+    bool deterministic;     // 位元級確定性模式
+    int grainSize;          // 確定性模式下的固定分塊大小
+
+    ParallelSettings(int threads = 1, bool isDeterministic = false, int grain = 256)
+        : threadCount(threads), deterministic(isDeterministic), grainSize(grain) {}
+};
+
+/**
+ * @brief 平行迴圈的區塊回呼 (不擁有函數物件，避免 std::function 的堆積配置)
+ */
+using ParallelBlockFn = void (*)(void* body, int begin, int end);
+
+/**
+ * @brief parallelFor 的非模板實現
+ * @param count 元素數量
+ * @param settings 平行設定
+ * @param invoke 區塊回呼
+ * @param body 傳給回呼的函數物件
+ */
+void parallelForBlocks(int count, const ParallelSettings& settings, ParallelBlockFn invoke, void* body);
+
+/**
+ * @brief 平行迴圈
+ *
+ * 將 [0, count) 切成區塊，由呼叫者與常駐執行緒池 (TaskScheduler) 的工作執行緒
+ * 動態領取，body 以 (begin, end) 區間被呼叫。
+ * 確定性模式下區塊邊界只由 grainSize 決定，與執行緒數無關，
+ * 因此任何執行緒數下每個元素都走完全相同的計算路徑。
+ * body 內只能寫入屬於自己區間的數據。
+ *
+ * @param count 元素數量
+ * @param settings 平行設定
+ * @param body 區塊處理函數
+ */
+template <typename Body>
+void parallelFor(int count, const ParallelSettings& settings, Body&& body) {
+    using BodyType = typename std::remove_reference<Body>::type;
+    parallelForBlocks(count, settings, [](void* fn, int begin, int end) {
+        (*static_cast<BodyType*>(fn))(begin, end);
+    }, const_cast<void*>(static_cast<const void*>(&body)));
+}
+
+/**
+ * @brief 把各區塊的輸出緩衝壓實追加到輸出陣列
+ *
+ * 先以前綴和算出每個區塊在輸出中的起點，一次擴充輸出，再平行複製。
+ * 結果按區塊順序排列，與執行緒數無關。
+ * 各區塊緩衝的容量同時對齊到最大的區塊：接觸隨布料移動到其他區塊時，
+ * 不必等每個區塊各自創新高才停止配置。
+ *
+ * @param blocks 各區塊的輸出緩衝 (只調整容量)
+ * @param output 輸出陣列 (追加)
+ * @param settings 平行設定
+ */
+template <typename T>
+void compactBlocks(std::vector<std::vector<T>>& blocks, std::vector<T>& output,
+                   const ParallelSettings& settings) {
+    int blockCount = static_cast<int>(blocks.size());
+
+    // 前綴和暫存跨呼叫重用，穩態下不配置 (以引用交給工作執行緒)
+    thread_local std::vector<size_t> offsetScratch;
+    std::vector<size_t>& offsets = offsetScratch;
+    offsets.resize(blockCount + 1);
+    offsets[0] = output.size();
+    size_t largest = 0;
+    for (int block = 0; block < blockCount; ++block) {
+        offsets[block + 1] = offsets[block] + blocks[block].size();
+        largest = std::max(largest, blocks[block].size());
+    }
+    for (std::vector<T>& block : blocks) {
+        if (block.capacity() < largest) block.reserve(largest);
+    }
+    if (offsets[blockCount] == output.size()) return;
+
+    output.resize(offsets[blockCount]);
+    ParallelSettings copySettings(settings.threadCount, settings.deterministic, 1);
+    parallelFor(blockCount, copySettings, [&](int begin, int end) {
+        for (int block = begin; block < end; ++block) {
+            std::copy(blocks[block].begin(), blocks[block].end(), output.begin() + offsets[block]);
+        }
+    });
+}
+
+} // namespace Physics
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+#include "physics/Precision.h"
 
 namespace Physics {
 
@@ -8,29 +11,34 @@ namespace Physics {
  * @brief 粒子類
  * 
  * 表示布料模擬中的一個粒子，包含位置、速度、力等物理屬性。
+ * 以標量類型 Real 為模板參數，提供 float (Particle) 和 double (ParticleD) 兩種實例。
  */
-class Particle {
+template <typename Real>
+class BasicParticle {
 public:
+    using Scalar = Real;
+    using Vec3 = Vec3T<Real>;
+
     /**
      * @brief 構造函數
      * @param position 初始位置
      * @param mass 質量
      */
-    Particle(const glm::vec3& position = glm::vec3(0.0f), float mass = 1.0f);
+    BasicParticle(const Vec3& position = Vec3(Real(0)), Real mass = Real(1));
     
-    ~Particle() = default;
+    ~BasicParticle() = default;
 
     /**
      * @brief 更新粒子狀態 (Verlet積分)
      * @param deltaTime 時間步長
      */
-    void update(float deltaTime);
+    void update(Real deltaTime);
 
     /**
      * @brief 添加力
      * @param force 要添加的力
      */
-    void addForce(const glm::vec3& force);
+    void addForce(const Vec3& force);
 
     /**
      * @brief 清除所有力
@@ -41,55 +49,55 @@ public:
      * @brief 設定位置
      * @param position 新位置
      */
-    void setPosition(const glm::vec3& position);
+    void setPosition(const Vec3& position);
 
     /**
      * @brief 獲取位置
      * @return 當前位置
      */
-    const glm::vec3& getPosition() const { return m_position; }
+    const Vec3& getPosition() const { return m_position; }
 
     /**
      * @brief 獲取上一幀位置
      * @return 上一幀位置
      */
-    const glm::vec3& getPreviousPosition() const { return m_previousPosition; }
+    const Vec3& getPreviousPosition() const { return m_previousPosition; }
 
     /**
      * @brief 獲取速度
      * @return 當前速度
      */
-    glm::vec3 getVelocity() const;
+    Vec3 getVelocity() const;
 
     /**
      * @brief 設定速度
      * @param velocity 新速度
      */
-    void setVelocity(const glm::vec3& velocity);
+    void setVelocity(const Vec3& velocity);
 
     /**
      * @brief 獲取質量
      * @return 質量
      */
-    float getMass() const { return m_mass; }
+    Real getMass() const { return m_mass; }
 
     /**
      * @brief 獲取逆質量
      * @return 逆質量 (1/質量)
      */
-    float getInverseMass() const { return m_inverseMass; }
+    Real getInverseMass() const { return m_inverseMass; }
 
     /**
      * @brief 設定質量
      * @param mass 新質量
      */
-    void setMass(float mass);
+    void setMass(Real mass);
 
     /**
      * @brief 檢查是否為固定粒子
      * @return 是否固定
      */
-    bool isFixed() const { return m_inverseMass == 0.0f; }
+    bool isFixed() const { return m_inverseMass == Real(0); }
 
     /**
      * @brief 設定為固定粒子
@@ -101,14 +109,23 @@ public:
      * @brief 獲取累積力
      * @return 當前累積的力
      */
-    const glm::vec3& getAccumulatedForce() const { return m_force; }
+    const Vec3& getAccumulatedForce() const { return m_force; }
 
 private:
-    glm::vec3 m_position;           // 當前位置
-    glm::vec3 m_previousPosition;   // 上一幀位置
-    glm::vec3 m_force;              // 累積力
-    float m_mass;                   // 質量
-    float m_inverseMass;            // 逆質量
+    Vec3 m_position;                // 當前位置
+    Vec3 m_previousPosition;        // 上一幀位置
+    Vec3 m_force;                   // 累積力
+    Real m_mass;                    // 質量
+    Real m_inverseMass;             // 逆質量
 };
 
+/**
+ * @brief 粒子列表類型
+ */
+template <typename Real>
+using ParticleList = std::vector<std::unique_ptr<BasicParticle<Real>>>;
+
+extern template class BasicParticle<float>;
+extern template class BasicParticle<double>;
+
 } // namespace Physics
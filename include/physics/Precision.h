@@ -0,0 +1,30 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+namespace Physics {
+
+/**
+ * @brief 模擬核心精度設定
+ *
+ * 粒子與布料模擬以標量類型 Real 為模板參數：
+ * - float  : 預設，速度最快
+ * - double : 大座標或長時間模擬，減少 Verlet (2*pos - prevPos) 的累積誤差
+ * - 混合   : float 粒子搭配 double 世界原點 (見 BasicClothSimulation::setWorldOrigin)，
+ *            粒子座標保持在原點附近的小數值範圍
+ *
+ * 碰撞檢測與接觸幾何固定使用 float，在模擬的局部座標系中進行。
+ */
+template <typename Real>
+using Vec3T = glm::vec<3, Real, glm::defaultp>;
+
+template <typename Real>
+using Vec2T = glm::vec<2, Real, glm::defaultp>;
+
+template <typename Real> class BasicParticle;
+template <typename Real> class BasicClothSimulation;
+
+using Particle = BasicParticle<float>;
+using ParticleD = BasicParticle<double>;
+
+} // namespace Physics
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include "physics/OGCContactModel.h"
+#include "physics/Parallel.h"
+
+namespace Physics {
+
+/**
+ * @brief 有號距離場 (SDF) 靜態碰撞體
+ *
+ * 建立時把靜態三角形網格體素化為窄帶有號距離網格 (帶內為精確距離，
+ * 符號由角度加權偽法線決定，帶外以洪水填充傳播符號並截斷為帶寬)，
+ * 之後每個粒子的查詢只是一次三線性插值與梯度計算，成本與網格複雜度無關。
+ * 網格可選擇快取到磁碟，以輸入內容的雜湊判斷快取是否有效。
+ */
+class SdfCollider {
+public:
+    SdfCollider();
+    ~SdfCollider() = default;
+
+    /**
+     * @brief 由三角形網格建立距離場
+     * @param vertices 網格頂點 (碰撞座標)
+     * @param triangles 三角形頂點索引 (逆時針為外側)
+     * @param voxelSize 體素大小
+     * @param bandWidth 窄帶寬度 (帶外距離截斷為此值)
+     * @param cachePath 快取檔案路徑 (空字串表示不使用快取)
+     * @return 是否成功
+     */
+    bool build(const std::vector<glm::vec3>& vertices, const std::vector<glm::ivec3>& triangles,
+               float voxelSize, float bandWidth, const std::string& cachePath = "");
+
+    /**
+     * @brief 批次查詢距離與梯度 (每 8 個粒子一組，以 SoA 方式計算)
+     * @param positions 查詢位置
+     * @param count 查詢數量
+     * @param distances 輸出有號距離
+     * @param gradients 輸出距離梯度 (未正規化)
+     */
+    void query(const glm::vec3* positions, int count, float* distances, glm::vec3* gradients) const;
+
+    /**
+     * @brief 檢測粒子與距離場的接觸並追加
+     * @param positions 粒子位置 (碰撞座標)
+     * @param particleRadius 粒子半徑
+     * @param contacts 輸出接觸列表 (追加)
+     * @param settings 平行設定
+     */
+    void detect(const std::vector<glm::vec3>& positions, float particleRadius,
+                std::vector<OGCContact>& contacts, const ParallelSettings& settings);
+
+    /**
+     * @brief 單點有號距離
+     * @param position 查詢位置
+     * @return 有號距離 (內部為負)
+     */
+    float distance(const glm::vec3& position) const;
+
+    bool isValid() const { return !m_values.empty(); }
+    const glm::ivec3& getResolution() const { return m_resolution; }
+    float getVoxelSize() const { return m_voxelSize; }
+
+private:
+    glm::vec3 m_origin;                 // 網格原點 (第一個樣本位置)
+    glm::ivec3 m_resolution;            // 各軸樣本數
+    float m_voxelSize;                  // 體素大小
+    float m_bandWidth;                  // 窄帶寬度
+    std::vector<float> m_values;        // 樣本距離 (x 最快變化)
+    std::vector<std::vector<OGCContact>> m_blockContacts;  // 每個區塊的接觸緩衝
+
+    /**
+     * @brief 體素化網格並計算窄帶距離
+     */
+    void voxelize(const std::vector<glm::vec3>& vertices, const std::vector<glm::ivec3>& triangles);
+
+    /**
+     * @brief 以洪水填充把符號傳播到窄帶外的樣本
+     * @param known 樣本是否已有精確距離
+     */
+    void propagateSigns(std::vector<char>& known);
+
+    /**
+     * @brief 計算輸入內容的雜湊 (用於快取驗證)
+     */
+    static uint64_t hashInput(const std::vector<glm::vec3>& vertices, const std::vector<glm::ivec3>& triangles,
+                              float voxelSize, float bandWidth);
+
+    bool loadCache(const std::string& path, uint64_t inputHash);
+    bool saveCache(const std::string& path, uint64_t inputHash) const;
+
+    size_t sampleIndex(int x, int y, int z) const {
+        return (static_cast<size_t>(z) * m_resolution.y + y) * m_resolution.x + x;
+    }
+};
+
+} // namespace Physics
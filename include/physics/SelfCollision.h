@@ -0,0 +1,97 @@
+#pragma once
+
+#include <vector>
+#include <atomic>
+#include <glm/glm.hpp>
+#include "physics/OGCContactModel.h"
+#include "physics/Parallel.h"
+
+namespace Physics {
+
+/**
+ * @brief 布料自碰撞檢測 (空間雜湊)
+ *
+ * 每一步以平行計數排序重建均勻網格雜湊，格子大小等於粒子間的接觸距離，
+ * 因此每個粒子只需檢查周圍 27 個格子，整體成本近似線性。
+ * 網格拓撲上相距在指定環距離內的粒子 (由約束連接) 不產生接觸。
+ * 輸出的粒子-粒子接觸直接送入 OGC 接觸管線。
+ */
+class SelfCollision {
+public:
+    /**
+     * @brief 構造函數
+     * @param particleRadius 粒子半徑
+     * @param excludedRingDistance 排除的拓撲環距離
+     */
+    SelfCollision(float particleRadius = 0.02f, int excludedRingDistance = 2);
+
+    ~SelfCollision() = default;
+
+    /**
+     * @brief 設定布料網格拓撲
+     * @param width 網格寬度 (粒子數)
+     * @param height 網格高度 (粒子數)
+     */
+    void setGridTopology(int width, int height);
+
+    /**
+     * @brief 檢測自碰撞並追加接觸
+     * @param positions 粒子位置 (碰撞座標)
+     * @param contacts 輸出接觸列表 (追加)
+     * @param settings 平行設定
+     */
+    void detect(const std::vector<glm::vec3>& positions, std::vector<OGCContact>& contacts,
+                const ParallelSettings& settings);
+
+    // Getter 和 Setter
+    void setParticleRadius(float radius) { m_particleRadius = radius; }
+    float getParticleRadius() const { return m_particleRadius; }
+
+    void setExcludedRingDistance(int ring) { m_excludedRingDistance = ring; }
+    int getExcludedRingDistance() const { return m_excludedRingDistance; }
+
+private:
+    float m_particleRadius;             // 粒子半徑
+    int m_excludedRingDistance;         // 排除的拓撲環距離
+    int m_gridWidth;                    // 網格寬度
+    int m_gridHeight;                   // 網格高度
+    float m_cellSize;                   // 格子大小
+
+    // 雜湊表 (計數排序)
+    std::vector<int> m_particleCells;               // 每個粒子的雜湊桶
+    std::vector<std::atomic<int>> m_cellCounts;     // 每個桶的粒子數 / 寫入游標
+    std::vector<int> m_cellStart;                   // 每個桶的起始位置
+    std::vector<int> m_sortedParticles;             // 按桶排序的粒子索引
+    std::vector<std::vector<OGCContact>> m_blockContacts;  // 每個區塊的接觸緩衝
+
+    /**
+     * @brief 重建空間雜湊
+     * @param positions 粒子位置
+     * @param settings 平行設定
+     */
+    void buildHash(const std::vector<glm::vec3>& positions, const ParallelSettings& settings);
+
+    /**
+     * @brief 計算格子座標的雜湊桶
+     * @param cell 格子座標
+     * @return 雜湊桶索引
+     */
+    int hashCell(const glm::ivec3& cell) const;
+
+    /**
+     * @brief 計算位置所在的格子座標
+     * @param position 位置
+     * @return 格子座標
+     */
+    glm::ivec3 cellCoord(const glm::vec3& position) const;
+
+    /**
+     * @brief 檢查兩個粒子是否為拓撲鄰居
+     * @param a 粒子A索引
+     * @param b 粒子B索引
+     * @return 是否應排除
+     */
+    bool areTopologicalNeighbours(int a, int b) const;
+};
+
+} // namespace Physics
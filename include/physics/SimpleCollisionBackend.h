@@ -0,0 +1,56 @@
+#pragma once
+
+#include "physics/CollisionBackend.h"
+
+namespace Physics {
+
+/**
+ * @brief 簡化碰撞後端
+ *
+ * 不依賴 Bullet Physics，逐粒子對每個靜態碰撞體做解析測試。
+ * 每個實例擁有自己的碰撞體，多個模擬可同時使用。
+ */
+class SimpleCollisionBackend : public CollisionBackend {
+public:
+    SimpleCollisionBackend();
+    ~SimpleCollisionBackend() override = default;
+
+    const char* getName() const override { return "simplified"; }
+
+    void addCylinder(const glm::vec3& center, float radius, float height) override;
+    void addFloor(const glm::vec3& center, const glm::vec3& size) override;
+    void addTriangleMesh(const std::shared_ptr<TriangleMeshCollider>& mesh) override;
+    int addParticle(int particleIndex, const glm::vec3& position, float radius) override;
+    void updateParticlePosition(int handle, const glm::vec3& position) override;
+    void removeParticle(int handle) override;
+    void performCollisionDetection(std::vector<OGCContact>& contacts, const ParallelSettings& settings,
+                                   const std::vector<char>* skipMask) override;
+
+private:
+    /**
+     * @brief 簡化的碰撞體結構
+     */
+    struct CollisionObject {
+        enum Type { CYLINDER, BOX, SPHERE, MESH };
+        Type type;
+        glm::vec3 center;
+        glm::vec3 size; // 對於圓柱體：x=radius, y=height, z=radius
+        int particleIndex;  // 粒子在布料中的索引 (-1 表示靜態物體或已移除的粒子)
+        std::shared_ptr<TriangleMeshCollider> mesh;  // 三角形網格 (僅 MESH)
+
+        CollisionObject(Type t, const glm::vec3& c, const glm::vec3& s, int index = -1)
+            : type(t), center(c), size(s), particleIndex(index) {}
+    };
+
+    std::vector<CollisionObject> m_staticObjects;
+    std::vector<CollisionObject> m_particles;     // 句柄即索引
+    std::vector<std::vector<OGCContact>> m_blockContacts;  // 每個粒子區塊的接觸緩衝
+
+    bool checkCollision(const CollisionObject& sphere, const CollisionObject& other, OGCContact& contact) const;
+    bool checkSphereCylinderCollision(const CollisionObject& sphere, const CollisionObject& cylinder,
+                                      OGCContact& contact) const;
+    bool checkSphereBoxCollision(const CollisionObject& sphere, const CollisionObject& box,
+                                 OGCContact& contact) const;
+};
+
+} // namespace Physics
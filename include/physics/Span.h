@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace Physics {
+
+/**
+ * @brief 連續記憶體的非擁有視圖 (C++17 下的 std::span 替代)
+ *
+ * 只保存指標與長度，複製成本為常數。視圖在來源容器重新配置前有效；
+ * 模擬提供的視圖在下一次 update、reset 或拓撲改變前有效。
+ */
+template <typename T>
+class Span {
+public:
+    Span() : m_data(nullptr), m_size(0) {}
+    Span(T* data, size_t size) : m_data(data), m_size(size) {}
+
+    /**
+     * @brief 從具有 data() 與 size() 的連續容器構造 (例如 std::vector)
+     */
+    template <typename Container, typename = typename std::enable_if<
+        std::is_convertible<decltype(std::declval<Container&>().data()), T*>::value>::type>
+    Span(Container& container) : m_data(container.data()), m_size(container.size()) {}
+
+    T* data() const { return m_data; }
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    T* begin() const { return m_data; }
+    T* end() const { return m_data + m_size; }
+    T& operator[](size_t index) const { return m_data[index]; }
+
+private:
+    T* m_data;
+    size_t m_size;
+};
+
+} // namespace Physics
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+namespace Physics {
+
+/**
+ * @brief 增量排序掃掠 (sort-and-sweep) 寬相
+ *
+ * 物件分兩類 (探針與碰撞體)，只報告跨類的 AABB 重疊對。端點沿 X 軸排序並跨幀
+ * 保留：每幀只更新端點值再做插入排序，物件移動不大時接近已排序，成本約為
+ * O(n + 交換次數)。掃掠時維護兩類的活躍集，探針的起點只與活躍碰撞體比較 Y/Z，
+ * 反之亦然。相同值以 (值, 起點先於終點, 物件編號) 決定順序，結果與更新歷史無關。
+ */
+class SweepAndPrune {
+public:
+    /**
+     * @brief 重疊對 (探針編號, 碰撞體編號)
+     */
+    struct Pair {
+        int probe;
+        int collider;
+    };
+
+    SweepAndPrune() = default;
+    ~SweepAndPrune() = default;
+
+    /**
+     * @brief 設定兩類物件的數量 (數量改變時重建端點)
+     * @param probeCount 探針數
+     * @param colliderCount 碰撞體數
+     */
+    void resize(int probeCount, int colliderCount);
+
+    /**
+     * @brief 設定探針的 AABB
+     */
+    void setProbeBounds(int probe, const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
+        m_boundsMin[probe] = boundsMin;
+        m_boundsMax[probe] = boundsMax;
+    }
+
+    /**
+     * @brief 設定碰撞體的 AABB (無界碰撞體可用 ±FLT_MAX)
+     */
+    void setColliderBounds(int collider, const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
+        m_boundsMin[m_probeCount + collider] = boundsMin;
+        m_boundsMax[m_probeCount + collider] = boundsMax;
+    }
+
+    /**
+     * @brief 以插入排序更新端點順序並掃掠出所有跨類重疊對
+     * @param pairs 輸出重疊對 (先清空，保留容量)
+     */
+    void update(std::vector<Pair>& pairs);
+
+    /**
+     * @brief 最近一次 update 插入排序的交換次數
+     */
+    int getSwapCount() const { return m_swapCount; }
+
+private:
+    /**
+     * @brief X 軸端點
+     */
+    struct Endpoint {
+        float value;
+        uint32_t key;   // 物件編號 * 2 + (0: 起點, 1: 終點)
+    };
+
+    int m_probeCount = 0;
+    int m_colliderCount = 0;
+    int m_swapCount = 0;
+    std::vector<glm::vec3> m_boundsMin;     // 探針在前，碰撞體在後
+    std::vector<glm::vec3> m_boundsMax;
+    std::vector<Endpoint> m_endpoints;      // 跨幀保留的排序端點
+    std::vector<int> m_activeProbes;
+    std::vector<int> m_activeColliders;
+    std::vector<int> m_activeSlot;          // 每個物件在其活躍集中的位置
+
+    static bool precedes(const Endpoint& a, const Endpoint& b) {
+        if (a.value != b.value) return a.value < b.value;
+        if ((a.key & 1u) != (b.key & 1u)) return (a.key & 1u) < (b.key & 1u);
+        return a.key < b.key;
+    }
+
+    /**
+     * @brief 兩個物件的 AABB 在 Y/Z 上是否重疊
+     */
+    bool overlapsYZ(int a, int b) const {
+        return m_boundsMin[a].y <= m_boundsMax[b].y && m_boundsMin[b].y <= m_boundsMax[a].y &&
+               m_boundsMin[a].z <= m_boundsMax[b].z && m_boundsMin[b].z <= m_boundsMax[a].z;
+    }
+};
+
+} // namespace Physics
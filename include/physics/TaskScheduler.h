@@ -0,0 +1,241 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Physics {
+
+class TaskGroup;
+
+/**
+ * @brief 排程器的最小工作單位 (侵入式，不擁有數據，提交後須存活到所屬群組 wait 返回)
+ */
+struct Task {
+    using ExecuteFn = void (*)(void* data);
+
+    ExecuteFn execute = nullptr;
+    void* data = nullptr;
+    TaskGroup* group = nullptr;     // 由 TaskGroup::run 設置
+};
+
+/**
+ * @brief 工作執行緒池設定
+ *
+ * 不支援 NUMA 節點配置 (建置不依賴 libnuma)；需要時可用 firstCore 把執行緒綁在同一節點的核心上。
+ */
+struct SchedulerSettings {
+    int workerCount;        // 工作執行緒數 (不含提交任務的執行緒)
+    bool pinThreads;        // 把工作執行緒 i 綁定到邏輯核心 firstCore + i (僅 Linux)
+    int firstCore;          // 綁定的起始核心
+
+    SchedulerSettings(int workers = 0, bool pin = false, int core = 1)
+        : workerCount(workers), pinThreads(pin), firstCore(core) {}
+};
+
+/**
+ * @brief 工作竊取排程器
+ *
+ * 每個工作執行緒有自己的雙端佇列：自己從尾端取 (LIFO，快取熱)，空閒時從其他
+ * 佇列的前端竊取 (FIFO，取最早、通常最大的工作)。非工作執行緒提交的任務進入
+ * 共用的注入佇列。沒有工作時執行緒在條件變數上休眠，不佔用處理器。
+ *
+ * 執行緒池跨呼叫常駐，parallelFor 等各模擬階段共用同一組執行緒，
+ * 不再每次呼叫建立與回收執行緒。
+ */
+class TaskScheduler {
+public:
+    static constexpr int kMaxWorkers = 255;
+
+    TaskScheduler();
+    ~TaskScheduler();
+
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+    /**
+     * @brief 全域排程器 (第一次使用時建立，工作執行緒按需增加)
+     */
+    static TaskScheduler& instance();
+
+    /**
+     * @brief 邏輯核心數 (無法取得時為 1)
+     */
+    static int hardwareThreadCount();
+
+    /**
+     * @brief 以新設定重建執行緒池 (只能在沒有任務執行時呼叫)
+     * @param settings 執行緒池設定
+     */
+    void configure(const SchedulerSettings& settings);
+
+    /**
+     * @brief 確保至少有指定數量的工作執行緒
+     * @param workerCount 工作執行緒數 (上限 kMaxWorkers)
+     */
+    void reserveWorkers(int workerCount);
+
+    int getWorkerCount() const { return m_workerCount.load(std::memory_order_acquire); }
+    const SchedulerSettings& getSettings() const { return m_settings; }
+
+private:
+    friend class TaskGroup;
+
+    /**
+     * @brief 帶鎖的雙端佇列 (擁有者取尾端，竊取者取前端)
+     *
+     * 以環形緩衝實現，容量只在排隊任務數創新高時加倍；std::deque 在兩端
+     * 推入與取出時會反覆配置與釋放區塊，穩態下仍會觸發堆積配置。
+     */
+    struct WorkQueue {
+        std::mutex mutex;
+        std::vector<Task*> slots;   // 容量為 2 的冪
+        size_t head = 0;            // 前端位置
+        size_t count = 0;           // 排隊任務數
+
+        bool empty() const { return count == 0; }
+        Task* back() const { return slots[(head + count - 1) & (slots.size() - 1)]; }
+        void pushBack(Task* task);
+        Task* popBack();
+        Task* popFront();
+    };
+
+    std::array<std::unique_ptr<WorkQueue>, kMaxWorkers + 1> m_queues;  // 最後一個為注入佇列
+    std::vector<std::thread> m_workers;
+    std::atomic<int> m_workerCount;
+    std::atomic<int> m_queuedTasks;
+    std::atomic<int> m_sleepingWorkers;
+    std::atomic<bool> m_stopping;
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+    std::mutex m_configMutex;
+    SchedulerSettings m_settings;
+
+    /**
+     * @brief 把任務放入當前執行緒的佇列 (非工作執行緒放入注入佇列)
+     */
+    void submit(Task& task);
+
+    /**
+     * @brief 若當前執行緒佇列尾端是指定群組的任務，取出並執行
+     * @return 是否執行了任務
+     */
+    bool runOwnTask(TaskGroup& group);
+
+    /**
+     * @brief 從其他佇列前端竊取任務
+     * @param thief 竊取者的佇列索引
+     */
+    Task* steal(int thief);
+
+    void execute(Task* task);
+    void workerLoop(int index);
+    void startWorkers(int workerCount);
+    void stopWorkers();
+    int currentQueue() const;
+};
+
+/**
+ * @brief 任務群組：提交一組任務並等待全部完成
+ *
+ * wait 期間等待的執行緒會取回自己佇列中尚未被竊取的同組任務直接執行，
+ * 但不執行其他群組的任務，因此巢狀的平行迴圈不會在等待時重入無關的工作。
+ */
+class TaskGroup {
+public:
+    explicit TaskGroup(TaskScheduler& scheduler = TaskScheduler::instance())
+        : m_scheduler(scheduler), m_pending(0), m_waiting(false) {}
+
+    ~TaskGroup() { wait(); }
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    /**
+     * @brief 提交任務 (任務物件須存活到 wait 返回)
+     */
+    void run(Task& task);
+
+    /**
+     * @brief 等待所有已提交的任務完成
+     *
+     * 先執行自己佇列中尚未被竊取的任務並短暫自旋；剩下的任務都在其他執行緒上
+     * 執行時，在條件變數上休眠到最後一個任務完成，不佔用處理器。
+     */
+    void wait();
+
+    TaskScheduler& getScheduler() { return m_scheduler; }
+
+private:
+    friend class TaskScheduler;
+
+    TaskScheduler& m_scheduler;
+    std::atomic<int> m_pending;
+    std::mutex m_mutex;
+    std::condition_variable m_done;
+    bool m_waiting;                 // 等待者是否在 m_done 上休眠 (受 m_mutex 保護)
+
+    /**
+     * @brief 一個任務完成 (由執行任務的執行緒呼叫)
+     */
+    void finishTask();
+};
+
+/**
+ * @brief 任務依賴圖
+ *
+ * 節點在所有前驅完成後才提交給排程器，無依賴關係的節點可以同時執行
+ * (例如多塊布料的更新，或與上一步狀態對撞的寬相與本步的力計算)。
+ * 圖建立一次後可重複執行，每次 run 重置各節點的剩餘前驅數。
+ */
+class TaskGraph {
+public:
+    using NodeFn = std::function<void()>;
+
+    TaskGraph() = default;
+    ~TaskGraph() = default;
+
+    /**
+     * @brief 新增節點
+     * @return 節點編號
+     */
+    int addNode(NodeFn fn);
+
+    /**
+     * @brief 新增依賴：after 在 before 完成後才執行
+     */
+    void addDependency(int before, int after);
+
+    /**
+     * @brief 執行整張圖並等待完成
+     * @param scheduler 使用的排程器
+     */
+    void run(TaskScheduler& scheduler = TaskScheduler::instance());
+
+    int getNodeCount() const { return static_cast<int>(m_nodes.size()); }
+
+private:
+    /**
+     * @brief 圖節點 (作為任務的數據)
+     */
+    struct Node {
+        TaskGraph* graph = nullptr;
+        NodeFn fn;
+        std::vector<int> successors;
+        int predecessorCount = 0;
+        std::atomic<int> remaining{0};
+        Task task;
+    };
+
+    std::vector<std::unique_ptr<Node>> m_nodes;
+    TaskGroup* m_group = nullptr;   // 執行期間的群組
+
+    static void executeNode(void* data);
+};
+
+} // namespace Physics
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <vector>
+#include <glm/glm.hpp>
+#include "physics/OGCContactModel.h"
+
+namespace Physics {
+
+/**
+ * @brief 靜態三角形網格碰撞體
+ *
+ * 載入時以分箱 SAH 建立一次 BVH，之後每個粒子做最近點查詢。
+ * 每個粒子記住上一幀命中的三角形，查詢時先以它的距離作為初始搜尋半徑，
+ * 布料連續運動時大多數子樹可直接剔除 (時間一致性)。
+ * 網格以逆時針為外側；粒子位於最近面背側時視為已穿入網格並沿面法線推出。
+ */
+class TriangleMeshCollider {
+public:
+    /**
+     * @brief 構造函數 (建立 BVH)
+     * @param vertices 網格頂點 (碰撞座標)
+     * @param triangles 三角形頂點索引 (逆時針為外側)
+     */
+    TriangleMeshCollider(const std::vector<glm::vec3>& vertices, const std::vector<glm::ivec3>& triangles);
+
+    ~TriangleMeshCollider() = default;
+
+    /**
+     * @brief 最近點查詢
+     * @param position 查詢位置
+     * @param maxDistance 最大搜尋距離
+     * @param triangleHint 初始猜測的三角形 (-1 表示無)；輸出命中的三角形
+     * @param closest 輸出最近點
+     * @return 是否在最大搜尋距離內找到三角形
+     */
+    bool closestPoint(const glm::vec3& position, float maxDistance, int& triangleHint, glm::vec3& closest) const;
+
+    /**
+     * @brief 預先配置粒子命中快取
+     *
+     * 平行呼叫 generateContact 前必須先配置，之後每個粒子只寫自己的槽位。
+     *
+     * @param particleCount 粒子索引上限
+     */
+    void reserveHints(int particleCount);
+
+    /**
+     * @brief 為粒子產生接觸 (使用並更新該粒子的上一幀命中三角形)
+     * @param particleIndex 粒子索引
+     * @param position 粒子位置
+     * @param radius 粒子半徑
+     * @param contact 輸出接觸
+     * @return 是否接觸
+     */
+    bool generateContact(int particleIndex, const glm::vec3& position, float radius, OGCContact& contact);
+
+    /**
+     * @brief 點到網格的無號距離
+     * @param position 查詢位置
+     * @return 距離
+     */
+    float distance(const glm::vec3& position) const;
+
+    size_t getTriangleCount() const { return m_triangles.size(); }
+    size_t getNodeCount() const { return m_nodes.size(); }
+
+private:
+    /**
+     * @brief BVH 節點
+     */
+    struct Node {
+        glm::vec3 boundsMin;    // 包圍盒最小點
+        glm::vec3 boundsMax;    // 包圍盒最大點
+        int first;              // 內部節點：左子節點索引 (右子節點為 first + 1)；葉節點：首個三角形位置
+        int count;              // 葉節點三角形數 (0 表示內部節點)
+    };
+
+    std::vector<glm::vec3> m_vertices;
+    std::vector<glm::ivec3> m_triangles;        // 按 BVH 葉節點順序重排的三角形
+    std::vector<glm::vec3> m_faceNormals;       // 單位面法線
+    std::vector<Node> m_nodes;
+    std::vector<int> m_triangleHints;           // 每個粒子上一幀命中的三角形
+
+    /**
+     * @brief 以分箱 SAH 建立 BVH
+     */
+    void build();
+
+    /**
+     * @brief 點到三角形的最近點
+     * @return 距離平方
+     */
+    float closestOnTriangle(int triangle, const glm::vec3& position, glm::vec3& closest) const;
+};
+
+} // namespace Physics
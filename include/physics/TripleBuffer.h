@@ -0,0 +1,69 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace Physics {
+
+/**
+ * @brief 單寫者單讀者的無鎖三重緩衝
+ *
+ * 三個槽位分別由寫者 (後緩衝)、讀者 (前緩衝) 與交換區 (中間緩衝) 持有。
+ * 寫者填好後緩衝後呼叫 publish()，以一次原子交換把它與中間緩衝對調並設置
+ * 新數據標記；讀者呼叫 acquire() 時若標記存在，同樣以一次原子交換取得最新槽位。
+ * 雙方都不等待對方：寫者永遠有可寫的槽位，讀者永遠持有完整的快照，
+ * 寫得比讀快時中間的舊快照直接被覆蓋。
+ *
+ * 槽位跨發布重複使用，T 內的容器保留容量，穩定後不再配置記憶體。
+ */
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() : m_middle(1), m_back(0), m_front(2) {}
+    ~TripleBuffer() = default;
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    /**
+     * @brief 寫者的後緩衝 (只由寫者執行緒存取)
+     */
+    T& back() { return m_slots[m_back]; }
+
+    /**
+     * @brief 發布後緩衝，並取得新的後緩衝
+     */
+    void publish() {
+        uint8_t previous = m_middle.exchange(static_cast<uint8_t>(m_back | kDirty), std::memory_order_acq_rel);
+        m_back = previous & kIndexMask;
+    }
+
+    /**
+     * @brief 讀者取得最新發布的快照 (沒有新發布時返回上一次的快照)
+     * @return 前緩衝 (只由讀者執行緒存取，直到下一次 acquire)
+     */
+    const T& acquire() {
+        if (m_middle.load(std::memory_order_relaxed) & kDirty) {
+            uint8_t previous = m_middle.exchange(m_front, std::memory_order_acq_rel);
+            m_front = previous & kIndexMask;
+        }
+        return m_slots[m_front];
+    }
+
+    /**
+     * @brief 是否有讀者尚未取得的新快照
+     */
+    bool hasUpdate() const { return (m_middle.load(std::memory_order_relaxed) & kDirty) != 0; }
+
+private:
+    static constexpr uint8_t kDirty = 0x4;
+    static constexpr uint8_t kIndexMask = 0x3;
+
+    std::array<T, 3> m_slots;
+    std::atomic<uint8_t> m_middle;  // 中間緩衝索引 | 新數據標記
+    uint8_t m_back;                 // 寫者私有
+    uint8_t m_front;                // 讀者私有
+};
+
+} // namespace Physics
@@ -7,10 +7,12 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <vector>
 #include <memory>
+#include <cstdint>
+#include "physics/Precision.h"
+#include "physics/Span.h"
 
 // 前向聲明
 namespace Physics {
-    class Particle;
     struct OGCContact;
 }
 
@@ -81,6 +83,27 @@ public:
     void renderClothConstraints(const std::vector<::Physics::Particle*>& particles,
                                const std::vector<std::pair<int, int>>& constraints);
 
+    /**
+     * @brief 按連續位置視圖渲染布料粒子
+     * @param positions 粒子位置 (例如 ClothSimulation::getPositions 或快照)
+     */
+    void renderClothParticles(::Physics::Span<const glm::vec3> positions);
+
+    /**
+     * @brief 按連續位置與邊索引緩衝渲染布料約束 (單次繪製)
+     *
+     * 位置每幀整批上傳；邊索引只在拓撲版本改變時重新上傳。
+     *
+     * @param positions 粒子位置
+     * @param edgeIndices 扁平的邊索引對 (例如 ClothSimulation::getEdgeIndices)
+     * @param topologyVersion 拓撲版本 (kUncachedTopology 表示每次都上傳索引)
+     */
+    void renderClothConstraints(::Physics::Span<const glm::vec3> positions,
+                               ::Physics::Span<const uint32_t> edgeIndices,
+                               uint64_t topologyVersion);
+
+    static constexpr uint64_t kUncachedTopology = ~uint64_t(0);
+
     /**
      * @brief 渲染圓柱體
      * @param center 圓柱體中心
@@ -145,7 +168,12 @@ private:
     GLuint m_sphereVAO, m_sphereVBO, m_sphereEBO;
     GLuint m_cylinderVAO, m_cylinderVBO, m_cylinderEBO;
     GLuint m_floorVAO, m_floorVBO, m_floorEBO;
-    GLuint m_lineVAO, m_lineVBO;
+    GLuint m_lineVAO, m_lineVBO, m_lineEBO;
+    
+    // 已上傳的邊索引緩衝
+    uint64_t m_edgeTopologyVersion;
+    size_t m_edgeIndexCount;
+    uint32_t m_edgeMaxIndex;
     
     // 幾何數據
     std::vector<float> m_sphereVertices;
@@ -2,11 +2,16 @@
 #include <memory>
 #include <chrono>
 #include <thread>
+#include <atomic>
+#include <exception>
 #include <vector>
+#include <string>
 
 #include "rendering/OpenGLRenderer.h"
 #include "physics/ClothSimulation.h"
 #include "physics/Particle.h"
+#include "physics/TripleBuffer.h"
+#include "physics/FramePacer.h"
 
 /**
  * @brief OGC 布料模擬主程序
@@ -14,8 +19,21 @@
  * 展示布料從高處掉落到圓柱體，然後落到地板的完整物理過程。
  * 使用 OGC Contact Model 進行精確的接觸檢測和力計算。
  * 可視化接觸點、接觸法線和接觸力的大小與方向。
+ *
+ * 物理模擬在獨立執行緒上以固定時間步長運行，每次步進後把位置與接觸寫入
+ * 三重緩衝的快照；渲染執行緒只讀取最新快照，兩者互不等待。
  */
 
+/**
+ * @brief 物理執行緒發布給渲染器的不可變快照
+ */
+struct SimulationSnapshot {
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> edgeIndices;      // 只在拓撲版本改變時複製
+    uint64_t topologyVersion = 0;
+    std::vector<Physics::OGCContact> contacts;
+};
+
 class ClothSimulationApp {
 public:
     ClothSimulationApp() 
@@ -26,8 +44,7 @@ public:
         , m_showWireframe(true)
         , m_showParticles(true)
         , m_showContacts(true)
-        , m_timeAccumulator(0.0f)
-        , m_fixedTimeStep(1.0f / 60.0f)
+        , m_pacer(1.0 / 60.0, 4)
     {
     }
 
@@ -35,7 +52,7 @@ public:
         cleanup();
     }
 
-    bool initialize() {
+    bool initialize(const std::string& collisionBackend = "") {
         std::cout << "=== OGC 布料模擬程序 ===" << std::endl;
         std::cout << "初始化渲染器..." << std::endl;
         
@@ -50,6 +67,9 @@ public:
         
         // 創建布料模擬
         m_clothSimulation = std::make_unique<Physics::ClothSimulation>();
+        if (!m_clothSimulation->setCollisionBackend(collisionBackend)) {
+            return false;
+        }
         if (!m_clothSimulation->initialize(20, 20, glm::vec2(2.0f, 2.0f), glm::vec3(0.0f, 3.0f, 0.0f))) {
             std::cerr << "Failed to initialize cloth simulation" << std::endl;
             return false;
@@ -84,38 +104,131 @@ public:
         }
         
         m_isRunning = true;
-        auto lastTime = std::chrono::high_resolution_clock::now();
+        
+        // 初始狀態先發布一次，渲染器第一幀即有快照；之後模擬只由物理執行緒存取
+        publishSnapshot();
+        m_physicsThread = std::thread(&ClothSimulationApp::physicsLoop, this);
         
         std::cout << "開始模擬..." << std::endl;
         
+        auto lastFrame = std::chrono::steady_clock::now();
+        auto lastReport = lastFrame;
         while (m_isRunning && !m_renderer->shouldClose()) {
-            auto currentTime = std::chrono::high_resolution_clock::now();
-            float deltaTime = std::chrono::duration<float>(currentTime - lastTime).count();
-            lastTime = currentTime;
-            
             // 處理輸入
             processInput();
             
-            // 更新物理模擬 (固定時間步長)
-            if (!m_isPaused) {
-                m_timeAccumulator += deltaTime;
-                while (m_timeAccumulator >= m_fixedTimeStep) {
-                    m_clothSimulation->update(m_fixedTimeStep);
-                    m_timeAccumulator -= m_fixedTimeStep;
-                }
-            }
-            
-            // 渲染
-            render();
+            // 渲染最新快照 (由垂直同步限速)
+            render(m_snapshots.acquire());
             
-            // 限制幀率
-            std::this_thread::sleep_for(std::chrono::milliseconds(16)); // ~60 FPS
+            auto currentFrame = std::chrono::steady_clock::now();
+            m_frameStats.record(std::chrono::duration<double>(currentFrame - lastFrame).count());
+            lastFrame = currentFrame;
+            if (currentFrame - lastReport >= kReportInterval) {
+                printStats("渲染幀", m_frameStats.summarize());
+                lastReport = currentFrame;
+            }
+        }
+        
+        stopPhysicsThread();
+        if (m_physicsError) {
+            std::rethrow_exception(m_physicsError);
         }
         
         std::cout << "模擬結束" << std::endl;
     }
 
 private:
+    /**
+     * @brief 物理執行緒：固定時間步長推進模擬並發布快照
+     */
+    void physicsLoop() {
+        try {
+            auto lastTime = std::chrono::steady_clock::now();
+            auto lastReport = lastTime;
+            const int maxIterations = m_clothSimulation->getConstraintIterations();
+            const float timeStep = static_cast<float>(m_pacer.getFixedTimeStep());
+            
+            while (m_isRunning) {
+                auto currentTime = std::chrono::steady_clock::now();
+                double deltaTime = std::chrono::duration<double>(currentTime - lastTime).count();
+                lastTime = currentTime;
+                
+                if (m_isPaused) {
+                    // 暫停時仍在步邊界執行場景編輯，讓重置等操作立即可見
+                    if (m_clothSimulation->applyCommands() > 0) {
+                        publishSnapshot();
+                    }
+                    m_pacer.resetAccumulator();
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    continue;
+                }
+                
+                // 更新物理模擬 (固定時間步長，每幀子步數有上限，超出的時間丟棄)
+                int substeps = m_pacer.advance(deltaTime);
+                for (int step = 0; step < substeps; ++step) {
+                    auto stepStart = std::chrono::steady_clock::now();
+                    m_clothSimulation->update(timeStep);
+                    m_pacer.recordStepCost(std::chrono::duration<double>(std::chrono::steady_clock::now() - stepStart).count());
+                }
+                
+                if (substeps > 0) {
+                    // 超出預算時先降低約束迭代數，而不是讓子步落後
+                    int iterations = m_clothSimulation->getConstraintIterations();
+                    m_clothSimulation->setConstraintIterations(m_pacer.adjustIterations(iterations, 1, maxIterations));
+                    publishSnapshot();
+                } else {
+                    // 只睡到下一步到期
+                    std::this_thread::sleep_for(std::chrono::duration<double>(m_pacer.timeUntilNextStep()));
+                }
+                
+                if (currentTime - lastReport >= kReportInterval) {
+                    printStats("物理步", m_pacer.getStepStats().summarize());
+                    std::cout << "  約束迭代: " << m_clothSimulation->getConstraintIterations()
+                              << ", 觸及子步上限: " << m_pacer.getCappedFrameCount()
+                              << " 次, 丟棄時間: " << m_pacer.getDroppedTime() << " s" << std::endl;
+                    lastReport = currentTime;
+                }
+            }
+        } catch (...) {
+            m_physicsError = std::current_exception();
+            m_isRunning = false;
+        }
+    }
+    
+    /**
+     * @brief 把當前模擬狀態寫入後緩衝並發布 (只由持有模擬的執行緒呼叫)
+     */
+    void publishSnapshot() {
+        SimulationSnapshot& snapshot = m_snapshots.back();
+        
+        auto positions = m_clothSimulation->getPositions();
+        snapshot.positions.assign(positions.begin(), positions.end());
+        
+        uint64_t topologyVersion = m_clothSimulation->getTopologyVersion();
+        if (snapshot.topologyVersion != topologyVersion || snapshot.edgeIndices.empty()) {
+            auto edgeIndices = m_clothSimulation->getEdgeIndices();
+            snapshot.edgeIndices.assign(edgeIndices.begin(), edgeIndices.end());
+            snapshot.topologyVersion = topologyVersion;
+        }
+        
+        snapshot.contacts = m_clothSimulation->getContacts();
+        m_snapshots.publish();
+    }
+    
+    static void printStats(const char* label, const Physics::FrameTimeStats::Summary& summary) {
+        std::cout << label << " (ms) p50: " << summary.p50 * 1000.0
+                  << ", p95: " << summary.p95 * 1000.0
+                  << ", p99: " << summary.p99 * 1000.0
+                  << ", max: " << summary.max * 1000.0 << std::endl;
+    }
+    
+    void stopPhysicsThread() {
+        m_isRunning = false;
+        if (m_physicsThread.joinable()) {
+            m_physicsThread.join();
+        }
+    }
+
     void processInput() {
         m_renderer->processInput();
         
@@ -125,7 +238,7 @@ private:
         // 暫停/繼續
         static bool spacePressed = false;
         if (glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS && !spacePressed) {
-            m_isPaused = !m_isPaused;
+            m_isPaused = !m_isPaused.load();
             std::cout << (m_isPaused ? "模擬暫停" : "模擬繼續") << std::endl;
             spacePressed = true;
         } else if (glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_RELEASE) {
@@ -135,7 +248,9 @@ private:
         // 重置場景
         static bool rPressed = false;
         if (glfwGetKey(window, GLFW_KEY_R) == GLFW_PRESS && !rPressed) {
-            m_clothSimulation->reset();
+            m_clothSimulation->enqueueCommand([](Physics::ClothSimulation& simulation) {
+                simulation.reset();
+            });
             std::cout << "場景重置" << std::endl;
             rPressed = true;
         } else if (glfwGetKey(window, GLFW_KEY_R) == GLFW_RELEASE) {
@@ -178,35 +293,17 @@ private:
         }
     }
 
-    void render() {
+    void render(const SimulationSnapshot& snapshot) {
         m_renderer->beginFrame();
         
         // 渲染布料粒子
         if (m_showParticles) {
-            const auto& particles = m_clothSimulation->getParticles();
-            std::vector<Physics::Particle*> particlePtrs;
-            for (const auto& particle : particles) {
-                particlePtrs.push_back(particle.get());
-            }
-            m_renderer->renderClothParticles(particlePtrs);
+            m_renderer->renderClothParticles(snapshot.positions);
         }
         
         // 渲染布料約束 (線框)
         if (m_showWireframe) {
-            const auto& particles = m_clothSimulation->getParticles();
-            const auto& constraints = m_clothSimulation->getConstraints();
-            
-            std::vector<Physics::Particle*> particlePtrs;
-            for (const auto& particle : particles) {
-                particlePtrs.push_back(particle.get());
-            }
-            
-            std::vector<std::pair<int, int>> constraintPairs;
-            for (const auto& constraint : constraints) {
-                constraintPairs.emplace_back(constraint.particleA, constraint.particleB);
-            }
-            
-            m_renderer->renderClothConstraints(particlePtrs, constraintPairs);
+            m_renderer->renderClothConstraints(snapshot.positions, snapshot.edgeIndices, snapshot.topologyVersion);
         }
         
         // 渲染碰撞體
@@ -215,14 +312,14 @@ private:
         
         // 渲染接觸點和接觸力
         if (m_showContacts) {
-            const auto& contacts = m_clothSimulation->getContacts();
-            m_renderer->renderContacts(contacts);
+            m_renderer->renderContacts(snapshot.contacts);
         }
         
         m_renderer->endFrame();
     }
 
     void cleanup() {
+        stopPhysicsThread();
         m_clothSimulation.reset();
         m_renderer.reset();
     }
@@ -246,21 +343,35 @@ private:
     std::unique_ptr<Rendering::OpenGLRenderer> m_renderer;
     std::unique_ptr<Physics::ClothSimulation> m_clothSimulation;
     
-    bool m_isRunning;
-    bool m_isPaused;
+    std::atomic<bool> m_isRunning;
+    std::atomic<bool> m_isPaused;
     bool m_showWireframe;
     bool m_showParticles;
     bool m_showContacts;
     
-    float m_timeAccumulator;
-    float m_fixedTimeStep;
+    Physics::FramePacer m_pacer;            // 只由物理執行緒存取
+    Physics::FrameTimeStats m_frameStats;   // 只由渲染執行緒存取
+    
+    static constexpr std::chrono::seconds kReportInterval{5};
+    
+    std::thread m_physicsThread;
+    std::exception_ptr m_physicsError;      // 物理執行緒的異常，在 run 結束時重新拋出
+    Physics::TripleBuffer<SimulationSnapshot> m_snapshots;
 };
 
-int main() {
+int main(int argc, char** argv) {
     try {
+        // --backend <name> 選擇碰撞後端 (預設為已編譯的最高優先級後端)
+        std::string collisionBackend;
+        for (int i = 1; i + 1 < argc; ++i) {
+            if (std::string(argv[i]) == "--backend") {
+                collisionBackend = argv[++i];
+            }
+        }
+        
         ClothSimulationApp app;
         
-        if (!app.initialize()) {
+        if (!app.initialize(collisionBackend)) {
             std::cerr << "Failed to initialize application" << std::endl;
             return -1;
         }
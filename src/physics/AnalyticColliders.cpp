@@ -0,0 +1,461 @@
+#include "physics/AnalyticColliders.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Physics {
+
+namespace {
+
+// 每組粒子數 (SIMD 通道數)
+constexpr int kLaneCount = 8;
+
+// 接觸檢測時每個區塊包含的粒子數
+constexpr int kDetectBlockSize = 256;
+
+// 長度低於此值時視為退化，使用預設方向
+constexpr float kEpsilon = 1e-8f;
+
+// 寬相 AABB 額外的膨脹容差 (吸收核心與包圍盒的捨入差異)
+constexpr float kBroadphaseTolerance = 1e-3f;
+
+glm::vec3 safeNormalize(const glm::vec3& v, const glm::vec3& fallback) {
+    float length = glm::length(v);
+    return length > kEpsilon ? v / length : fallback;
+}
+
+} // namespace
+
+struct AnalyticColliders::Batch {
+    float x[kLaneCount];
+    float y[kLaneCount];
+    float z[kLaneCount];
+    float distance[kLaneCount];
+    float normalX[kLaneCount];
+    float normalY[kLaneCount];
+    float normalZ[kLaneCount];
+
+    /**
+     * @brief 載入一組位置，不足 8 個時以最後一個位置填滿剩餘通道
+     */
+    void load(const glm::vec3* positions, int width) {
+        for (int k = 0; k < kLaneCount; ++k) {
+            const glm::vec3& position = positions[std::min(k, width - 1)];
+            x[k] = position.x;
+            y[k] = position.y;
+            z[k] = position.z;
+        }
+    }
+};
+
+int AnalyticColliders::addSphere(const glm::vec3& center, float radius) {
+    Shape shape{};
+    shape.type = Type::SPHERE;
+    shape.center = center;
+    shape.radius = radius;
+    m_shapes.push_back(shape);
+    return static_cast<int>(m_shapes.size()) - 1;
+}
+
+int AnalyticColliders::addCapsule(const glm::vec3& pointA, const glm::vec3& pointB, float radius) {
+    Shape shape{};
+    shape.type = Type::CAPSULE;
+    shape.center = (pointA + pointB) * 0.5f;
+    shape.axisY = safeNormalize(pointB - pointA, glm::vec3(0.0f, 1.0f, 0.0f));
+    shape.halfExtents = glm::vec3(0.0f, glm::length(pointB - pointA) * 0.5f, 0.0f);
+    shape.radius = radius;
+    m_shapes.push_back(shape);
+    return static_cast<int>(m_shapes.size()) - 1;
+}
+
+int AnalyticColliders::addOrientedBox(const glm::vec3& center, const glm::vec3& halfExtents,
+                                      const glm::mat3& rotation) {
+    int collider = addRoundedBox(center, halfExtents, rotation, 0.0f);
+    m_shapes.back().type = Type::ORIENTED_BOX;
+    return collider;
+}
+
+int AnalyticColliders::addRoundedBox(const glm::vec3& center, const glm::vec3& halfExtents,
+                                     const glm::mat3& rotation, float roundingRadius) {
+    Shape shape{};
+    shape.type = Type::ROUNDED_BOX;
+    shape.center = center;
+    shape.axisX = safeNormalize(rotation[0], glm::vec3(1.0f, 0.0f, 0.0f));
+    shape.axisY = safeNormalize(rotation[1], glm::vec3(0.0f, 1.0f, 0.0f));
+    shape.axisZ = safeNormalize(rotation[2], glm::vec3(0.0f, 0.0f, 1.0f));
+    shape.halfExtents = halfExtents;
+    shape.radius = std::min(roundingRadius, std::min(halfExtents.x, std::min(halfExtents.y, halfExtents.z)));
+    m_shapes.push_back(shape);
+    return static_cast<int>(m_shapes.size()) - 1;
+}
+
+int AnalyticColliders::addTorus(const glm::vec3& center, const glm::vec3& axis, float majorRadius,
+                                float minorRadius) {
+    Shape shape{};
+    shape.type = Type::TORUS;
+    shape.center = center;
+    shape.axisY = safeNormalize(axis, glm::vec3(0.0f, 1.0f, 0.0f));
+
+    // 任選與對稱軸正交的 x 軸
+    glm::vec3 reference = std::abs(shape.axisY.x) < 0.9f ? glm::vec3(1.0f, 0.0f, 0.0f) : glm::vec3(0.0f, 0.0f, 1.0f);
+    shape.axisZ = glm::normalize(glm::cross(reference, shape.axisY));
+    shape.axisX = glm::cross(shape.axisY, shape.axisZ);
+    shape.majorRadius = majorRadius;
+    shape.radius = minorRadius;
+    m_shapes.push_back(shape);
+    return static_cast<int>(m_shapes.size()) - 1;
+}
+
+int AnalyticColliders::addPlane(const glm::vec3& point, const glm::vec3& normal) {
+    Shape shape{};
+    shape.type = Type::PLANE;
+    shape.center = point;
+    shape.axisY = safeNormalize(normal, glm::vec3(0.0f, 1.0f, 0.0f));
+    m_shapes.push_back(shape);
+    return static_cast<int>(m_shapes.size()) - 1;
+}
+
+void AnalyticColliders::setTransform(int collider, const glm::vec3& center, const glm::mat3& rotation) {
+    if (collider < 0 || collider >= static_cast<int>(m_shapes.size())) return;
+
+    Shape& shape = m_shapes[collider];
+    shape.center = center;
+    shape.axisX = safeNormalize(rotation[0], glm::vec3(1.0f, 0.0f, 0.0f));
+    shape.axisY = safeNormalize(rotation[1], glm::vec3(0.0f, 1.0f, 0.0f));
+    shape.axisZ = safeNormalize(rotation[2], glm::vec3(0.0f, 0.0f, 1.0f));
+}
+
+void AnalyticColliders::setVelocity(int collider, const glm::vec3& linearVelocity,
+                                    const glm::vec3& angularVelocity) {
+    if (collider < 0 || collider >= static_cast<int>(m_shapes.size())) return;
+
+    m_shapes[collider].linearVelocity = linearVelocity;
+    m_shapes[collider].angularVelocity = angularVelocity;
+}
+
+void AnalyticColliders::shapeBounds(const Shape& shape, glm::vec3& boundsMin, glm::vec3& boundsMax) {
+    glm::vec3 extent;
+    switch (shape.type) {
+        case Type::SPHERE:
+            extent = glm::vec3(shape.radius);
+            break;
+        case Type::CAPSULE:
+            extent = glm::abs(shape.axisY) * shape.halfExtents.y + glm::vec3(shape.radius);
+            break;
+        case Type::ORIENTED_BOX:
+        case Type::ROUNDED_BOX:
+            extent = glm::abs(shape.axisX) * shape.halfExtents.x + glm::abs(shape.axisY) * shape.halfExtents.y +
+                     glm::abs(shape.axisZ) * shape.halfExtents.z;
+            break;
+        case Type::TORUS:
+            extent = glm::vec3(shape.majorRadius + shape.radius);
+            break;
+        default:
+            boundsMin = glm::vec3(-std::numeric_limits<float>::max());
+            boundsMax = glm::vec3(std::numeric_limits<float>::max());
+            return;
+    }
+    boundsMin = shape.center - extent;
+    boundsMax = shape.center + extent;
+}
+
+void AnalyticColliders::sphereKernel(const Shape& shape, Batch& batch) {
+    const glm::vec3 c = shape.center;
+    const float radius = shape.radius;
+
+    for (int k = 0; k < kLaneCount; ++k) {
+        float dx = batch.x[k] - c.x;
+        float dy = batch.y[k] - c.y;
+        float dz = batch.z[k] - c.z;
+        float length = std::sqrt(dx * dx + dy * dy + dz * dz);
+        bool valid = length > kEpsilon;
+        float inverseLength = valid ? 1.0f / length : 0.0f;
+
+        batch.distance[k] = length - radius;
+        batch.normalX[k] = dx * inverseLength;
+        batch.normalY[k] = valid ? dy * inverseLength : 1.0f;
+        batch.normalZ[k] = dz * inverseLength;
+    }
+}
+
+void AnalyticColliders::capsuleKernel(const Shape& shape, Batch& batch) {
+    const glm::vec3 c = shape.center;
+    const glm::vec3 a = shape.axisY;
+    const float halfLength = shape.halfExtents.y;
+    const float radius = shape.radius;
+
+    for (int k = 0; k < kLaneCount; ++k) {
+        float dx = batch.x[k] - c.x;
+        float dy = batch.y[k] - c.y;
+        float dz = batch.z[k] - c.z;
+
+        // 投影到線段上的最近點
+        float t = std::min(std::max(dx * a.x + dy * a.y + dz * a.z, -halfLength), halfLength);
+        dx -= a.x * t;
+        dy -= a.y * t;
+        dz -= a.z * t;
+
+        float length = std::sqrt(dx * dx + dy * dy + dz * dz);
+        bool valid = length > kEpsilon;
+        float inverseLength = valid ? 1.0f / length : 0.0f;
+
+        batch.distance[k] = length - radius;
+        batch.normalX[k] = valid ? dx * inverseLength : a.x;
+        batch.normalY[k] = valid ? dy * inverseLength : a.y;
+        batch.normalZ[k] = valid ? dz * inverseLength : a.z;
+    }
+}
+
+void AnalyticColliders::boxKernel(const Shape& shape, float roundingRadius, Batch& batch) {
+    const glm::vec3 c = shape.center;
+    const glm::vec3 ax = shape.axisX, ay = shape.axisY, az = shape.axisZ;
+    const glm::vec3 extents = shape.halfExtents - glm::vec3(roundingRadius);
+
+    for (int k = 0; k < kLaneCount; ++k) {
+        float dx = batch.x[k] - c.x;
+        float dy = batch.y[k] - c.y;
+        float dz = batch.z[k] - c.z;
+
+        // 局部座標
+        float lx = dx * ax.x + dy * ax.y + dz * ax.z;
+        float ly = dx * ay.x + dy * ay.y + dz * ay.z;
+        float lz = dx * az.x + dy * az.y + dz * az.z;
+        float sx = lx < 0.0f ? -1.0f : 1.0f;
+        float sy = ly < 0.0f ? -1.0f : 1.0f;
+        float sz = lz < 0.0f ? -1.0f : 1.0f;
+
+        float qx = std::abs(lx) - extents.x;
+        float qy = std::abs(ly) - extents.y;
+        float qz = std::abs(lz) - extents.z;
+        float ox = std::max(qx, 0.0f);
+        float oy = std::max(qy, 0.0f);
+        float oz = std::max(qz, 0.0f);
+        float outside = std::sqrt(ox * ox + oy * oy + oz * oz);
+        float inside = std::min(std::max(qx, std::max(qy, qz)), 0.0f);
+
+        // 外部：沿最近點方向；內部：沿穿透最淺的面
+        bool isOutside = outside > kEpsilon;
+        float inverseOutside = isOutside ? 1.0f / outside : 0.0f;
+        bool faceX = qx >= qy && qx >= qz;
+        bool faceY = !faceX && qy >= qz;
+        bool faceZ = !faceX && !faceY;
+        float nx = isOutside ? sx * ox * inverseOutside : (faceX ? sx : 0.0f);
+        float ny = isOutside ? sy * oy * inverseOutside : (faceY ? sy : 0.0f);
+        float nz = isOutside ? sz * oz * inverseOutside : (faceZ ? sz : 0.0f);
+
+        batch.distance[k] = outside + inside - roundingRadius;
+        batch.normalX[k] = nx * ax.x + ny * ay.x + nz * az.x;
+        batch.normalY[k] = nx * ax.y + ny * ay.y + nz * az.y;
+        batch.normalZ[k] = nx * ax.z + ny * ay.z + nz * az.z;
+    }
+}
+
+void AnalyticColliders::torusKernel(const Shape& shape, Batch& batch) {
+    const glm::vec3 c = shape.center;
+    const glm::vec3 ax = shape.axisX, ay = shape.axisY, az = shape.axisZ;
+    const float majorRadius = shape.majorRadius;
+    const float minorRadius = shape.radius;
+
+    for (int k = 0; k < kLaneCount; ++k) {
+        float dx = batch.x[k] - c.x;
+        float dy = batch.y[k] - c.y;
+        float dz = batch.z[k] - c.z;
+
+        float lx = dx * ax.x + dy * ax.y + dz * ax.z;
+        float ly = dx * ay.x + dy * ay.y + dz * ay.z;
+        float lz = dx * az.x + dy * az.y + dz * az.z;
+
+        // 在包含對稱軸的截面上，到管中心圓的距離
+        float radial = std::sqrt(lx * lx + lz * lz);
+        bool radialValid = radial > kEpsilon;
+        float inverseRadial = radialValid ? 1.0f / radial : 0.0f;
+        float rx = radialValid ? lx * inverseRadial : 1.0f;
+        float rz = lz * inverseRadial;
+
+        float qx = radial - majorRadius;
+        float length = std::sqrt(qx * qx + ly * ly);
+        bool valid = length > kEpsilon;
+        float inverseLength = valid ? 1.0f / length : 0.0f;
+        float nr = valid ? qx * inverseLength : 1.0f;
+        float ny = ly * inverseLength;
+        float nx = rx * nr;
+        float nz = rz * nr;
+
+        batch.distance[k] = length - minorRadius;
+        batch.normalX[k] = nx * ax.x + ny * ay.x + nz * az.x;
+        batch.normalY[k] = nx * ax.y + ny * ay.y + nz * az.y;
+        batch.normalZ[k] = nx * ax.z + ny * ay.z + nz * az.z;
+    }
+}
+
+void AnalyticColliders::planeKernel(const Shape& shape, Batch& batch) {
+    const glm::vec3 c = shape.center;
+    const glm::vec3 n = shape.axisY;
+
+    for (int k = 0; k < kLaneCount; ++k) {
+        batch.distance[k] = (batch.x[k] - c.x) * n.x + (batch.y[k] - c.y) * n.y + (batch.z[k] - c.z) * n.z;
+        batch.normalX[k] = n.x;
+        batch.normalY[k] = n.y;
+        batch.normalZ[k] = n.z;
+    }
+}
+
+void AnalyticColliders::evaluate(const Shape& shape, Batch& batch) {
+    switch (shape.type) {
+        case Type::SPHERE:       sphereKernel(shape, batch); break;
+        case Type::CAPSULE:      capsuleKernel(shape, batch); break;
+        case Type::ORIENTED_BOX: boxKernel(shape, 0.0f, batch); break;
+        case Type::ROUNDED_BOX:  boxKernel(shape, shape.radius, batch); break;
+        case Type::TORUS:        torusKernel(shape, batch); break;
+        case Type::PLANE:        planeKernel(shape, batch); break;
+    }
+}
+
+void AnalyticColliders::query(int collider, const glm::vec3* positions, int count, float* distances,
+                              glm::vec3* normals) const {
+    const Shape& shape = m_shapes[collider];
+    Batch batch;
+
+    for (int base = 0; base < count; base += kLaneCount) {
+        int width = std::min(kLaneCount, count - base);
+        batch.load(positions + base, width);
+        evaluate(shape, batch);
+
+        for (int k = 0; k < width; ++k) {
+            distances[base + k] = batch.distance[k];
+            normals[base + k] = glm::vec3(batch.normalX[k], batch.normalY[k], batch.normalZ[k]);
+        }
+    }
+}
+
+void AnalyticColliders::buildCandidates(const std::vector<glm::vec3>& positions, float margin,
+                                        const ParallelSettings& settings) {
+    int particleCount = static_cast<int>(positions.size());
+    int groupCount = (particleCount + kLaneCount - 1) / kLaneCount;
+    int shapeCount = static_cast<int>(m_shapes.size());
+    m_broadphase.resize(groupCount, shapeCount);
+
+    // 1. 更新 AABB：粒子組取組內粒子，碰撞體膨脹粒子半徑 (加上容差，保證不漏接觸)
+    parallelFor(groupCount, settings, [&](int begin, int end) {
+        for (int group = begin; group < end; ++group) {
+            int first = group * kLaneCount;
+            int last = std::min(first + kLaneCount, particleCount);
+            glm::vec3 boundsMin = positions[first];
+            glm::vec3 boundsMax = positions[first];
+            for (int i = first + 1; i < last; ++i) {
+                boundsMin = glm::min(boundsMin, positions[i]);
+                boundsMax = glm::max(boundsMax, positions[i]);
+            }
+            m_broadphase.setProbeBounds(group, boundsMin, boundsMax);
+        }
+    });
+
+    glm::vec3 inflation(margin + kBroadphaseTolerance);
+    for (int collider = 0; collider < shapeCount; ++collider) {
+        glm::vec3 boundsMin, boundsMax;
+        shapeBounds(m_shapes[collider], boundsMin, boundsMax);
+        if (m_shapes[collider].type != Type::PLANE) {
+            boundsMin -= inflation;
+            boundsMax += inflation;
+        }
+        m_broadphase.setColliderBounds(collider, boundsMin, boundsMax);
+    }
+
+    // 2. 增量排序掃掠
+    m_broadphase.update(m_pairs);
+
+    // 3. 按組分桶，組內按碰撞體索引遞增 (接觸順序與逐一求值所有碰撞體時相同)
+    m_groupOffsets.assign(groupCount + 1, 0);
+    for (const SweepAndPrune::Pair& pair : m_pairs) {
+        ++m_groupOffsets[pair.probe + 1];
+    }
+    for (int group = 0; group < groupCount; ++group) {
+        m_groupOffsets[group + 1] += m_groupOffsets[group];
+    }
+    m_groupColliders.resize(m_pairs.size());
+    for (const SweepAndPrune::Pair& pair : m_pairs) {
+        m_groupColliders[m_groupOffsets[pair.probe]++] = pair.collider;
+    }
+    for (int group = groupCount; group > 0; --group) {
+        m_groupOffsets[group] = m_groupOffsets[group - 1];
+    }
+    m_groupOffsets[0] = 0;
+    parallelFor(groupCount, settings, [&](int begin, int end) {
+        for (int group = begin; group < end; ++group) {
+            std::sort(m_groupColliders.begin() + m_groupOffsets[group],
+                      m_groupColliders.begin() + m_groupOffsets[group + 1]);
+        }
+    });
+}
+
+void AnalyticColliders::detect(const std::vector<glm::vec3>& positions, float particleRadius,
+                               std::vector<OGCContact>& contacts, const ParallelSettings& settings) {
+    if (m_shapes.empty() || positions.empty()) return;
+
+    buildCandidates(positions, particleRadius, settings);
+
+    int particleCount = static_cast<int>(positions.size());
+    int blockCount = (particleCount + kDetectBlockSize - 1) / kDetectBlockSize;
+    m_blockContacts.resize(blockCount);
+
+    ParallelSettings blockSettings(settings.threadCount, settings.deterministic, 1);
+    parallelFor(blockCount, blockSettings, [&](int blockBegin, int blockEnd) {
+        Batch batch;
+
+        for (int block = blockBegin; block < blockEnd; ++block) {
+            std::vector<OGCContact>& blockContacts = m_blockContacts[block];
+            blockContacts.clear();
+
+            int blockStart = block * kDetectBlockSize;
+            int blockEndIndex = std::min(blockStart + kDetectBlockSize, particleCount);
+            for (int base = blockStart; base < blockEndIndex; base += kLaneCount) {
+                int group = base / kLaneCount;
+                if (m_groupOffsets[group] == m_groupOffsets[group + 1]) continue;
+
+                int width = std::min(kLaneCount, blockEndIndex - base);
+                batch.load(positions.data() + base, width);
+
+                for (int c = m_groupOffsets[group]; c < m_groupOffsets[group + 1]; ++c) {
+                    int shapeIndex = m_groupColliders[c];
+                    const Shape& shape = m_shapes[shapeIndex];
+                    evaluate(shape, batch);
+
+                    for (int k = 0; k < width; ++k) {
+                        float distance = batch.distance[k];
+                        if (distance >= particleRadius) continue;
+
+                        glm::vec3 normal(batch.normalX[k], batch.normalY[k], batch.normalZ[k]);
+
+                        OGCContact contact;
+                        contact.particleIndexA = base + k;
+                        contact.particleIndexB = -1;
+                        contact.contactPoint = positions[base + k] - distance * normal;
+                        contact.contactNormal = normal;
+                        contact.penetrationDepth = particleRadius - distance;
+                        contact.featureId = shapeIndex;
+                        contact.colliderVelocity = shape.linearVelocity +
+                            glm::cross(shape.angularVelocity, contact.contactPoint - shape.center);
+                        blockContacts.push_back(contact);
+                    }
+                }
+            }
+        }
+    });
+
+    // 按區塊順序壓實合併
+    compactBlocks(m_blockContacts, contacts, settings);
+}
+
+float AnalyticColliders::distance(const glm::vec3& position) const {
+    float nearest = std::numeric_limits<float>::max();
+    Batch batch;
+    batch.load(&position, 1);
+
+    for (const Shape& shape : m_shapes) {
+        evaluate(shape, batch);
+        nearest = std::min(nearest, batch.distance[0]);
+    }
+    return nearest;
+}
+
+} // namespace Physics
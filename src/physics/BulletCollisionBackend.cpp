@@ -0,0 +1,247 @@
+#include "physics/BulletCollisionBackend.h"
+#include "physics/TriangleMeshCollider.h"
+#include <btBulletCollisionCommon.h>
+#include <iostream>
+#include <algorithm>
+
+namespace Physics {
+
+namespace {
+
+// 網格查詢時每個區塊包含的粒子數
+constexpr int kDetectBlockSize = 256;
+
+// 接觸流形中距離小於此值的點都輸出為接觸
+constexpr float kContactThreshold = 0.1f;
+
+// 有 Bullet 時優先於簡化後端
+const bool kRegistered = CollisionBackendRegistry::registerBackend("bullet", 10, [] {
+    return std::unique_ptr<CollisionBackend>(new BulletCollisionBackend());
+});
+
+glm::vec3 bulletToGlm(const btVector3& btVec) {
+    return glm::vec3(btVec.x(), btVec.y(), btVec.z());
+}
+
+btVector3 glmToBullet(const glm::vec3& glmVec) {
+    return btVector3(glmVec.x, glmVec.y, glmVec.z);
+}
+
+} // namespace
+
+BulletCollisionBackend::BulletCollisionBackend() {
+    // 創建碰撞配置
+    m_collisionConfig = std::make_unique<btDefaultCollisionConfiguration>();
+
+    // 創建碰撞調度器
+    m_dispatcher = std::make_unique<btCollisionDispatcher>(m_collisionConfig.get());
+
+    // 創建廣相碰撞檢測
+    m_broadphase = std::make_unique<btDbvtBroadphase>();
+
+    // 創建碰撞世界 (只用於碰撞檢測，不進行物理模擬)
+    m_collisionWorld = std::make_unique<btCollisionWorld>(
+        m_dispatcher.get(),
+        m_broadphase.get(),
+        m_collisionConfig.get()
+    );
+
+    std::cout << "Bullet Physics collision detection initialized" << std::endl;
+}
+
+BulletCollisionBackend::~BulletCollisionBackend() {
+    // 先從碰撞世界移除物件，再釋放形狀與世界
+    for (auto& obj : m_particleObjects) {
+        if (obj) m_collisionWorld->removeCollisionObject(obj.get());
+    }
+    for (auto& obj : m_staticObjects) {
+        m_collisionWorld->removeCollisionObject(obj.get());
+    }
+    m_particleObjects.clear();
+    m_staticObjects.clear();
+    m_collisionShapes.clear();
+    m_meshColliders.clear();
+
+    m_collisionWorld.reset();
+    m_broadphase.reset();
+    m_dispatcher.reset();
+    m_collisionConfig.reset();
+
+    std::cout << "Bullet Physics cleaned up" << std::endl;
+}
+
+std::unique_ptr<btCollisionObject> BulletCollisionBackend::createObject(std::unique_ptr<btCollisionShape> shape,
+                                                                        const glm::vec3& position, int userIndex) {
+    auto collisionObject = std::make_unique<btCollisionObject>();
+    collisionObject->setCollisionShape(shape.get());
+    m_collisionShapes.push_back(std::move(shape));
+
+    // 設定位置
+    btTransform transform;
+    transform.setIdentity();
+    transform.setOrigin(glmToBullet(position));
+    collisionObject->setWorldTransform(transform);
+
+    // 用戶索引為粒子索引 (-1 表示靜態物體)
+    collisionObject->setUserIndex(userIndex);
+
+    m_collisionWorld->addCollisionObject(collisionObject.get());
+    return collisionObject;
+}
+
+void BulletCollisionBackend::addCylinder(const glm::vec3& center, float radius, float height) {
+    m_staticObjects.push_back(createObject(
+        std::make_unique<btCylinderShape>(btVector3(radius, height * 0.5f, radius)), center, -1));
+    m_staticObjects.back()->setUserIndex2(static_cast<int>(m_staticObjects.size()) - 1);
+
+    std::cout << "Added cylinder: center(" << center.x << ", " << center.y << ", " << center.z
+              << "), radius=" << radius << ", height=" << height << std::endl;
+}
+
+void BulletCollisionBackend::addFloor(const glm::vec3& center, const glm::vec3& size) {
+    m_staticObjects.push_back(createObject(
+        std::make_unique<btBoxShape>(btVector3(size.x * 0.5f, size.y * 0.5f, size.z * 0.5f)), center, -1));
+    m_staticObjects.back()->setUserIndex2(static_cast<int>(m_staticObjects.size()) - 1);
+
+    std::cout << "Added floor: center(" << center.x << ", " << center.y << ", " << center.z
+              << "), size(" << size.x << ", " << size.y << ", " << size.z << ")" << std::endl;
+}
+
+void BulletCollisionBackend::addTriangleMesh(const std::shared_ptr<TriangleMeshCollider>& mesh) {
+    if (!mesh) return;
+
+    // 網格接觸由 SAH BVH 直接查詢，不加入 Bullet 碰撞世界
+    m_meshColliders.push_back(mesh);
+
+    std::cout << "Added triangle mesh: " << mesh->getTriangleCount() << " triangles" << std::endl;
+}
+
+int BulletCollisionBackend::addParticle(int particleIndex, const glm::vec3& position, float radius) {
+    if (particleIndex < 0) return -1;
+
+    m_particleObjects.push_back(createObject(std::make_unique<btSphereShape>(radius), position, particleIndex));
+    return static_cast<int>(m_particleObjects.size()) - 1;
+}
+
+void BulletCollisionBackend::updateParticlePosition(int handle, const glm::vec3& position) {
+    if (handle < 0 || handle >= static_cast<int>(m_particleObjects.size())) return;
+
+    btCollisionObject* collisionObject = m_particleObjects[handle].get();
+    if (!collisionObject) return;
+
+    // 更新碰撞物件的位置
+    btTransform transform = collisionObject->getWorldTransform();
+    transform.setOrigin(glmToBullet(position));
+    collisionObject->setWorldTransform(transform);
+}
+
+void BulletCollisionBackend::removeParticle(int handle) {
+    if (handle < 0 || handle >= static_cast<int>(m_particleObjects.size())) return;
+
+    // 保留槽位，其他句柄不變 (形狀隨後端一起釋放)
+    if (m_particleObjects[handle]) {
+        m_collisionWorld->removeCollisionObject(m_particleObjects[handle].get());
+        m_particleObjects[handle].reset();
+    }
+}
+
+float BulletCollisionBackend::getContactThreshold() const {
+    return kContactThreshold;
+}
+
+void BulletCollisionBackend::performCollisionDetection(std::vector<OGCContact>& contacts,
+                                                       const ParallelSettings& settings,
+                                                       const std::vector<char>* skipMask) {
+    contacts.clear();
+
+    // 執行碰撞檢測 (Bullet 世界整體更新，略過遮罩只作用於網格查詢)
+    m_collisionWorld->performDiscreteCollisionDetection();
+
+    // 遍歷所有接觸流形
+    int numManifolds = m_dispatcher->getNumManifolds();
+    for (int i = 0; i < numManifolds; i++) {
+        convertBulletContacts(m_dispatcher->getManifoldByIndexInternal(i), contacts);
+    }
+
+    // 粒子與三角形網格的最近點查詢 (粒子區塊平行，各自寫入區塊緩衝)
+    if (m_meshColliders.empty()) return;
+
+    int particleLimit = 0;
+    for (const auto& obj : m_particleObjects) {
+        if (obj) particleLimit = std::max(particleLimit, obj->getUserIndex() + 1);
+    }
+    for (const auto& mesh : m_meshColliders) {
+        mesh->reserveHints(particleLimit);
+    }
+
+    int particleCount = static_cast<int>(m_particleObjects.size());
+    int blockCount = (particleCount + kDetectBlockSize - 1) / kDetectBlockSize;
+    m_blockContacts.resize(blockCount);
+
+    ParallelSettings blockSettings(settings.threadCount, settings.deterministic, 1);
+    parallelFor(blockCount, blockSettings, [&](int blockBegin, int blockEnd) {
+        for (int block = blockBegin; block < blockEnd; ++block) {
+            std::vector<OGCContact>& blockContacts = m_blockContacts[block];
+            blockContacts.clear();
+
+            int begin = block * kDetectBlockSize;
+            int end = std::min(particleCount, begin + kDetectBlockSize);
+            for (int handle = begin; handle < end; ++handle) {
+                const btCollisionObject* obj = m_particleObjects[handle].get();
+                if (!obj) continue;
+
+                int particleIndex = obj->getUserIndex();
+                if (isSkipped(skipMask, particleIndex)) continue;
+
+                glm::vec3 position = bulletToGlm(obj->getWorldTransform().getOrigin());
+                float radius = static_cast<const btSphereShape*>(obj->getCollisionShape())->getRadius();
+                for (size_t meshIndex = 0; meshIndex < m_meshColliders.size(); ++meshIndex) {
+                    OGCContact contact;
+                    if (m_meshColliders[meshIndex]->generateContact(particleIndex, position, radius, contact)) {
+                        contact.featureId = static_cast<int>(m_staticObjects.size() + meshIndex);
+                        blockContacts.push_back(contact);
+                    }
+                }
+            }
+        }
+    });
+
+    // 按區塊順序壓實合併
+    compactBlocks(m_blockContacts, contacts, settings);
+}
+
+void BulletCollisionBackend::convertBulletContacts(btPersistentManifold* manifold, std::vector<OGCContact>& contacts) {
+    if (!manifold) return;
+
+    const btCollisionObject* objA = manifold->getBody0();
+    const btCollisionObject* objB = manifold->getBody1();
+
+    int particleA = objA ? objA->getUserIndex() : -1;
+    int particleB = objB ? objB->getUserIndex() : -1;
+
+    // 靜態物體的第二用戶索引為其添加順序 (作為接觸特徵)
+    const btCollisionObject* staticObject = particleB < 0 ? objB : (particleA < 0 ? objA : nullptr);
+    int featureId = staticObject ? staticObject->getUserIndex2() : -1;
+
+    // 遍歷接觸點
+    int numContacts = manifold->getNumContacts();
+    for (int i = 0; i < numContacts; i++) {
+        btManifoldPoint& point = manifold->getContactPoint(i);
+
+        // 只處理有效的接觸點
+        if (point.getDistance() < kContactThreshold) {
+            OGCContact contact;
+
+            contact.particleIndexA = particleA;
+            contact.particleIndexB = particleB;
+            contact.contactPoint = bulletToGlm(point.getPositionWorldOnA());
+            contact.contactNormal = bulletToGlm(point.m_normalWorldOnB);
+            contact.penetrationDepth = std::max(0.0f, -point.getDistance());
+            contact.featureId = featureId;
+
+            contacts.push_back(contact);
+        }
+    }
+}
+
+} // namespace Physics
@@ -0,0 +1,412 @@
+#include "physics/ClothBVH.h"
+#include "physics/Geometry.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <numeric>
+
+namespace Physics {
+
+namespace {
+
+// 葉節點最多包含的圖元數
+constexpr int kLeafSize = 4;
+
+// 每批共用一次遍歷的查詢數 (對應 32 位元遮罩)
+constexpr int kBatchSize = 32;
+
+int lowestBit(uint32_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(mask);
+#else
+    int bit = 0;
+    while ((mask & 1u) == 0u) {
+        mask >>= 1;
+        ++bit;
+    }
+    return bit;
+#endif
+}
+
+void primitiveBounds(const glm::ivec3& primitive, const std::vector<glm::vec3>& positions,
+                     glm::vec3& boundsMin, glm::vec3& boundsMax) {
+    boundsMin = positions[primitive.x];
+    boundsMax = positions[primitive.x];
+    for (int k = 1; k < 3; ++k) {
+        if (primitive[k] < 0) continue;
+        boundsMin = glm::min(boundsMin, positions[primitive[k]]);
+        boundsMax = glm::max(boundsMax, positions[primitive[k]]);
+    }
+}
+
+float surfaceArea(const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
+    glm::vec3 extent = boundsMax - boundsMin;
+    return 2.0f * (extent.x * extent.y + extent.y * extent.z + extent.z * extent.x);
+}
+
+bool overlaps(const glm::vec3& minA, const glm::vec3& maxA, const glm::vec3& minB, const glm::vec3& maxB) {
+    return minA.x <= maxB.x && maxA.x >= minB.x &&
+           minA.y <= maxB.y && maxA.y >= minB.y &&
+           minA.z <= maxB.z && maxA.z >= minB.z;
+}
+
+} // namespace
+
+ClothBVH::ClothBVH()
+    : m_gridWidth(0)
+    , m_rebuildThreshold(1.5f)
+    , m_excludedRingDistance(2)
+    , m_rebuildCount(0)
+    , m_built(false)
+{
+}
+
+void ClothBVH::setGridTopology(int width, int height) {
+    m_gridWidth = width;
+    m_triangles.clear();
+    m_edges.clear();
+    m_built = false;
+
+    auto index = [width](int x, int y) { return y * width + x; };
+
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            // 與風力計算相同的三角形劃分：(p1, p2, p3) 和 (p2, p4, p3)
+            if (x < width - 1 && y < height - 1) {
+                int p1 = index(x, y), p2 = index(x + 1, y);
+                int p3 = index(x, y + 1), p4 = index(x + 1, y + 1);
+                m_triangles.emplace_back(p1, p2, p3);
+                m_triangles.emplace_back(p2, p4, p3);
+                m_edges.emplace_back(p2, p3, -1);   // 對角邊
+            }
+            if (x < width - 1) m_edges.emplace_back(index(x, y), index(x + 1, y), -1);
+            if (y < height - 1) m_edges.emplace_back(index(x, y), index(x, y + 1), -1);
+        }
+    }
+}
+
+void ClothBVH::update(const std::vector<glm::vec3>& positions, const ParallelSettings& settings) {
+    if (!m_built) {
+        build(m_triangleTree, m_triangles, positions);
+        build(m_edgeTree, m_edges, positions);
+        m_built = true;
+        ++m_rebuildCount;
+        return;
+    }
+
+    refit(m_triangleTree, m_triangles, positions, settings);
+    refit(m_edgeTree, m_edges, positions, settings);
+
+    // 擬合後的樹品質劣化太多時才重建
+    if (computeCost(m_triangleTree) > m_triangleTree.builtCost * m_rebuildThreshold) {
+        build(m_triangleTree, m_triangles, positions);
+        ++m_rebuildCount;
+    }
+    if (computeCost(m_edgeTree) > m_edgeTree.builtCost * m_rebuildThreshold) {
+        build(m_edgeTree, m_edges, positions);
+        ++m_rebuildCount;
+    }
+}
+
+void ClothBVH::detect(const std::vector<glm::vec3>& positions, float contactRadius,
+                      std::vector<OGCContact>& contacts, const ParallelSettings& settings) {
+    if (m_triangles.empty() || contactRadius <= 0.0f) return;
+
+    update(positions, settings);
+
+    int vertexCount = static_cast<int>(positions.size());
+    int edgeCount = static_cast<int>(m_edges.size());
+    int vertexBatches = (vertexCount + kBatchSize - 1) / kBatchSize;
+    int edgeBatches = (edgeCount + kBatchSize - 1) / kBatchSize;
+    m_batchContacts.resize(vertexBatches + edgeBatches);
+
+    float radiusSq = contactRadius * contactRadius;
+    glm::vec3 radius(contactRadius);
+
+    ParallelSettings batchSettings(settings.threadCount, settings.deterministic, 1);
+    parallelFor(vertexBatches + edgeBatches, batchSettings, [&](int batchBegin, int batchEnd) {
+        glm::vec3 queryMin[kBatchSize], queryMax[kBatchSize];
+
+        for (int batch = batchBegin; batch < batchEnd; ++batch) {
+            std::vector<OGCContact>& batchContacts = m_batchContacts[batch];
+            batchContacts.clear();
+
+            if (batch < vertexBatches) {
+                // 點-面：每批 32 個頂點共同遍歷三角形 BVH
+                int base = batch * kBatchSize;
+                int count = std::min(kBatchSize, vertexCount - base);
+                for (int q = 0; q < count; ++q) {
+                    queryMin[q] = positions[base + q] - radius;
+                    queryMax[q] = positions[base + q] + radius;
+                }
+
+                traverseBatch(m_triangleTree, queryMin, queryMax, count, [&](int q, int primitive) {
+                    int vertex = base + q;
+                    const glm::ivec3& triangle = m_triangles[primitive];
+                    for (int k = 0; k < 3; ++k) {
+                        if (areTopologicalNeighbours(vertex, triangle[k])) return;
+                    }
+
+                    const glm::vec3& p = positions[vertex];
+                    const glm::vec3& a = positions[triangle.x];
+                    const glm::vec3& b = positions[triangle.y];
+                    const glm::vec3& c = positions[triangle.z];
+                    glm::vec3 weights = closestPointOnTriangle(p, a, b, c);
+                    glm::vec3 closest = weights.x * a + weights.y * b + weights.z * c;
+
+                    glm::vec3 delta = p - closest;
+                    float distanceSq = glm::dot(delta, delta);
+                    if (distanceSq >= radiusSq) return;
+
+                    float distance = std::sqrt(distanceSq);
+                    glm::vec3 normal;
+                    if (distance > 1e-6f) {
+                        normal = delta / distance;
+                    } else {
+                        glm::vec3 faceNormal = glm::cross(b - a, c - a);
+                        float faceLength = glm::length(faceNormal);
+                        if (faceLength <= 1e-12f) return;
+                        normal = faceNormal / faceLength;
+                    }
+
+                    OGCContact contact;
+                    contact.particleIndexA = vertex;
+                    contact.particleIndexB = triangle.x;
+                    contact.particleIndexB1 = triangle.y;
+                    contact.particleIndexB2 = triangle.z;
+                    contact.weightsB = weights;
+                    contact.contactPoint = closest;
+                    contact.contactNormal = normal;
+                    contact.penetrationDepth = contactRadius - distance;
+                    contact.contactRadius = contactRadius;
+                    batchContacts.push_back(contact);
+                });
+            } else {
+                // 邊-邊：每批 32 條邊共同遍歷邊 BVH
+                int base = (batch - vertexBatches) * kBatchSize;
+                int count = std::min(kBatchSize, edgeCount - base);
+                for (int q = 0; q < count; ++q) {
+                    const glm::ivec3& edge = m_edges[base + q];
+                    queryMin[q] = glm::min(positions[edge.x], positions[edge.y]) - radius;
+                    queryMax[q] = glm::max(positions[edge.x], positions[edge.y]) + radius;
+                }
+
+                traverseBatch(m_edgeTree, queryMin, queryMax, count, [&](int q, int primitive) {
+                    int edgeIndex = base + q;
+                    // 每對只由較小索引的邊產生一次
+                    if (primitive <= edgeIndex) return;
+
+                    const glm::ivec3& edgeA = m_edges[edgeIndex];
+                    const glm::ivec3& edgeB = m_edges[primitive];
+                    if (areTopologicalNeighbours(edgeA.x, edgeB.x) || areTopologicalNeighbours(edgeA.x, edgeB.y) ||
+                        areTopologicalNeighbours(edgeA.y, edgeB.x) || areTopologicalNeighbours(edgeA.y, edgeB.y)) {
+                        return;
+                    }
+
+                    const glm::vec3& p1 = positions[edgeA.x];
+                    const glm::vec3& q1 = positions[edgeA.y];
+                    const glm::vec3& p2 = positions[edgeB.x];
+                    const glm::vec3& q2 = positions[edgeB.y];
+                    glm::vec2 st = closestSegmentParameters(p1, q1, p2, q2);
+                    glm::vec3 closestA = p1 + st.x * (q1 - p1);
+                    glm::vec3 closestB = p2 + st.y * (q2 - p2);
+
+                    glm::vec3 delta = closestA - closestB;
+                    float distanceSq = glm::dot(delta, delta);
+                    if (distanceSq >= radiusSq || distanceSq < 1e-12f) return;
+
+                    float distance = std::sqrt(distanceSq);
+
+                    OGCContact contact;
+                    contact.particleIndexA = edgeA.x;
+                    contact.particleIndexA1 = edgeA.y;
+                    contact.particleIndexB = edgeB.x;
+                    contact.particleIndexB1 = edgeB.y;
+                    contact.weightsA = glm::vec2(1.0f - st.x, st.x);
+                    contact.weightsB = glm::vec3(1.0f - st.y, st.y, 0.0f);
+                    contact.contactPoint = 0.5f * (closestA + closestB);
+                    contact.contactNormal = delta / distance;
+                    contact.penetrationDepth = contactRadius - distance;
+                    contact.contactRadius = contactRadius;
+                    batchContacts.push_back(contact);
+                });
+            }
+        }
+    });
+
+    // 按批次順序壓實合併
+    compactBlocks(m_batchContacts, contacts, settings);
+}
+
+void ClothBVH::build(Hierarchy& tree, const std::vector<glm::ivec3>& primitives,
+                     const std::vector<glm::vec3>& positions) {
+    int primitiveCount = static_cast<int>(primitives.size());
+    tree.nodes.clear();
+    for (std::vector<int>& level : tree.levels) {
+        level.clear();  // 保留各層容量
+    }
+    tree.primitiveOrder.resize(primitiveCount);
+    std::iota(tree.primitiveOrder.begin(), tree.primitiveOrder.end(), 0);
+    if (primitiveCount == 0) return;
+
+    std::vector<glm::vec3>& boundsMin = m_buildBoundsMin;
+    std::vector<glm::vec3>& boundsMax = m_buildBoundsMax;
+    std::vector<glm::vec3>& centroids = m_buildCentroids;
+    boundsMin.resize(primitiveCount);
+    boundsMax.resize(primitiveCount);
+    centroids.resize(primitiveCount);
+    for (int i = 0; i < primitiveCount; ++i) {
+        primitiveBounds(primitives[i], positions, boundsMin[i], boundsMax[i]);
+        centroids[i] = 0.5f * (boundsMin[i] + boundsMax[i]);
+    }
+
+    std::vector<BuildTask>& stack = m_buildStack;
+    stack.clear();
+    tree.nodes.push_back(Node());
+    stack.push_back({0, 0, primitiveCount, 0});
+
+    while (!stack.empty()) {
+        BuildTask task = stack.back();
+        stack.pop_back();
+
+        // 節點包圍盒與質心包圍盒
+        glm::vec3 nodeMin(boundsMin[tree.primitiveOrder[task.begin]]);
+        glm::vec3 nodeMax(boundsMax[tree.primitiveOrder[task.begin]]);
+        glm::vec3 centroidMin(centroids[tree.primitiveOrder[task.begin]]);
+        glm::vec3 centroidMax(centroidMin);
+        for (int i = task.begin; i < task.end; ++i) {
+            int primitive = tree.primitiveOrder[i];
+            nodeMin = glm::min(nodeMin, boundsMin[primitive]);
+            nodeMax = glm::max(nodeMax, boundsMax[primitive]);
+            centroidMin = glm::min(centroidMin, centroids[primitive]);
+            centroidMax = glm::max(centroidMax, centroids[primitive]);
+        }
+        tree.nodes[task.node].boundsMin = nodeMin;
+        tree.nodes[task.node].boundsMax = nodeMax;
+
+        if (static_cast<int>(tree.levels.size()) <= task.depth) {
+            tree.levels.resize(task.depth + 1);
+        }
+        tree.levels[task.depth].push_back(task.node);
+
+        int count = task.end - task.begin;
+        if (count <= kLeafSize) {
+            tree.nodes[task.node].first = task.begin;
+            tree.nodes[task.node].count = count;
+            continue;
+        }
+
+        // 沿質心範圍最長的軸做中位數切分
+        glm::vec3 extent = centroidMax - centroidMin;
+        int axis = (extent.x >= extent.y && extent.x >= extent.z) ? 0 : (extent.y >= extent.z ? 1 : 2);
+        int mid = task.begin + count / 2;
+        std::nth_element(tree.primitiveOrder.begin() + task.begin,
+                         tree.primitiveOrder.begin() + mid,
+                         tree.primitiveOrder.begin() + task.end,
+                         [&](int a, int b) { return centroids[a][axis] < centroids[b][axis]; });
+
+        int left = static_cast<int>(tree.nodes.size());
+        tree.nodes.push_back(Node());
+        tree.nodes.push_back(Node());
+        tree.nodes[task.node].first = left;
+        tree.nodes[task.node].count = 0;
+
+        stack.push_back({left + 1, mid, task.end, task.depth + 1});
+        stack.push_back({left, task.begin, mid, task.depth + 1});
+    }
+
+    tree.builtCost = computeCost(tree);
+}
+
+void ClothBVH::refit(Hierarchy& tree, const std::vector<glm::ivec3>& primitives,
+                     const std::vector<glm::vec3>& positions, const ParallelSettings& settings) {
+    // 從最深層開始逐層向上，同一層的節點互不相依，可平行擬合
+    for (int depth = static_cast<int>(tree.levels.size()) - 1; depth >= 0; --depth) {
+        const std::vector<int>& level = tree.levels[depth];
+        parallelFor(static_cast<int>(level.size()), settings, [&](int begin, int end) {
+            for (int i = begin; i < end; ++i) {
+                Node& node = tree.nodes[level[i]];
+                if (node.count > 0) {
+                    primitiveBounds(primitives[tree.primitiveOrder[node.first]], positions,
+                                    node.boundsMin, node.boundsMax);
+                    for (int k = 1; k < node.count; ++k) {
+                        glm::vec3 primitiveMin, primitiveMax;
+                        primitiveBounds(primitives[tree.primitiveOrder[node.first + k]], positions,
+                                        primitiveMin, primitiveMax);
+                        node.boundsMin = glm::min(node.boundsMin, primitiveMin);
+                        node.boundsMax = glm::max(node.boundsMax, primitiveMax);
+                    }
+                } else {
+                    const Node& left = tree.nodes[node.first];
+                    const Node& right = tree.nodes[node.first + 1];
+                    node.boundsMin = glm::min(left.boundsMin, right.boundsMin);
+                    node.boundsMax = glm::max(left.boundsMax, right.boundsMax);
+                }
+            }
+        });
+    }
+}
+
+float ClothBVH::computeCost(const Hierarchy& tree) {
+    if (tree.nodes.empty()) return 0.0f;
+
+    float rootArea = surfaceArea(tree.nodes[0].boundsMin, tree.nodes[0].boundsMax);
+    if (rootArea <= 0.0f) return 0.0f;
+
+    float total = 0.0f;
+    for (const Node& node : tree.nodes) {
+        total += surfaceArea(node.boundsMin, node.boundsMax);
+    }
+    return total / rootArea;
+}
+
+template <typename Callback>
+void ClothBVH::traverseBatch(const Hierarchy& tree, const glm::vec3* queryMin, const glm::vec3* queryMax,
+                             int queryCount, Callback&& callback) const {
+    if (tree.nodes.empty() || queryCount <= 0) return;
+
+    struct StackEntry {
+        int node;
+        uint32_t mask;      // 與此節點可能重疊的查詢
+    };
+    StackEntry stack[64];
+    int stackSize = 0;
+    stack[stackSize++] = {0, queryCount >= 32 ? 0xffffffffu : ((1u << queryCount) - 1u)};
+
+    while (stackSize > 0) {
+        StackEntry entry = stack[--stackSize];
+        const Node& node = tree.nodes[entry.node];
+
+        uint32_t mask = 0;
+        for (uint32_t remaining = entry.mask; remaining != 0; remaining &= remaining - 1) {
+            int q = lowestBit(remaining);
+            if (overlaps(queryMin[q], queryMax[q], node.boundsMin, node.boundsMax)) {
+                mask |= 1u << q;
+            }
+        }
+        if (mask == 0) continue;
+
+        if (node.count > 0) {
+            for (int k = 0; k < node.count; ++k) {
+                int primitive = tree.primitiveOrder[node.first + k];
+                for (uint32_t remaining = mask; remaining != 0; remaining &= remaining - 1) {
+                    callback(lowestBit(remaining), primitive);
+                }
+            }
+        } else {
+            stack[stackSize++] = {node.first + 1, mask};
+            stack[stackSize++] = {node.first, mask};
+        }
+    }
+}
+
+bool ClothBVH::areTopologicalNeighbours(int a, int b) const {
+    if (m_gridWidth <= 0) return a == b;
+
+    int dx = std::abs(a % m_gridWidth - b % m_gridWidth);
+    int dy = std::abs(a / m_gridWidth - b / m_gridWidth);
+    return dx <= m_excludedRingDistance && dy <= m_excludedRingDistance;
+}
+
+} // namespace Physics
@@ -1,44 +1,102 @@
 #include "physics/ClothSimulation.h"
-#include "physics/BulletIntegration.h"
+#include "physics/CollisionBackend.h"
+#include "physics/SelfCollision.h"
+#include "physics/ClothBVH.h"
+#include "physics/ContinuousCollision.h"
+#include "physics/DisplacementBounds.h"
+#include "physics/ContactCache.h"
+#include "physics/NarrowBand.h"
+#include "physics/SdfCollider.h"
+#include "physics/TriangleMeshCollider.h"
+#include "physics/HeightfieldCollider.h"
+#include "physics/AnalyticColliders.h"
 #include <iostream>
 #include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <limits>
 
 namespace Physics {
 
-ClothSimulation::ClothSimulation()
+template <typename Real>
+BasicClothSimulation<Real>::BasicClothSimulation()
     : m_width(0)
     , m_height(0)
-    , m_clothSize(2.0f, 2.0f)
-    , m_initialPosition(0.0f, 3.0f, 0.0f)
-    , m_particleMass(0.1f)
-    , m_gravity(0.0f, -9.81f, 0.0f)
-    , m_wind(0.0f, 0.0f, 0.0f)
-    , m_damping(0.99f)
+    , m_clothSize(Real(2), Real(2))
+    , m_initialPosition(Real(0), Real(3), Real(0))
+    , m_particleMass(Real(0.1))
+    , m_particleRadius(0.02f)
+    , m_worldOrigin(0.0)
+    , m_gravity(Real(0), Real(-9.81), Real(0))
+    , m_wind(Real(0), Real(0), Real(0))
+    , m_damping(Real(0.99))
     , m_structuralStiffness(1000.0f)
     , m_shearStiffness(500.0f)
     , m_bendingStiffness(200.0f)
     , m_constraintIterations(3)
+    , m_topologyVersion(0)
+    , m_stateHash(0)
+    , m_selfCollisionEnabled(false)
+    , m_triangleCollisionEnabled(false)
+    , m_continuousCollisionEnabled(true)
+    , m_displacementBoundsEnabled(false)
+    , m_skippedDetectionCount(0)
+    , m_maxBoundPasses(4)
+    , m_contactCacheEnabled(false)
+    , m_narrowBandEnabled(false)
+    , m_contactReductionEnabled(false)
+    , m_contactProjectionEnabled(false)
 {
 }
 
-ClothSimulation::~ClothSimulation() {
+template <typename Real>
+BasicClothSimulation<Real>::~BasicClothSimulation() {
     cleanup();
 }
 
-bool ClothSimulation::initialize(int width, int height, const glm::vec2& clothSize, 
-                                const glm::vec3& position, float particleMass) {
+template <typename Real>
+bool BasicClothSimulation<Real>::initialize(int width, int height, const Vec2& clothSize, 
+                                            const Vec3& position, Real particleMass) {
     m_width = width;
     m_height = height;
     m_clothSize = clothSize;
     m_initialPosition = position;
     m_particleMass = particleMass;
     
-    // 創建 Bullet Physics 整合
-    m_bulletIntegration = std::make_unique<BulletIntegration>();
+    // 創建碰撞後端 (未指定時使用註冊表中優先級最高者)
+    m_collisionBackend = CollisionBackendRegistry::create(m_collisionBackendName);
+    if (!m_collisionBackend) {
+        std::cerr << "Failed to create collision backend" << std::endl;
+        return false;
+    }
     
     // 創建 OGC 接觸模型
     m_ogcContactModel = std::make_unique<OGCContactModel>(0.05f, 1000.0f, 50.0f);
     
+    // 創建自碰撞檢測 (排除約束連接範圍內的鄰居)
+    m_selfCollision = std::make_unique<SelfCollision>(m_particleRadius, 2);
+    m_selfCollision->setGridTopology(width, height);
+    
+    // 創建三角形/邊 BVH (點-面與邊-邊接觸)
+    m_clothBvh = std::make_unique<ClothBVH>();
+    m_clothBvh->setGridTopology(width, height);
+    
+    // 創建連續碰撞檢測 (防止快速粒子穿過薄碰撞體)
+    m_continuousCollision = std::make_unique<ContinuousCollision>(m_particleRadius);
+    
+    // 創建解析碰撞體集合 (球、膠囊、定向盒、圓角盒、圓環、平面)
+    m_analyticColliders = std::make_unique<AnalyticColliders>();
+    
+    // 創建 OGC 保守位移界
+    m_displacementBounds = std::make_unique<DisplacementBounds>(0.45f);
+    
+    // 創建跨幀接觸快取 (錨點位移小於粒子半徑的十分之一時沿用接觸)
+    m_contactCache = std::make_unique<ContactCache>(0.1f * m_particleRadius, 8);
+    
+    // 創建碰撞後端的窄帶活躍集 (8x8 粒子一簇)
+    m_narrowBand = std::make_unique<NarrowBand>(0.1f, 8);
+    m_narrowBand->setGridTopology(width, height);
+    
     // 創建粒子和約束
     createParticles();
     createConstraints();
@@ -49,89 +107,371 @@ bool ClothSimulation::initialize(int width, int height, const glm::vec2& clothSi
     return true;
 }
 
-void ClothSimulation::cleanup() {
+template <typename Real>
+void BasicClothSimulation<Real>::cleanup() {
     m_particles.clear();
     m_constraints.clear();
     m_contacts.clear();
-    m_bulletIntegration.reset();
+    m_particleCollisionHandles.clear();
+    m_triangleWindForces.clear();
+    m_collisionPositions.clear();
+    m_positionView.clear();
+    m_edgeIndices.clear();
+    ++m_topologyVersion;
+    m_collisionBackend.reset();
     m_ogcContactModel.reset();
+    m_selfCollision.reset();
+    m_clothBvh.reset();
+    m_continuousCollision.reset();
+    m_previousCollisionPositions.clear();
+    m_displacementBounds.reset();
+    m_contactCache.reset();
+    m_narrowBand.reset();
+    m_detectionMask.clear();
+    m_sdfColliders.clear();
+    m_meshColliders.clear();
+    m_heightfieldColliders.clear();
+    m_analyticColliders.reset();
+    m_colliderDistances.clear();
+    m_contactAnchors.clear();
 }
 
-void ClothSimulation::update(float deltaTime) {
+template <typename Real>
+void BasicClothSimulation<Real>::update(Real deltaTime) {
+    // 0. 在步邊界執行排隊的場景編輯
+    applyCommands();
+    
     // 1. 應用外力
     applyForces(deltaTime);
     
     // 2. 更新粒子位置 (Verlet 積分)
     updateParticles(deltaTime);
     
-    // 3. 求解約束
+    // 3. 求解約束 (啟用接觸投影時，上一步檢測到的接觸在每次迭代後投影)
+    bool projectPrevious = m_contactProjectionEnabled && m_ogcContactModel && !m_contacts.empty() &&
+                           m_contactAnchors.size() == m_particles.size();
     for (int i = 0; i < m_constraintIterations; ++i) {
         solveConstraints();
+        if (projectPrevious) {
+            m_ogcContactModel->projectContacts(m_contacts, m_particles, m_contactAnchors, m_parallelSettings);
+        }
     }
     
     // 4. 處理碰撞
     handleCollisions();
+    
+    // 5. 記錄本步狀態雜湊
+    m_stateHash = computeStateHash();
+    
+    // 6. 同步對外的位置視圖
+    syncPositionView();
 }
 
-void ClothSimulation::addCylinder(const glm::vec3& center, float radius, float height) {
-    if (m_bulletIntegration) {
-        m_bulletIntegration->addCylinder(center, radius, height);
+template <typename Real>
+int BasicClothSimulation<Real>::applyCommands() {
+    int applied = 0;
+    Command command;
+    while (m_commands.tryPop(command)) {
+        if (command) {
+            command(*this);
+        }
+        ++applied;
+    }
+    return applied;
+}
+
+template <typename Real>
+bool BasicClothSimulation<Real>::setCollisionBackend(const std::string& name) {
+    if (m_collisionBackend) {
+        std::cerr << "Collision backend must be selected before initialize()" << std::endl;
+        return false;
+    }
+    if (!name.empty() && !CollisionBackendRegistry::isRegistered(name)) {
+        std::cerr << "Unknown collision backend: " << name << std::endl;
+        return false;
+    }
+    m_collisionBackendName = name;
+    return true;
+}
+
+template <typename Real>
+const char* BasicClothSimulation<Real>::getCollisionBackendName() const {
+    return m_collisionBackend ? m_collisionBackend->getName() : m_collisionBackendName.c_str();
+}
+
+template <typename Real>
+void BasicClothSimulation<Real>::addCylinder(const Vec3& center, float radius, float height) {
+    if (m_collisionBackend) {
+        m_collisionBackend->addCylinder(toCollisionSpace(center), radius, height);
+        if (m_continuousCollision) {
+            m_continuousCollision->addCylinder(toCollisionSpace(center), radius, height);
+        }
+        invalidateCollisionCaches();
         std::cout << "Added cylinder: center(" << center.x << ", " << center.y << ", " << center.z 
                   << "), radius=" << radius << ", height=" << height << std::endl;
     }
 }
 
-void ClothSimulation::addFloor(const glm::vec3& center, const glm::vec3& size) {
-    if (m_bulletIntegration) {
-        m_bulletIntegration->addFloor(center, size);
+template <typename Real>
+void BasicClothSimulation<Real>::addFloor(const Vec3& center, const glm::vec3& size) {
+    if (m_collisionBackend) {
+        m_collisionBackend->addFloor(toCollisionSpace(center), size);
+        if (m_continuousCollision) {
+            m_continuousCollision->addBox(toCollisionSpace(center), size);
+        }
+        invalidateCollisionCaches();
         std::cout << "Added floor: center(" << center.x << ", " << center.y << ", " << center.z 
                   << "), size(" << size.x << ", " << size.y << ", " << size.z << ")" << std::endl;
     }
 }
 
-void ClothSimulation::setParticleFixed(int particleIndex, bool fixed) {
+template <typename Real>
+int BasicClothSimulation<Real>::addSphere(const Vec3& center, float radius) {
+    if (!m_analyticColliders) return -1;
+    int collider = m_analyticColliders->addSphere(toCollisionSpace(center), radius);
+    invalidateCollisionCaches();
+    return collider;
+}
+
+template <typename Real>
+int BasicClothSimulation<Real>::addCapsule(const Vec3& pointA, const Vec3& pointB, float radius) {
+    if (!m_analyticColliders) return -1;
+    int collider = m_analyticColliders->addCapsule(toCollisionSpace(pointA), toCollisionSpace(pointB), radius);
+    invalidateCollisionCaches();
+    return collider;
+}
+
+template <typename Real>
+int BasicClothSimulation<Real>::addOrientedBox(const Vec3& center, const glm::vec3& halfExtents,
+                                               const glm::mat3& rotation) {
+    if (!m_analyticColliders) return -1;
+    int collider = m_analyticColliders->addOrientedBox(toCollisionSpace(center), halfExtents, rotation);
+    invalidateCollisionCaches();
+    return collider;
+}
+
+template <typename Real>
+int BasicClothSimulation<Real>::addRoundedBox(const Vec3& center, const glm::vec3& halfExtents,
+                                              const glm::mat3& rotation, float roundingRadius) {
+    if (!m_analyticColliders) return -1;
+    int collider = m_analyticColliders->addRoundedBox(toCollisionSpace(center), halfExtents, rotation, roundingRadius);
+    invalidateCollisionCaches();
+    return collider;
+}
+
+template <typename Real>
+int BasicClothSimulation<Real>::addTorus(const Vec3& center, const glm::vec3& axis, float majorRadius,
+                                         float minorRadius) {
+    if (!m_analyticColliders) return -1;
+    int collider = m_analyticColliders->addTorus(toCollisionSpace(center), axis, majorRadius, minorRadius);
+    invalidateCollisionCaches();
+    return collider;
+}
+
+template <typename Real>
+int BasicClothSimulation<Real>::addPlane(const Vec3& point, const glm::vec3& normal) {
+    if (!m_analyticColliders) return -1;
+    int collider = m_analyticColliders->addPlane(toCollisionSpace(point), normal);
+    invalidateCollisionCaches();
+    return collider;
+}
+
+template <typename Real>
+void BasicClothSimulation<Real>::setColliderTransform(int collider, const Vec3& center, const glm::mat3& rotation) {
+    if (!m_analyticColliders) return;
+    m_analyticColliders->setTransform(collider, toCollisionSpace(center), rotation);
+    
+    // 位移界假設碰撞體靜止；接觸快取只沿用後端接觸，熱啟動仍有效
+    if (m_displacementBounds) {
+        m_displacementBounds->reset();
+    }
+}
+
+template <typename Real>
+void BasicClothSimulation<Real>::setColliderVelocity(int collider, const glm::vec3& linearVelocity,
+                                                     const glm::vec3& angularVelocity) {
+    if (!m_analyticColliders) return;
+    m_analyticColliders->setVelocity(collider, linearVelocity, angularVelocity);
+}
+
+template <typename Real>
+void BasicClothSimulation<Real>::addTriangleMesh(const std::vector<Vec3>& vertices,
+                                                 const std::vector<glm::ivec3>& triangles) {
+    if (!m_collisionBackend || vertices.empty() || triangles.empty()) return;
+    
+    std::vector<glm::vec3> collisionVertices(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        collisionVertices[i] = toCollisionSpace(vertices[i]);
+    }
+    
+    auto mesh = std::make_shared<TriangleMeshCollider>(collisionVertices, triangles);
+    m_collisionBackend->addTriangleMesh(mesh);
+    m_meshColliders.push_back(mesh);
+    invalidateCollisionCaches();
+}
+
+template <typename Real>
+bool BasicClothSimulation<Real>::addHeightfield(const std::vector<float>& heights, int columns, int rows,
+                                                const Vec3& origin, float cellSize) {
+    auto collider = std::make_unique<HeightfieldCollider>();
+    if (!collider->build(heights, columns, rows, toCollisionSpace(origin), cellSize)) {
+        return false;
+    }
+    
+    m_heightfieldColliders.push_back(std::move(collider));
+    invalidateCollisionCaches();
+    return true;
+}
+
+template <typename Real>
+bool BasicClothSimulation<Real>::addSdfCollider(const std::vector<Vec3>& vertices,
+                                                const std::vector<glm::ivec3>& triangles,
+                                                float voxelSize, const std::string& cachePath) {
+    std::vector<glm::vec3> collisionVertices(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        collisionVertices[i] = toCollisionSpace(vertices[i]);
+    }
+    
+    // 窄帶需涵蓋粒子接觸距離
+    float bandWidth = std::max(4.0f * voxelSize, 2.0f * m_particleRadius);
+    
+    auto collider = std::make_unique<SdfCollider>();
+    if (!collider->build(collisionVertices, triangles, voxelSize, bandWidth, cachePath)) {
+        return false;
+    }
+    
+    m_sdfColliders.push_back(std::move(collider));
+    invalidateCollisionCaches();
+    return true;
+}
+
+template <typename Real>
+void BasicClothSimulation<Real>::setParticleFixed(int particleIndex, bool fixed) {
     if (particleIndex >= 0 && particleIndex < static_cast<int>(m_particles.size())) {
         m_particles[particleIndex]->setFixed(fixed);
     }
 }
 
-void ClothSimulation::reset() {
+template <typename Real>
+void BasicClothSimulation<Real>::setParticlesFixed(const std::vector<int>& particleIndices, bool fixed) {
+    for (int particleIndex : particleIndices) {
+        setParticleFixed(particleIndex, fixed);
+    }
+}
+
+template <typename Real>
+void BasicClothSimulation<Real>::setDisplacementBoundsEnabled(bool enabled) {
+    m_displacementBoundsEnabled = enabled;
+    if (m_displacementBounds) {
+        m_displacementBounds->reset();
+    }
+}
+
+template <typename Real>
+void BasicClothSimulation<Real>::setContactCacheEnabled(bool enabled) {
+    m_contactCacheEnabled = enabled;
+    if (m_contactCache) {
+        m_contactCache->reset();
+    }
+}
+
+template <typename Real>
+void BasicClothSimulation<Real>::setNarrowBandEnabled(bool enabled) {
+    m_narrowBandEnabled = enabled;
+    if (m_narrowBand) {
+        m_narrowBand->reset();
+    }
+}
+
+template <typename Real>
+void BasicClothSimulation<Real>::invalidateCollisionCaches() {
+    if (m_displacementBounds) {
+        m_displacementBounds->reset();
+    }
+    if (m_contactCache) {
+        m_contactCache->reset();
+    }
+    if (m_narrowBand) {
+        m_narrowBand->reset();
+    }
+}
+
+template <typename Real>
+void BasicClothSimulation<Real>::setThreadCount(int threadCount) {
+    m_parallelSettings.threadCount = std::max(1, threadCount);
+}
+
+template <typename Real>
+glm::dvec3 BasicClothSimulation<Real>::getWorldPosition(int particleIndex) const {
+    return m_worldOrigin + glm::dvec3(m_particles[particleIndex]->getPosition());
+}
+
+template <typename Real>
+uint64_t BasicClothSimulation<Real>::computeStateHash() const {
+    // FNV-1a 64 位元，直接對浮點數的位元模式做雜湊
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](const Vec3& v) {
+        const Real components[3] = {v.x, v.y, v.z};
+        for (Real component : components) {
+            unsigned char bytes[sizeof(Real)];
+            std::memcpy(bytes, &component, sizeof(Real));
+            for (unsigned char byte : bytes) {
+                hash ^= byte;
+                hash *= 1099511628211ull;
+            }
+        }
+    };
+    
+    for (const auto& particle : m_particles) {
+        mix(particle->getPosition());
+        mix(particle->getPreviousPosition());
+    }
+    
+    return hash;
+}
+
+template <typename Real>
+void BasicClothSimulation<Real>::reset() {
     // 重置所有粒子到初始位置
     for (int y = 0; y < m_height; ++y) {
         for (int x = 0; x < m_width; ++x) {
             int index = getParticleIndex(x, y);
             
-            float xPos = m_initialPosition.x + (x / float(m_width - 1) - 0.5f) * m_clothSize.x;
-            float yPos = m_initialPosition.y;
-            float zPos = m_initialPosition.z + (y / float(m_height - 1) - 0.5f) * m_clothSize.y;
-            
-            glm::vec3 position(xPos, yPos, zPos);
+            Vec3 position = gridPosition(x, y);
             m_particles[index]->setPosition(position);
-            m_particles[index]->setVelocity(glm::vec3(0.0f));
+            m_particles[index]->setVelocity(Vec3(Real(0)));
         }
     }
     
     // 清除接觸
     m_contacts.clear();
+    invalidateCollisionCaches();
+    syncPositionView();
     
     std::cout << "Cloth simulation reset" << std::endl;
 }
 
-void ClothSimulation::createParticles() {
+template <typename Real>
+typename BasicClothSimulation<Real>::Vec3 BasicClothSimulation<Real>::gridPosition(int x, int y) const {
+    Real xPos = m_initialPosition.x + (Real(x) / Real(m_width - 1) - Real(0.5)) * m_clothSize.x;
+    Real yPos = m_initialPosition.y;
+    Real zPos = m_initialPosition.z + (Real(y) / Real(m_height - 1) - Real(0.5)) * m_clothSize.y;
+    return Vec3(xPos, yPos, zPos);
+}
+
+template <typename Real>
+void BasicClothSimulation<Real>::createParticles() {
     m_particles.clear();
     m_particles.reserve(m_width * m_height);
+    m_particleCollisionHandles.clear();
     
     for (int y = 0; y < m_height; ++y) {
         for (int x = 0; x < m_width; ++x) {
             // 計算粒子位置
-            float xPos = m_initialPosition.x + (x / float(m_width - 1) - 0.5f) * m_clothSize.x;
-            float yPos = m_initialPosition.y;
-            float zPos = m_initialPosition.z + (y / float(m_height - 1) - 0.5f) * m_clothSize.y;
-            
-            glm::vec3 position(xPos, yPos, zPos);
+            Vec3 position = gridPosition(x, y);
             
             // 創建粒子
-            auto particle = std::make_unique<Particle>(position, m_particleMass);
+            auto particle = std::make_unique<ParticleType>(position, m_particleMass);
             
             // 固定頂部邊緣的粒子 (可選)
             if (y == 0) {
@@ -140,19 +480,24 @@ void ClothSimulation::createParticles() {
             
             m_particles.push_back(std::move(particle));
             
-            // 將粒子添加到 Bullet Physics
-            if (m_bulletIntegration) {
-                m_bulletIntegration->addParticle(m_particles.back().get(), 0.02f);
+            // 將粒子添加到碰撞後端
+            if (m_collisionBackend) {
+                int particleIndex = static_cast<int>(m_particles.size()) - 1;
+                m_particleCollisionHandles.push_back(
+                    m_collisionBackend->addParticle(particleIndex, toCollisionSpace(position), m_particleRadius));
             }
         }
     }
+    
+    syncPositionView();
 }
 
-void ClothSimulation::createConstraints() {
+template <typename Real>
+void BasicClothSimulation<Real>::createConstraints() {
     m_constraints.clear();
     
-    float dx = m_clothSize.x / (m_width - 1);
-    float dy = m_clothSize.y / (m_height - 1);
+    float dx = static_cast<float>(m_clothSize.x / Real(m_width - 1));
+    float dy = static_cast<float>(m_clothSize.y / Real(m_height - 1));
     
     for (int y = 0; y < m_height; ++y) {
         for (int x = 0; x < m_width; ++x) {
@@ -194,19 +539,53 @@ void ClothSimulation::createConstraints() {
             }
         }
     }
+    
+    // 邊索引緩衝只在拓撲改變時重建
+    m_edgeIndices.resize(2 * m_constraints.size());
+    for (size_t i = 0; i < m_constraints.size(); ++i) {
+        m_edgeIndices[2 * i] = static_cast<uint32_t>(m_constraints[i].particleA);
+        m_edgeIndices[2 * i + 1] = static_cast<uint32_t>(m_constraints[i].particleB);
+    }
+    ++m_topologyVersion;
+}
+
+template <typename Real>
+void BasicClothSimulation<Real>::syncPositionView() {
+    m_positionView.resize(m_particles.size());
+    parallelFor(static_cast<int>(m_particles.size()), m_parallelSettings, [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            m_positionView[i] = glm::vec3(m_particles[i]->getPosition());
+        }
+    });
 }
 
-void ClothSimulation::applyForces(float deltaTime) {
+template <typename Real>
+void BasicClothSimulation<Real>::applyForces(Real deltaTime) {
+    int particleCount = static_cast<int>(m_particles.size());
+    
     // 應用重力
-    for (auto& particle : m_particles) {
-        if (!particle->isFixed()) {
-            particle->addForce(m_gravity * particle->getMass());
+    parallelFor(particleCount, m_parallelSettings, [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            ParticleType& particle = *m_particles[i];
+            if (!particle.isFixed()) {
+                particle.addForce(m_gravity * particle.getMass());
+            }
         }
-    }
+    });
+    
+    if (glm::length(m_wind) == Real(0) || m_width < 2 || m_height < 2) return;
     
     // 應用風力 (基於三角形面積)
-    for (int y = 0; y < m_height - 1; ++y) {
-        for (int x = 0; x < m_width - 1; ++x) {
+    // 先平行計算每個三角形的風力，再由每個粒子按三角形索引順序收集，
+    // 避免多個執行緒同時寫入共享頂點
+    int quadCount = (m_width - 1) * (m_height - 1);
+    m_triangleWindForces.resize(quadCount * 2);
+    
+    parallelFor(quadCount, m_parallelSettings, [&](int begin, int end) {
+        for (int quad = begin; quad < end; ++quad) {
+            int x = quad % (m_width - 1);
+            int y = quad / (m_width - 1);
+            
             // 每個四邊形分成兩個三角形
             int p1 = getParticleIndex(x, y);
             int p2 = getParticleIndex(x + 1, y);
@@ -214,62 +593,103 @@ void ClothSimulation::applyForces(float deltaTime) {
             int p4 = getParticleIndex(x + 1, y + 1);
             
             // 三角形 1: p1, p2, p3
-            glm::vec3 windForce1 = calculateWindForce(*m_particles[p1], *m_particles[p2], *m_particles[p3]);
-            m_particles[p1]->addForce(windForce1 / 3.0f);
-            m_particles[p2]->addForce(windForce1 / 3.0f);
-            m_particles[p3]->addForce(windForce1 / 3.0f);
+            m_triangleWindForces[quad * 2] =
+                calculateWindForce(*m_particles[p1], *m_particles[p2], *m_particles[p3]) / Real(3);
             
             // 三角形 2: p2, p4, p3
-            glm::vec3 windForce2 = calculateWindForce(*m_particles[p2], *m_particles[p4], *m_particles[p3]);
-            m_particles[p2]->addForce(windForce2 / 3.0f);
-            m_particles[p4]->addForce(windForce2 / 3.0f);
-            m_particles[p3]->addForce(windForce2 / 3.0f);
+            m_triangleWindForces[quad * 2 + 1] =
+                calculateWindForce(*m_particles[p2], *m_particles[p4], *m_particles[p3]) / Real(3);
         }
-    }
+    });
+    
+    parallelFor(particleCount, m_parallelSettings, [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            m_particles[i]->addForce(gatherWindForce(i % m_width, i / m_width));
+        }
+    });
 }
 
-void ClothSimulation::updateParticles(float deltaTime) {
-    for (auto& particle : m_particles) {
-        // Verlet 積分
-        particle->update(deltaTime);
-        
-        // 應用阻尼
-        if (!particle->isFixed()) {
-            glm::vec3 velocity = particle->getVelocity();
-            particle->setVelocity(velocity * m_damping);
-        }
+template <typename Real>
+typename BasicClothSimulation<Real>::Vec3 BasicClothSimulation<Real>::gatherWindForce(int x, int y) const {
+    auto triangle = [this](int qx, int qy, int k) {
+        return m_triangleWindForces[(qy * (m_width - 1) + qx) * 2 + k];
+    };
+    
+    // 固定依三角形索引遞增順序累加，結果與執行緒數和分塊方式無關
+    Vec3 force(Real(0));
+    bool hasLeft = x > 0, hasRight = x < m_width - 1;
+    bool hasUp = y > 0, hasDown = y < m_height - 1;
+    
+    if (hasUp && hasLeft) {
+        force += triangle(x - 1, y - 1, 1);     // 作為 p4
+    }
+    if (hasUp && hasRight) {
+        force += triangle(x, y - 1, 0);         // 作為 p3
+        force += triangle(x, y - 1, 1);
+    }
+    if (hasDown && hasLeft) {
+        force += triangle(x - 1, y, 0);         // 作為 p2
+        force += triangle(x - 1, y, 1);
+    }
+    if (hasDown && hasRight) {
+        force += triangle(x, y, 0);             // 作為 p1
     }
     
-    // 更新 Bullet Physics 中的粒子位置
-    if (m_bulletIntegration) {
-        // 這裡需要實現粒子與碰撞物件的對應關係
-        // 暫時省略，在實際實現中需要維護這個對應關係
+    return force;
+}
+
+template <typename Real>
+void BasicClothSimulation<Real>::updateParticles(Real deltaTime) {
+    // CCD 線段起點取積分前的位置；阻尼會經 setVelocity 改寫上一幀位置，事後讀取會使線段變短
+    bool captureSweepStart = m_continuousCollisionEnabled && m_continuousCollision;
+    if (captureSweepStart) {
+        m_previousCollisionPositions.resize(m_particles.size());
     }
+    
+    parallelFor(static_cast<int>(m_particles.size()), m_parallelSettings, [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            ParticleType& particle = *m_particles[i];
+            
+            if (captureSweepStart) {
+                m_previousCollisionPositions[i] = toCollisionSpace(particle.getPosition());
+            }
+            
+            // Verlet 積分
+            particle.update(deltaTime);
+            
+            // 應用阻尼
+            if (!particle.isFixed()) {
+                Vec3 velocity = particle.getVelocity();
+                particle.setVelocity(velocity * m_damping);
+            }
+        }
+    });
 }
 
-void ClothSimulation::solveConstraints() {
+template <typename Real>
+void BasicClothSimulation<Real>::solveConstraints() {
     for (const auto& constraint : m_constraints) {
-        Particle* particleA = m_particles[constraint.particleA].get();
-        Particle* particleB = m_particles[constraint.particleB].get();
+        ParticleType* particleA = m_particles[constraint.particleA].get();
+        ParticleType* particleB = m_particles[constraint.particleB].get();
         
-        glm::vec3 posA = particleA->getPosition();
-        glm::vec3 posB = particleB->getPosition();
+        Vec3 posA = particleA->getPosition();
+        Vec3 posB = particleB->getPosition();
         
-        glm::vec3 delta = posB - posA;
-        float currentLength = glm::length(delta);
+        Vec3 delta = posB - posA;
+        Real currentLength = glm::length(delta);
         
-        if (currentLength > 0.0f) {
-            float difference = (currentLength - constraint.restLength) / currentLength;
-            glm::vec3 correction = delta * difference * 0.5f;
+        if (currentLength > Real(0)) {
+            Real difference = (currentLength - Real(constraint.restLength)) / currentLength;
+            Vec3 correction = delta * difference * Real(0.5);
             
             // 根據質量分配修正
-            float invMassA = particleA->getInverseMass();
-            float invMassB = particleB->getInverseMass();
-            float totalInvMass = invMassA + invMassB;
+            Real invMassA = particleA->getInverseMass();
+            Real invMassB = particleB->getInverseMass();
+            Real totalInvMass = invMassA + invMassB;
             
-            if (totalInvMass > 0.0f) {
-                glm::vec3 correctionA = correction * (invMassA / totalInvMass);
-                glm::vec3 correctionB = correction * (invMassB / totalInvMass);
+            if (totalInvMass > Real(0)) {
+                Vec3 correctionA = correction * (invMassA / totalInvMass);
+                Vec3 correctionB = correction * (invMassB / totalInvMass);
                 
                 if (!particleA->isFixed()) {
                     particleA->setPosition(posA + correctionA);
@@ -282,33 +702,250 @@ void ClothSimulation::solveConstraints() {
     }
 }
 
-void ClothSimulation::handleCollisions() {
-    if (!m_bulletIntegration || !m_ogcContactModel) return;
+template <typename Real>
+void BasicClothSimulation<Real>::handleCollisions() {
+    if (!m_collisionBackend || !m_ogcContactModel) return;
+    
+    m_collisionPositions.resize(m_particles.size());
+    for (size_t i = 0; i < m_particles.size(); ++i) {
+        m_collisionPositions[i] = toCollisionSpace(m_particles[i]->getPosition());
+    }
     
-    // 執行碰撞檢測
-    m_contacts = m_bulletIntegration->performCollisionDetection();
+    if (m_displacementBoundsEnabled && m_displacementBounds) {
+        applyDisplacementBounds();
+    } else {
+        detectContacts();
+    }
+    
+    // 記錄檢測時的粒子位置，下一步投影時按位移更新穿透深度
+    if (m_contactProjectionEnabled) {
+        m_contactAnchors.resize(m_particles.size());
+        for (size_t i = 0; i < m_particles.size(); ++i) {
+            m_contactAnchors[i] = m_particles[i]->getPosition();
+        }
+    } else {
+        m_contactAnchors.clear();
+    }
+    
+    bool useCache = m_contactCacheEnabled && m_contactCache;
+    if (useCache) {
+        m_contactCache->warmStart(m_contacts);
+    }
     
     // 使用 OGC 模型處理接觸
     if (!m_contacts.empty()) {
-        m_ogcContactModel->processContacts(m_contacts, 1.0f / 60.0f); // 假設 60 FPS
+        m_ogcContactModel->processContacts(m_contacts, m_particles, 1.0f / 60.0f, m_parallelSettings); // 假設 60 FPS
+    }
+    
+    if (useCache) {
+        m_contactCache->store(m_contacts);
+    }
+}
+
+template <typename Real>
+void BasicClothSimulation<Real>::applyDisplacementBounds() {
+    // 查詢範圍外的布料幾何至少相距檢測距離
+    float clothQueryDistance = 0.0f;
+    if (m_selfCollisionEnabled) {
+        clothQueryDistance = 2.0f * m_particleRadius;
+    }
+    if (m_triangleCollisionEnabled) {
+        float triangleDistance = m_ogcContactModel->getContactRadius();
+        clothQueryDistance = clothQueryDistance > 0.0f
+            ? std::min(clothQueryDistance, triangleDistance) : triangleDistance;
+    }
+    
+    auto redetect = [&]() {
+        detectContacts();
+        
+        // 每個頂點到解析碰撞體與距離場表面的最近距離
+        m_colliderDistances.clear();
+        bool hasAnalytic = m_continuousCollision && m_continuousCollision->getColliderCount() > 0;
+        bool hasPrimitives = m_analyticColliders && m_analyticColliders->getColliderCount() > 0;
+        if (hasAnalytic || hasPrimitives || !m_sdfColliders.empty() || !m_meshColliders.empty() ||
+            !m_heightfieldColliders.empty()) {
+            m_colliderDistances.resize(m_collisionPositions.size());
+            parallelFor(static_cast<int>(m_collisionPositions.size()), m_parallelSettings, [&](int begin, int end) {
+                for (int i = begin; i < end; ++i) {
+                    float distance = hasAnalytic
+                        ? m_continuousCollision->distanceToSurface(m_collisionPositions[i])
+                        : std::numeric_limits<float>::max();
+                    for (const auto& collider : m_sdfColliders) {
+                        distance = std::min(distance, collider->distance(m_collisionPositions[i]));
+                    }
+                    for (const auto& mesh : m_meshColliders) {
+                        distance = std::min(distance, mesh->distance(m_collisionPositions[i]));
+                    }
+                    for (const auto& heightfield : m_heightfieldColliders) {
+                        distance = std::min(distance, heightfield->distance(m_collisionPositions[i]));
+                    }
+                    if (hasPrimitives) {
+                        distance = std::min(distance, m_analyticColliders->distance(m_collisionPositions[i]));
+                    }
+                    m_colliderDistances[i] = distance;
+                }
+            });
+        }
+        
+        m_displacementBounds->compute(m_collisionPositions, m_contacts, m_colliderDistances,
+                                      clothQueryDistance, m_parallelSettings);
+    };
+    
+    bool detected = false;
+    if (!m_displacementBounds->isValid()) {
+        redetect();
+        detected = true;
+    }
+    
+    // 頂點用盡位移界時，在截斷位置重新檢測並計算新界，再朝求解器目標位置繼續移動
+    m_targetPositions = m_collisionPositions;
+    for (int pass = 0; pass < m_maxBoundPasses; ++pass) {
+        if (m_displacementBounds->clamp(m_collisionPositions, m_parallelSettings) == 0) break;
+        
+        redetect();
+        detected = true;
+        if (pass + 1 < m_maxBoundPasses) {
+            m_collisionPositions = m_targetPositions;
+        }
+    }
+    
+    // 沿用的接觸按錨點位移更新穿透深度
+    m_displacementBounds->updateContactDepths(m_contacts, m_collisionPositions);
+    if (!detected) {
+        ++m_skippedDetectionCount;
+    }
+    
+    // 被截斷的頂點寫回粒子
+    for (size_t i = 0; i < m_particles.size(); ++i) {
+        if (m_collisionPositions[i] != m_targetPositions[i]) {
+            m_particles[i]->setPosition(Vec3(m_collisionPositions[i]));
+        }
+    }
+}
+
+template <typename Real>
+float BasicClothSimulation<Real>::backendColliderDistance(const glm::vec3& position) const {
+    // 連續碰撞檢測鏡像了後端的圓柱與地板
+    float distance = m_continuousCollision ? m_continuousCollision->distanceToSurface(position)
+                                           : std::numeric_limits<float>::max();
+    for (const auto& mesh : m_meshColliders) {
+        distance = std::min(distance, mesh->distance(position));
+    }
+    return distance;
+}
+
+template <typename Real>
+void BasicClothSimulation<Real>::detectContacts() {
+    // 同步粒子碰撞物件到約束求解後的位置
+    for (size_t i = 0; i < m_particleCollisionHandles.size(); ++i) {
+        m_collisionBackend->updateParticlePosition(m_particleCollisionHandles[i], m_collisionPositions[i]);
+    }
+    
+    // 執行碰撞檢測 (啟用窄帶時略過遠離碰撞體的粒子；
+    // 啟用接觸快取時略過錨點附近的靜止粒子並補回沿用接觸)
+    const std::vector<char>* skipMask = nullptr;
+    if (m_narrowBandEnabled && m_narrowBand) {
+        float contactDistance = m_particleRadius + m_collisionBackend->getContactThreshold();
+        skipMask = &m_narrowBand->update(m_collisionPositions, contactDistance, [this](const glm::vec3& position) {
+            return backendColliderDistance(position);
+        }, m_parallelSettings);
+    }
+    
+    bool useCache = m_contactCacheEnabled && m_contactCache;
+    if (useCache) {
+        const std::vector<char>& cacheMask = m_contactCache->prepare(m_collisionPositions);
+        if (skipMask) {
+            m_detectionMask.resize(cacheMask.size());
+            for (size_t i = 0; i < cacheMask.size(); ++i) {
+                m_detectionMask[i] = (*skipMask)[i] | cacheMask[i];
+            }
+            skipMask = &m_detectionMask;
+        } else {
+            skipMask = &cacheMask;
+        }
+    }
+    m_collisionBackend->performCollisionDetection(m_contacts, m_parallelSettings, skipMask);
+    if (useCache) {
+        m_contactCache->mergeNarrowphase(m_contacts, m_collisionPositions);
+    }
+    
+    // 其他靜態碰撞體的特徵編號以來源區分 (0 為碰撞後端)
+    int source = 0;
+    auto tagSource = [&](size_t begin) {
+        ++source;
+        if (useCache) ContactCache::tagSource(m_contacts, begin, source);
+    };
+    
+    // 連續碰撞：以上一步到當前位置的線段掃掠，命中者以撞擊接觸取代離散接觸
+    // 起點已在 updateParticles 中於積分前記錄
+    if (m_continuousCollisionEnabled && m_continuousCollision &&
+        m_previousCollisionPositions.size() == m_particles.size()) {
+        m_continuousCollision->detect(m_previousCollisionPositions, m_collisionPositions, m_contacts,
+                                      m_parallelSettings);
+    }
+    
+    // 距離場碰撞體 (每個粒子一次三線性查詢)
+    for (const auto& collider : m_sdfColliders) {
+        size_t begin = m_contacts.size();
+        collider->detect(m_collisionPositions, m_particleRadius, m_contacts, m_parallelSettings);
+        tagSource(begin);
+    }
+    
+    // 解析碰撞體 (每組 8 個粒子一次批次核心求值)
+    if (m_analyticColliders) {
+        size_t begin = m_contacts.size();
+        m_analyticColliders->detect(m_collisionPositions, m_particleRadius, m_contacts, m_parallelSettings);
+        tagSource(begin);
+    }
+    
+    // 高度場地形 (每個粒子一次格子查詢與雙線性插值)
+    for (const auto& heightfield : m_heightfieldColliders) {
+        size_t begin = m_contacts.size();
+        heightfield->detect(m_collisionPositions, m_particleRadius, m_contacts, m_parallelSettings);
+        tagSource(begin);
+    }
+    
+    // 布料自碰撞 (粒子-粒子接觸)
+    if (m_selfCollisionEnabled && m_selfCollision) {
+        m_selfCollision->detect(m_collisionPositions, m_contacts, m_parallelSettings);
+    }
+    
+    // 布料點-面與邊-邊接觸 (BVH 重新擬合後查詢)
+    if (m_triangleCollisionEnabled && m_clothBvh) {
+        m_clothBvh->detect(m_collisionPositions, m_ogcContactModel->getContactRadius(), m_contacts, m_parallelSettings);
+    }
+    
+    // 同一粒子的近似重複靜態接觸合併為最深接觸加平均法線
+    if (m_contactReductionEnabled) {
+        m_ogcContactModel->reduceContacts(m_contacts, static_cast<int>(m_particles.size()), m_parallelSettings);
+    }
+    
+    // 確定性模式下以固定順序處理接觸，與檢測順序無關
+    if (m_parallelSettings.deterministic) {
+        OGCContactModel::sortContacts(m_contacts);
     }
 }
 
-glm::vec3 ClothSimulation::calculateWindForce(const Particle& p1, const Particle& p2, const Particle& p3) {
-    if (glm::length(m_wind) == 0.0f) return glm::vec3(0.0f);
+template <typename Real>
+typename BasicClothSimulation<Real>::Vec3 BasicClothSimulation<Real>::calculateWindForce(
+    const ParticleType& p1, const ParticleType& p2, const ParticleType& p3) {
+    if (glm::length(m_wind) == Real(0)) return Vec3(Real(0));
     
     // 計算三角形法線
-    glm::vec3 v1 = p2.getPosition() - p1.getPosition();
-    glm::vec3 v2 = p3.getPosition() - p1.getPosition();
-    glm::vec3 normal = glm::normalize(glm::cross(v1, v2));
+    Vec3 v1 = p2.getPosition() - p1.getPosition();
+    Vec3 v2 = p3.getPosition() - p1.getPosition();
+    Vec3 normal = glm::normalize(glm::cross(v1, v2));
     
     // 計算三角形面積
-    float area = 0.5f * glm::length(glm::cross(v1, v2));
+    Real area = Real(0.5) * glm::length(glm::cross(v1, v2));
     
     // 風力與法線的點積決定風力大小
-    float windEffect = glm::dot(glm::normalize(m_wind), normal);
+    Real windEffect = glm::dot(glm::normalize(m_wind), normal);
     
     return m_wind * windEffect * area;
 }
 
+template class BasicClothSimulation<float>;
+template class BasicClothSimulation<double>;
+
 } // namespace Physics
@@ -0,0 +1,70 @@
+#include "physics/CollisionBackend.h"
+#include <algorithm>
+#include <iostream>
+
+namespace Physics {
+
+namespace {
+
+struct RegistryEntry {
+    std::string name;
+    int priority;
+    CollisionBackendRegistry::Factory factory;
+};
+
+// 函數內靜態變數，保證在各後端的靜態註冊物件之前初始化
+std::vector<RegistryEntry>& registryEntries() {
+    static std::vector<RegistryEntry> entries;
+    return entries;
+}
+
+const RegistryEntry* findEntry(const std::string& name) {
+    for (const RegistryEntry& entry : registryEntries()) {
+        if (entry.name == name) return &entry;
+    }
+    return nullptr;
+}
+
+} // namespace
+
+bool CollisionBackendRegistry::registerBackend(const std::string& name, int priority, Factory factory) {
+    if (name.empty() || !factory || findEntry(name)) return false;
+
+    std::vector<RegistryEntry>& entries = registryEntries();
+    entries.push_back({name, priority, std::move(factory)});
+
+    // 按優先級排序，同優先級按名稱，與靜態初始化順序無關
+    std::sort(entries.begin(), entries.end(), [](const RegistryEntry& a, const RegistryEntry& b) {
+        return a.priority != b.priority ? a.priority > b.priority : a.name < b.name;
+    });
+    return true;
+}
+
+std::unique_ptr<CollisionBackend> CollisionBackendRegistry::create(const std::string& name) {
+    std::string resolved = name.empty() ? getDefaultName() : name;
+    const RegistryEntry* entry = findEntry(resolved);
+    if (!entry) {
+        std::cerr << "Unknown collision backend: " << resolved << std::endl;
+        return nullptr;
+    }
+    return entry->factory();
+}
+
+bool CollisionBackendRegistry::isRegistered(const std::string& name) {
+    return findEntry(name) != nullptr;
+}
+
+std::string CollisionBackendRegistry::getDefaultName() {
+    const std::vector<RegistryEntry>& entries = registryEntries();
+    return entries.empty() ? std::string() : entries.front().name;
+}
+
+std::vector<std::string> CollisionBackendRegistry::getAvailableBackends() {
+    std::vector<std::string> names;
+    for (const RegistryEntry& entry : registryEntries()) {
+        names.push_back(entry.name);
+    }
+    return names;
+}
+
+} // namespace Physics
@@ -0,0 +1,198 @@
+#include "physics/ContactCache.h"
+#include <algorithm>
+
+namespace Physics {
+
+namespace {
+
+// featureId 中來源編號之下保留給碰撞體特徵的位數
+constexpr int kFeatureBits = 20;
+
+uint64_t mixKey(uint64_t hash, int value) {
+    hash ^= static_cast<uint64_t>(static_cast<uint32_t>(value)) + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+uint64_t contactKey(const OGCContact& contact) {
+    uint64_t key = 0xcbf29ce484222325ull;
+    key = mixKey(key, contact.particleIndexA);
+    key = mixKey(key, contact.particleIndexA1);
+    key = mixKey(key, contact.particleIndexB);
+    key = mixKey(key, contact.particleIndexB1);
+    key = mixKey(key, contact.particleIndexB2);
+    key = mixKey(key, contact.featureId);
+    return key != 0 ? key : 1;  // 0 保留給空槽
+}
+
+} // namespace
+
+ContactCache::ContactCache(float margin, int maxReuseFrames)
+    : m_margin(margin)
+    , m_maxReuseFrames(maxReuseFrames)
+    , m_reusedParticleCount(0)
+    , m_warmStartedContactCount(0)
+{
+}
+
+void ContactCache::reset() {
+    m_anchors.clear();
+    m_reuseFrames.clear();
+    m_skip.clear();
+    m_offsets.clear();
+    m_anchorContacts.clear();
+    m_keys.clear();
+    m_forces.clear(0);
+    m_reusedParticleCount = 0;
+    m_warmStartedContactCount = 0;
+}
+
+const std::vector<char>& ContactCache::prepare(const std::vector<glm::vec3>& positions) {
+    size_t particleCount = positions.size();
+    m_skip.assign(particleCount, 0);
+    m_reusedParticleCount = 0;
+
+    // 粒子數改變或尚無錨點時全部重新檢測
+    if (m_anchors.size() != particleCount || m_offsets.size() != particleCount + 1) {
+        m_anchors = positions;
+        m_reuseFrames.assign(particleCount, 0);
+        m_offsets.assign(particleCount + 1, 0);
+        m_anchorContacts.clear();
+        return m_skip;
+    }
+
+    float marginSq = m_margin * m_margin;
+    for (size_t i = 0; i < particleCount; ++i) {
+        if (m_offsets[i + 1] == m_offsets[i] || m_reuseFrames[i] >= m_maxReuseFrames) continue;
+
+        glm::vec3 displacement = positions[i] - m_anchors[i];
+        if (glm::dot(displacement, displacement) < marginSq) {
+            m_skip[i] = 1;
+            ++m_reusedParticleCount;
+        }
+    }
+    return m_skip;
+}
+
+void ContactCache::mergeNarrowphase(std::vector<OGCContact>& contacts, const std::vector<glm::vec3>& positions) {
+    int particleCount = static_cast<int>(positions.size());
+    if (m_skip.size() != positions.size()) {
+        prepare(positions);
+    }
+
+    // 1. 新的靜態接觸按粒子分組 (略過的粒子若仍有後端輸出，以快取為準)
+    m_freshOffsets.assign(particleCount + 1, 0);
+    m_otherContacts.clear();
+    for (const OGCContact& contact : contacts) {
+        if (!isStaticContact(contact, particleCount)) {
+            m_otherContacts.push_back(contact);
+        } else if (!m_skip[contact.particleIndexA]) {
+            ++m_freshOffsets[contact.particleIndexA + 1];
+        }
+    }
+    for (int i = 0; i < particleCount; ++i) {
+        m_freshOffsets[i + 1] += m_freshOffsets[i];
+    }
+    m_freshContacts.resize(m_freshOffsets[particleCount]);
+    for (const OGCContact& contact : contacts) {
+        if (isStaticContact(contact, particleCount) && !m_skip[contact.particleIndexA]) {
+            m_freshContacts[m_freshOffsets[contact.particleIndexA]++] = contact;
+        }
+    }
+    for (int i = particleCount; i > 0; --i) {
+        m_freshOffsets[i] = m_freshOffsets[i - 1];
+    }
+    m_freshOffsets[0] = 0;
+
+    // 2. 重建錨點接觸：略過的粒子保留舊錨點，其餘以當前位置為新錨點
+    m_mergedOffsets.assign(particleCount + 1, 0);
+    m_mergedContacts.clear();
+    for (int i = 0; i < particleCount; ++i) {
+        if (m_skip[i]) {
+            m_mergedContacts.insert(m_mergedContacts.end(),
+                                    m_anchorContacts.begin() + m_offsets[i],
+                                    m_anchorContacts.begin() + m_offsets[i + 1]);
+            ++m_reuseFrames[i];
+        } else {
+            m_mergedContacts.insert(m_mergedContacts.end(),
+                                    m_freshContacts.begin() + m_freshOffsets[i],
+                                    m_freshContacts.begin() + m_freshOffsets[i + 1]);
+            m_anchors[i] = positions[i];
+            m_reuseFrames[i] = 0;
+        }
+        m_mergedOffsets[i + 1] = static_cast<int>(m_mergedContacts.size());
+    }
+    m_offsets.swap(m_mergedOffsets);
+    m_anchorContacts.swap(m_mergedContacts);
+
+    // 3. 輸出：沿用接觸的深度按錨點位移沿法線更新，已分離者不輸出
+    contacts.clear();
+    for (int i = 0; i < particleCount; ++i) {
+        glm::vec3 displacement = positions[i] - m_anchors[i];
+        for (int k = m_offsets[i]; k < m_offsets[i + 1]; ++k) {
+            OGCContact contact = m_anchorContacts[k];
+            if (m_skip[i]) {
+                contact.penetrationDepth -= glm::dot(displacement, contact.contactNormal);
+                if (contact.penetrationDepth <= 0.0f) continue;
+            }
+            contacts.push_back(contact);
+        }
+    }
+    contacts.insert(contacts.end(), m_otherContacts.begin(), m_otherContacts.end());
+}
+
+void ContactCache::computeKeys(Span<const OGCContact> contacts) {
+    m_keys.resize(contacts.size());
+    m_keyCounts.clear(contacts.size());
+    for (size_t k = 0; k < contacts.size(); ++k) {
+        uint64_t key = contactKey(contacts[k]);
+        int ordinal = m_keyCounts.insert(key, 0)++;
+        if (ordinal > 0) {
+            key = mixKey(key, ordinal);
+            key = key != 0 ? key : 1;
+        }
+        m_keys[k] = key;
+    }
+}
+
+void ContactCache::warmStart(Span<OGCContact> contacts) {
+    computeKeys(contacts);
+    m_warmStartedContactCount = 0;
+    for (size_t k = 0; k < contacts.size(); ++k) {
+        const CachedForce* cached = m_forces.find(m_keys[k]);
+        if (cached) {
+            contacts[k].previousForce = cached->force;
+            ++m_warmStartedContactCount;
+        } else {
+            contacts[k].previousForce = -1.0f;
+        }
+    }
+}
+
+void ContactCache::store(Span<const OGCContact> contacts) {
+    if (m_keys.size() != contacts.size()) {
+        computeKeys(contacts);
+    }
+
+    // 本幀未出現的接觸在最大沿用幀數內保留 (短暫分離後再接觸仍可熱啟動)
+    m_nextForces.clear(m_forces.count + contacts.size());
+    for (size_t slot = 0; slot < m_forces.keys.size(); ++slot) {
+        if (m_forces.keys[slot] == 0) continue;
+        CachedForce aged = m_forces.values[slot];
+        if (++aged.age <= m_maxReuseFrames) {
+            m_nextForces.insert(m_forces.keys[slot], aged);
+        }
+    }
+    for (size_t k = 0; k < contacts.size(); ++k) {
+        m_nextForces.insert(m_keys[k], CachedForce{0.0f, 0}) = CachedForce{contacts[k].contactForce, 0};
+    }
+    std::swap(m_forces, m_nextForces);
+}
+
+void ContactCache::tagSource(Span<OGCContact> contacts, size_t begin, int source) {
+    const int featureMask = (1 << kFeatureBits) - 1;
+    for (size_t k = begin; k < contacts.size(); ++k) {
+        contacts[k].featureId = (source << kFeatureBits) | (contacts[k].featureId & featureMask);
+    }
+}
+
+} // namespace Physics
@@ -0,0 +1,202 @@
+#include "physics/ContinuousCollision.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Physics {
+
+ContinuousCollision::ContinuousCollision(float particleRadius)
+    : m_particleRadius(particleRadius)
+    , m_sweepThreshold(particleRadius)
+{
+}
+
+void ContinuousCollision::addCylinder(const glm::vec3& center, float radius, float height) {
+    m_colliders.push_back({Collider::CYLINDER, center, glm::vec3(radius, height, radius)});
+}
+
+void ContinuousCollision::addBox(const glm::vec3& center, const glm::vec3& size) {
+    m_colliders.push_back({Collider::BOX, center, size});
+}
+
+void ContinuousCollision::detect(const std::vector<glm::vec3>& previousPositions,
+                                 const std::vector<glm::vec3>& positions,
+                                 std::vector<OGCContact>& contacts, const ParallelSettings& settings) {
+    if (m_colliders.empty() || previousPositions.size() != positions.size()) return;
+
+    int particleCount = static_cast<int>(positions.size());
+    m_impacts.resize(particleCount);
+    m_hasImpact.assign(particleCount, 0);
+
+    float sweepThresholdSq = m_sweepThreshold * m_sweepThreshold;
+
+    // 1. 每個粒子獨立求最早撞擊
+    parallelFor(particleCount, settings, [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            const glm::vec3& start = previousPositions[i];
+            glm::vec3 delta = positions[i] - start;
+            if (glm::dot(delta, delta) <= sweepThresholdSq) continue;
+
+            float earliest = std::numeric_limits<float>::max();
+            glm::vec3 earliestNormal(0.0f, 1.0f, 0.0f);
+            for (const Collider& collider : m_colliders) {
+                float toi;
+                glm::vec3 normal;
+                bool hit = collider.type == Collider::CYLINDER
+                    ? sweepCylinder(start, delta, collider, toi, normal)
+                    : sweepBox(start, delta, collider, toi, normal);
+                if (hit && toi < earliest) {
+                    earliest = toi;
+                    earliestNormal = normal;
+                }
+            }
+            if (earliest > 1.0f) continue;
+
+            // 撞擊時粒子球心距表面恰為半徑；深度為當前位置需沿法線退回的距離
+            glm::vec3 impactCenter = start + earliest * delta;
+
+            OGCContact& contact = m_impacts[i];
+            contact = OGCContact();
+            contact.particleIndexA = i;
+            contact.particleIndexB = -1;
+            contact.contactPoint = impactCenter - m_particleRadius * earliestNormal;
+            contact.contactNormal = earliestNormal;
+            contact.penetrationDepth = std::max(0.0f, glm::dot(impactCenter - positions[i], earliestNormal));
+            contact.timeOfImpact = earliest;
+            m_hasImpact[i] = 1;
+        }
+    });
+
+    // 2. 移除命中粒子的離散靜態接觸 (穿透後的最近面法線可能指向錯誤一側)
+    contacts.erase(std::remove_if(contacts.begin(), contacts.end(), [&](const OGCContact& contact) {
+        return contact.particleIndexB < 0 && !contact.isStencilContact() &&
+               contact.particleIndexA >= 0 && contact.particleIndexA < particleCount &&
+               m_hasImpact[contact.particleIndexA];
+    }), contacts.end());
+
+    // 3. 按粒子順序追加 TOI 接觸
+    for (int i = 0; i < particleCount; ++i) {
+        if (m_hasImpact[i]) {
+            contacts.push_back(m_impacts[i]);
+        }
+    }
+}
+
+float ContinuousCollision::distanceToSurface(const glm::vec3& position) const {
+    float nearest = std::numeric_limits<float>::max();
+
+    for (const Collider& collider : m_colliders) {
+        float distance;
+        if (collider.type == Collider::CYLINDER) {
+            glm::vec2 offset(position.x - collider.center.x, position.z - collider.center.z);
+            float radial = glm::length(offset) - collider.size.x;
+            float vertical = std::abs(position.y - collider.center.y) - collider.size.y * 0.5f;
+            distance = std::min(std::max(radial, vertical), 0.0f) +
+                       glm::length(glm::vec2(std::max(radial, 0.0f), std::max(vertical, 0.0f)));
+        } else {
+            glm::vec3 q = glm::abs(position - collider.center) - collider.size * 0.5f;
+            distance = std::min(std::max(q.x, std::max(q.y, q.z)), 0.0f) + glm::length(glm::max(q, glm::vec3(0.0f)));
+        }
+        nearest = std::min(nearest, distance);
+    }
+
+    return nearest;
+}
+
+bool ContinuousCollision::sweepCylinder(const glm::vec3& start, const glm::vec3& delta,
+                                        const Collider& collider, float& toi, glm::vec3& normal) const {
+    float radius = collider.size.x + m_particleRadius;
+    float yMin = collider.center.y - collider.size.y * 0.5f - m_particleRadius;
+    float yMax = collider.center.y + collider.size.y * 0.5f + m_particleRadius;
+
+    glm::vec2 offset(start.x - collider.center.x, start.z - collider.center.z);
+    glm::vec2 direction(delta.x, delta.z);
+    float radiusSq = radius * radius;
+
+    // 起點已在膨脹圓柱內，交由離散檢測處理
+    if (glm::dot(offset, offset) <= radiusSq && start.y >= yMin && start.y <= yMax) return false;
+
+    bool hit = false;
+    toi = std::numeric_limits<float>::max();
+
+    // 側面：|offset + t * direction|^2 = radius^2 的進入根
+    float a = glm::dot(direction, direction);
+    if (a > 1e-12f) {
+        float b = glm::dot(offset, direction);
+        float c = glm::dot(offset, offset) - radiusSq;
+        float discriminant = b * b - a * c;
+        if (discriminant >= 0.0f) {
+            float t = (-b - std::sqrt(discriminant)) / a;
+            float y = start.y + t * delta.y;
+            if (t >= 0.0f && t <= 1.0f && y >= yMin && y <= yMax) {
+                glm::vec2 radial = (offset + t * direction) / radius;
+                toi = t;
+                normal = glm::vec3(radial.x, 0.0f, radial.y);
+                hit = true;
+            }
+        }
+    }
+
+    // 頂面與底面
+    if (std::abs(delta.y) > 1e-12f) {
+        float capY = delta.y < 0.0f ? yMax : yMin;
+        float t = (capY - start.y) / delta.y;
+        if (t >= 0.0f && t <= 1.0f && t < toi) {
+            glm::vec2 p = offset + t * direction;
+            if (glm::dot(p, p) <= radiusSq) {
+                toi = t;
+                normal = glm::vec3(0.0f, delta.y < 0.0f ? 1.0f : -1.0f, 0.0f);
+                hit = true;
+            }
+        }
+    }
+
+    return hit;
+}
+
+bool ContinuousCollision::sweepBox(const glm::vec3& start, const glm::vec3& delta,
+                                   const Collider& collider, float& toi, glm::vec3& normal) const {
+    // 以盒子膨脹粒子半徑近似 Minkowski 和 (角落處略為保守)
+    glm::vec3 halfSize = collider.size * 0.5f + glm::vec3(m_particleRadius);
+    glm::vec3 boxMin = collider.center - halfSize;
+    glm::vec3 boxMax = collider.center + halfSize;
+
+    float tEnter = -std::numeric_limits<float>::max();
+    float tExit = std::numeric_limits<float>::max();
+    int enterAxis = -1;
+    float enterSign = 0.0f;
+
+    for (int axis = 0; axis < 3; ++axis) {
+        if (std::abs(delta[axis]) < 1e-12f) {
+            if (start[axis] < boxMin[axis] || start[axis] > boxMax[axis]) return false;
+            continue;
+        }
+
+        float inverse = 1.0f / delta[axis];
+        float t0 = (boxMin[axis] - start[axis]) * inverse;
+        float t1 = (boxMax[axis] - start[axis]) * inverse;
+        float sign = -1.0f;     // 從最小面進入時法線朝負方向
+        if (t0 > t1) {
+            std::swap(t0, t1);
+            sign = 1.0f;
+        }
+
+        if (t0 > tEnter) {
+            tEnter = t0;
+            enterAxis = axis;
+            enterSign = sign;
+        }
+        tExit = std::min(tExit, t1);
+        if (tEnter > tExit) return false;
+    }
+
+    // 起點在盒子內 (tEnter < 0) 或本步未到達
+    if (enterAxis < 0 || tEnter < 0.0f || tEnter > 1.0f) return false;
+
+    toi = tEnter;
+    normal = glm::vec3(0.0f);
+    normal[enterAxis] = enterSign;
+    return true;
+}
+
+} // namespace Physics
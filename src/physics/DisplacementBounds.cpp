@@ -0,0 +1,108 @@
+#include "physics/DisplacementBounds.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Physics {
+
+DisplacementBounds::DisplacementBounds(float relaxation)
+    : m_relaxation(relaxation)
+    , m_valid(false)
+{
+}
+
+void DisplacementBounds::compute(const std::vector<glm::vec3>& positions, const std::vector<OGCContact>& contacts,
+                                 const std::vector<float>& colliderDistances, float clothQueryDistance,
+                                 const ParallelSettings& settings) {
+    int vertexCount = static_cast<int>(positions.size());
+    m_anchors = positions;
+    m_bounds.resize(vertexCount);
+    m_clamped.assign(vertexCount, 0);
+
+    // 1. 到靜態碰撞體表面的距離，以及布料查詢距離 (查詢範圍外的布料幾何至少這麼遠)
+    parallelFor(vertexCount, settings, [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            float distance = std::numeric_limits<float>::max();
+            if (!colliderDistances.empty()) {
+                distance = std::max(0.0f, colliderDistances[i]);
+            }
+            if (clothQueryDistance > 0.0f) {
+                distance = std::min(distance, clothQueryDistance);
+            }
+            m_bounds[i] = distance;
+        }
+    });
+
+    // 2. 接觸集中的布料幾何：參與接觸的每個頂點取該接觸的分離距離
+    m_referenceDepths.resize(contacts.size());
+    for (size_t k = 0; k < contacts.size(); ++k) {
+        const OGCContact& contact = contacts[k];
+        m_referenceDepths[k] = contact.penetrationDepth;
+        if (contact.particleIndexB < 0 && !contact.isStencilContact()) continue;
+
+        float separation = std::max(0.0f, contact.contactRadius - contact.penetrationDepth);
+        const int indices[5] = {contact.particleIndexA, contact.particleIndexA1, contact.particleIndexB,
+                                contact.particleIndexB1, contact.particleIndexB2};
+        for (int index : indices) {
+            if (index >= 0 && index < vertexCount) {
+                m_bounds[index] = std::min(m_bounds[index], separation);
+            }
+        }
+    }
+
+    // 3. 位移界 = 鬆弛係數 * 距離
+    for (int i = 0; i < vertexCount; ++i) {
+        if (m_bounds[i] < std::numeric_limits<float>::max()) {
+            m_bounds[i] *= m_relaxation;
+        }
+    }
+
+    m_valid = true;
+}
+
+int DisplacementBounds::clamp(std::vector<glm::vec3>& positions, const ParallelSettings& settings) {
+    if (!m_valid || positions.size() != m_anchors.size()) return 0;
+
+    int vertexCount = static_cast<int>(positions.size());
+    parallelFor(vertexCount, settings, [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            glm::vec3 displacement = positions[i] - m_anchors[i];
+            float lengthSq = glm::dot(displacement, displacement);
+            float bound = m_bounds[i];
+
+            m_clamped[i] = lengthSq > bound * bound;
+            if (m_clamped[i]) {
+                positions[i] = m_anchors[i] + displacement * (bound / std::sqrt(lengthSq));
+            }
+        }
+    });
+
+    int clampedCount = 0;
+    for (char clamped : m_clamped) {
+        clampedCount += clamped;
+    }
+    return clampedCount;
+}
+
+void DisplacementBounds::updateContactDepths(std::vector<OGCContact>& contacts,
+                                             const std::vector<glm::vec3>& positions) const {
+    if (!m_valid || contacts.size() != m_referenceDepths.size()) return;
+
+    auto displacement = [&](int index) { return positions[index] - m_anchors[index]; };
+
+    for (size_t k = 0; k < contacts.size(); ++k) {
+        OGCContact& contact = contacts[k];
+        if (contact.particleIndexA < 0) continue;
+
+        // 兩側加權位移之差沿法線的分量即分離量的變化
+        glm::vec3 relative = contact.weightsA.x * displacement(contact.particleIndexA);
+        if (contact.particleIndexA1 >= 0) relative += contact.weightsA.y * displacement(contact.particleIndexA1);
+        if (contact.particleIndexB >= 0) relative -= contact.weightsB.x * displacement(contact.particleIndexB);
+        if (contact.particleIndexB1 >= 0) relative -= contact.weightsB.y * displacement(contact.particleIndexB1);
+        if (contact.particleIndexB2 >= 0) relative -= contact.weightsB.z * displacement(contact.particleIndexB2);
+
+        contact.penetrationDepth = m_referenceDepths[k] - glm::dot(relative, contact.contactNormal);
+    }
+}
+
+} // namespace Physics
@@ -0,0 +1,102 @@
+#include "physics/FramePacer.h"
+#include <algorithm>
+
+namespace Physics {
+
+namespace {
+
+// 成本平均的平滑係數與兩次迭代數調整之間的最少子步數
+constexpr double kCostSmoothing = 0.1;
+constexpr int kAdjustInterval = 30;
+
+} // namespace
+
+FrameTimeStats::FrameTimeStats(int capacity)
+    : m_samples(std::max(1, capacity), 0.0)
+    , m_count(0)
+    , m_next(0)
+{
+}
+
+void FrameTimeStats::record(double seconds) {
+    m_samples[m_next] = seconds;
+    m_next = (m_next + 1) % static_cast<int>(m_samples.size());
+    m_count = std::min(m_count + 1, static_cast<int>(m_samples.size()));
+}
+
+FrameTimeStats::Summary FrameTimeStats::summarize() const {
+    Summary summary;
+    summary.samples = m_count;
+    if (m_count == 0) return summary;
+
+    m_sorted.assign(m_samples.begin(), m_samples.begin() + m_count);
+    std::sort(m_sorted.begin(), m_sorted.end());
+
+    // 最近秩 (nearest-rank) 百分位數
+    auto percentile = [&](double p) {
+        int rank = static_cast<int>(p * m_count + 0.999999) - 1;
+        return m_sorted[std::min(std::max(rank, 0), m_count - 1)];
+    };
+    summary.p50 = percentile(0.50);
+    summary.p95 = percentile(0.95);
+    summary.p99 = percentile(0.99);
+    summary.max = m_sorted.back();
+    return summary;
+}
+
+FramePacer::FramePacer(double fixedTimeStep, int maxSubsteps, double budgetFraction)
+    : m_fixedTimeStep(fixedTimeStep)
+    , m_maxSubsteps(std::max(1, maxSubsteps))
+    , m_budgetFraction(budgetFraction)
+    , m_accumulator(0.0)
+    , m_averageStepCost(0.0)
+    , m_droppedTime(0.0)
+    , m_cappedFrameCount(0)
+    , m_stepsSinceAdjust(0)
+{
+}
+
+int FramePacer::advance(double elapsedSeconds) {
+    m_accumulator += std::max(0.0, elapsedSeconds);
+
+    int substeps = static_cast<int>(m_accumulator / m_fixedTimeStep);
+    if (substeps > m_maxSubsteps) {
+        // 超出上限的時間直接丟棄，只保留不足一步的餘數
+        double kept = m_maxSubsteps * m_fixedTimeStep;
+        double remainder = m_accumulator - substeps * m_fixedTimeStep;
+        m_droppedTime += m_accumulator - kept - remainder;
+        m_accumulator = kept + remainder;
+        substeps = m_maxSubsteps;
+        ++m_cappedFrameCount;
+    }
+
+    m_accumulator -= substeps * m_fixedTimeStep;
+    return substeps;
+}
+
+void FramePacer::recordStepCost(double seconds) {
+    m_averageStepCost = m_stepStats.getSampleCount() == 0
+        ? seconds
+        : m_averageStepCost + kCostSmoothing * (seconds - m_averageStepCost);
+    m_stepStats.record(seconds);
+    ++m_stepsSinceAdjust;
+}
+
+int FramePacer::adjustIterations(int currentIterations, int minIterations, int maxIterations) {
+    if (m_stepsSinceAdjust < kAdjustInterval) return currentIterations;
+
+    double budget = m_budgetFraction * m_fixedTimeStep;
+    int iterations = currentIterations;
+    if (m_averageStepCost > budget && iterations > minIterations) {
+        --iterations;
+    } else if (m_averageStepCost < 0.5 * budget && iterations < maxIterations) {
+        ++iterations;
+    }
+
+    if (iterations != currentIterations) {
+        m_stepsSinceAdjust = 0;
+    }
+    return iterations;
+}
+
+} // namespace Physics
@@ -0,0 +1,160 @@
+#include "physics/HeightfieldCollider.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+namespace Physics {
+
+namespace {
+
+// 批次查詢寬度 (一組 SoA 暫存)
+constexpr int kQueryWidth = 8;
+
+// 接觸檢測時每個區塊包含的粒子數
+constexpr int kDetectBlockSize = 256;
+
+} // namespace
+
+HeightfieldCollider::HeightfieldCollider()
+    : m_origin(0.0f)
+    , m_columns(0)
+    , m_rows(0)
+    , m_cellSize(1.0f)
+{
+}
+
+bool HeightfieldCollider::build(const std::vector<float>& heights, int columns, int rows,
+                                const glm::vec3& origin, float cellSize) {
+    if (columns < 2 || rows < 2 || cellSize <= 0.0f ||
+        heights.size() != static_cast<size_t>(columns) * rows) {
+        std::cerr << "Invalid heightfield: " << columns << "x" << rows << " samples, "
+                  << heights.size() << " heights" << std::endl;
+        return false;
+    }
+
+    m_origin = origin;
+    m_columns = columns;
+    m_rows = rows;
+    m_cellSize = cellSize;
+    m_heights.resize(heights.size());
+    for (size_t i = 0; i < heights.size(); ++i) {
+        m_heights[i] = origin.y + heights[i];
+    }
+    return true;
+}
+
+void HeightfieldCollider::query(const glm::vec3* positions, int count, float* heights, glm::vec3* normals) const {
+    float inverseCell = 1.0f / m_cellSize;
+    float maxX = static_cast<float>(m_columns - 1);
+    float maxZ = static_cast<float>(m_rows - 1);
+    size_t stride = static_cast<size_t>(m_columns);
+
+    for (int base = 0; base < count; base += kQueryWidth) {
+        int width = std::min(kQueryWidth, count - base);
+
+        // SoA 暫存：插值分數、範圍旗標與四個角的樣本
+        float fx[kQueryWidth], fz[kQueryWidth];
+        float inside[kQueryWidth];
+        size_t corner[kQueryWidth];
+        float h00[kQueryWidth], h10[kQueryWidth], h01[kQueryWidth], h11[kQueryWidth];
+
+        for (int k = 0; k < width; ++k) {
+            float x = (positions[base + k].x - m_origin.x) * inverseCell;
+            float z = (positions[base + k].z - m_origin.z) * inverseCell;
+            inside[k] = (x >= 0.0f && x <= maxX && z >= 0.0f && z <= maxZ) ? 1.0f : 0.0f;
+
+            // 範圍外的查詢夾到邊界，保持讀取合法，結果稍後丟棄
+            x = std::min(std::max(x, 0.0f), maxX);
+            z = std::min(std::max(z, 0.0f), maxZ);
+            float cellX = std::min(std::floor(x), maxX - 1.0f);
+            float cellZ = std::min(std::floor(z), maxZ - 1.0f);
+            fx[k] = x - cellX;
+            fz[k] = z - cellZ;
+            corner[k] = static_cast<size_t>(cellZ) * stride + static_cast<size_t>(cellX);
+        }
+
+        for (int k = 0; k < width; ++k) {
+            size_t i = corner[k];
+            h00[k] = m_heights[i];
+            h10[k] = m_heights[i + 1];
+            h01[k] = m_heights[i + stride];
+            h11[k] = m_heights[i + stride + 1];
+        }
+
+        for (int k = 0; k < width; ++k) {
+            float x = fx[k], z = fz[k];
+
+            // 先沿 x 插值，再沿 z
+            float h0 = h00[k] + x * (h10[k] - h00[k]);
+            float h1 = h01[k] + x * (h11[k] - h01[k]);
+            float height = h0 + z * (h1 - h0);
+
+            // 雙線性插值的解析斜率，法線為 (-dh/dx, 1, -dh/dz) 正規化
+            float slopeX = ((h10[k] - h00[k]) + z * ((h11[k] - h01[k]) - (h10[k] - h00[k]))) * inverseCell;
+            float slopeZ = (h1 - h0) * inverseCell;
+            float inverseLength = 1.0f / std::sqrt(slopeX * slopeX + slopeZ * slopeZ + 1.0f);
+
+            heights[base + k] = inside[k] > 0.0f ? height : -std::numeric_limits<float>::max();
+            normals[base + k] = glm::vec3(-slopeX * inverseLength, inverseLength, -slopeZ * inverseLength);
+        }
+    }
+}
+
+void HeightfieldCollider::detect(const std::vector<glm::vec3>& positions, float particleRadius,
+                                 std::vector<OGCContact>& contacts, const ParallelSettings& settings) {
+    if (!isValid()) return;
+
+    int particleCount = static_cast<int>(positions.size());
+    int blockCount = (particleCount + kDetectBlockSize - 1) / kDetectBlockSize;
+    m_blockContacts.resize(blockCount);
+
+    ParallelSettings blockSettings(settings.threadCount, settings.deterministic, 1);
+    parallelFor(blockCount, blockSettings, [&](int blockBegin, int blockEnd) {
+        float heights[kDetectBlockSize];
+        glm::vec3 normals[kDetectBlockSize];
+
+        for (int block = blockBegin; block < blockEnd; ++block) {
+            std::vector<OGCContact>& blockContacts = m_blockContacts[block];
+            blockContacts.clear();
+
+            int begin = block * kDetectBlockSize;
+            int count = std::min(kDetectBlockSize, particleCount - begin);
+            query(positions.data() + begin, count, heights, normals);
+
+            for (int k = 0; k < count; ++k) {
+                if (heights[k] == -std::numeric_limits<float>::max()) continue;
+
+                // 垂直間隙投影到法線上，即到局部切平面的距離
+                const glm::vec3& position = positions[begin + k];
+                float distance = (position.y - heights[k]) * normals[k].y;
+                if (distance >= particleRadius) continue;
+
+                OGCContact contact;
+                contact.particleIndexA = begin + k;
+                contact.particleIndexB = -1;
+                contact.contactPoint = position - distance * normals[k];
+                contact.contactNormal = normals[k];
+                contact.penetrationDepth = particleRadius - distance;
+                blockContacts.push_back(contact);
+            }
+        }
+    });
+
+    // 按區塊順序壓實合併
+    compactBlocks(m_blockContacts, contacts, settings);
+}
+
+float HeightfieldCollider::distance(const glm::vec3& position) const {
+    if (!isValid()) return std::numeric_limits<float>::max();
+
+    float height;
+    glm::vec3 normal;
+    query(&position, 1, &height, &normal);
+    if (height == -std::numeric_limits<float>::max()) {
+        return std::numeric_limits<float>::max();
+    }
+    return (position.y - height) * normal.y;
+}
+
+} // namespace Physics
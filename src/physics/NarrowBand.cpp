@@ -0,0 +1,151 @@
+#include "physics/NarrowBand.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Physics {
+
+NarrowBand::NarrowBand(float slack, int clusterSize)
+    : m_slack(slack)
+    , m_clusterSize(std::max(1, clusterSize))
+    , m_gridWidth(0)
+    , m_gridHeight(0)
+    , m_candidateCount(0)
+    , m_rebuiltClusterCount(0)
+    , m_culledClusterCount(0)
+    , m_bandDistance(0.0f)
+{
+}
+
+void NarrowBand::setGridTopology(int width, int height) {
+    m_gridWidth = width;
+    m_gridHeight = height;
+    m_clusterOffsets.clear();
+    m_clusterParticles.clear();
+    reset();
+}
+
+void NarrowBand::buildClusters(int particleCount) {
+    m_clusterOffsets.assign(1, 0);
+    m_clusterParticles.clear();
+    m_clusterParticles.reserve(particleCount);
+
+    if (m_gridWidth > 0 && m_gridHeight > 0 && m_gridWidth * m_gridHeight == particleCount) {
+        // 格子塊：相鄰粒子在空間上也相鄰，包圍球較緊
+        for (int tileY = 0; tileY < m_gridHeight; tileY += m_clusterSize) {
+            for (int tileX = 0; tileX < m_gridWidth; tileX += m_clusterSize) {
+                int endY = std::min(tileY + m_clusterSize, m_gridHeight);
+                int endX = std::min(tileX + m_clusterSize, m_gridWidth);
+                for (int y = tileY; y < endY; ++y) {
+                    for (int x = tileX; x < endX; ++x) {
+                        m_clusterParticles.push_back(y * m_gridWidth + x);
+                    }
+                }
+                m_clusterOffsets.push_back(static_cast<int>(m_clusterParticles.size()));
+            }
+        }
+    } else {
+        int chunk = m_clusterSize * m_clusterSize;
+        for (int begin = 0; begin < particleCount; begin += chunk) {
+            int end = std::min(begin + chunk, particleCount);
+            for (int i = begin; i < end; ++i) {
+                m_clusterParticles.push_back(i);
+            }
+            m_clusterOffsets.push_back(end);
+        }
+    }
+}
+
+bool NarrowBand::rebuildCluster(int cluster, const std::vector<glm::vec3>& positions, float bandDistance,
+                                const DistanceFn& distance) {
+    int begin = m_clusterOffsets[cluster];
+    int end = m_clusterOffsets[cluster + 1];
+
+    // 包圍球：AABB 中心與最遠粒子距離
+    glm::vec3 boundsMin = positions[m_clusterParticles[begin]];
+    glm::vec3 boundsMax = boundsMin;
+    for (int k = begin + 1; k < end; ++k) {
+        boundsMin = glm::min(boundsMin, positions[m_clusterParticles[k]]);
+        boundsMax = glm::max(boundsMax, positions[m_clusterParticles[k]]);
+    }
+    glm::vec3 center = 0.5f * (boundsMin + boundsMax);
+    float radiusSq = 0.0f;
+    for (int k = begin; k < end; ++k) {
+        glm::vec3 offset = positions[m_clusterParticles[k]] - center;
+        radiusSq = std::max(radiusSq, glm::dot(offset, offset));
+    }
+
+    for (int k = begin; k < end; ++k) {
+        int particle = m_clusterParticles[k];
+        m_anchors[particle] = positions[particle];
+    }
+
+    // 整簇剔除：球內任一點的距離至少為 D - 半徑
+    if (distance(center) - std::sqrt(radiusSq) >= bandDistance) {
+        for (int k = begin; k < end; ++k) {
+            m_skip[m_clusterParticles[k]] = 1;
+        }
+        m_clusterCandidates[cluster] = 0;
+        return true;
+    }
+
+    int candidates = 0;
+    for (int k = begin; k < end; ++k) {
+        int particle = m_clusterParticles[k];
+        bool inBand = distance(positions[particle]) < bandDistance;
+        m_skip[particle] = inBand ? 0 : 1;
+        candidates += inBand ? 1 : 0;
+    }
+    m_clusterCandidates[cluster] = candidates;
+    return false;
+}
+
+const std::vector<char>& NarrowBand::update(const std::vector<glm::vec3>& positions, float contactDistance,
+                                            const DistanceFn& distance, const ParallelSettings& settings) {
+    int particleCount = static_cast<int>(positions.size());
+    if (m_clusterParticles.size() != positions.size()) {
+        buildClusters(particleCount);
+        m_anchors.clear();
+    }
+
+    // 粒子數或接觸距離改變時全部重建
+    float bandDistance = contactDistance + m_slack;
+    bool rebuildAll = m_anchors.size() != positions.size() || bandDistance != m_bandDistance;
+    if (rebuildAll) {
+        m_anchors.resize(particleCount);
+        m_skip.assign(particleCount, 0);
+        m_bandDistance = bandDistance;
+    }
+
+    int clusterCount = getClusterCount();
+    m_clusterCandidates.resize(clusterCount);
+    m_clusterState.assign(clusterCount, 0);
+
+    // 每個簇只寫入自己的粒子，可按簇平行
+    float slackSq = m_slack * m_slack;
+    ParallelSettings clusterSettings(settings.threadCount, settings.deterministic, 16);
+    parallelFor(clusterCount, clusterSettings, [&](int clusterBegin, int clusterEnd) {
+        for (int cluster = clusterBegin; cluster < clusterEnd; ++cluster) {
+            bool moved = rebuildAll;
+            for (int k = m_clusterOffsets[cluster]; !moved && k < m_clusterOffsets[cluster + 1]; ++k) {
+                int particle = m_clusterParticles[k];
+                glm::vec3 displacement = positions[particle] - m_anchors[particle];
+                moved = glm::dot(displacement, displacement) > slackSq;
+            }
+            if (!moved) continue;
+
+            m_clusterState[cluster] = rebuildCluster(cluster, positions, bandDistance, distance) ? 2 : 1;
+        }
+    });
+
+    m_candidateCount = 0;
+    m_rebuiltClusterCount = 0;
+    m_culledClusterCount = 0;
+    for (int cluster = 0; cluster < clusterCount; ++cluster) {
+        m_candidateCount += m_clusterCandidates[cluster];
+        m_rebuiltClusterCount += m_clusterState[cluster] != 0 ? 1 : 0;
+        m_culledClusterCount += m_clusterState[cluster] == 2 ? 1 : 0;
+    }
+    return m_skip;
+}
+
+} // namespace Physics
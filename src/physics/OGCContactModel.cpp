@@ -2,31 +2,430 @@
 #include "physics/Particle.h"
 #include <algorithm>
 #include <cmath>
+#include <tuple>
 
 namespace Physics {
 
+namespace {
+
+// 接觸力核心一次處理的接觸數
+constexpr int kLaneCount = 8;
+
+/**
+ * @brief 8 個接觸的 SoA 通道 (法線、深度、相對速度、上一幀力與輸出)
+ *
+ * 通道在堆疊上逐批收集，而非在接觸列表中常駐 SoA 陣列：此階段的成本以按粒子
+ * 收集相對速度為主，而排序、快取與逐粒子累加都讀 AoS，常駐陣列需要額外的填入與寫回。
+ */
+struct ContactLanes {
+    float normalX[kLaneCount];
+    float normalY[kLaneCount];
+    float normalZ[kLaneCount];
+    float depth[kLaneCount];
+    float velocityX[kLaneCount];
+    float velocityY[kLaneCount];
+    float velocityZ[kLaneCount];
+    float previousForce[kLaneCount];
+    float offsetX[kLaneCount];
+    float offsetY[kLaneCount];
+    float offsetZ[kLaneCount];
+    float force[kLaneCount];
+};
+
+/**
+ * @brief 偏移幾何與彈簧-阻尼接觸力的 8 通道核心
+ *
+ * 與 calculateOffsetGeometry / calculateContactForce 逐位相同的算式，
+ * 分支改為選擇以便編譯器向量化。
+ */
+void contactForceKernel(ContactLanes& lanes, float contactRadius, float stiffness, float damping,
+                        float warmStartFactor) {
+    for (int k = 0; k < kLaneCount; ++k) {
+        float nx = lanes.normalX[k];
+        float ny = lanes.normalY[k];
+        float nz = lanes.normalZ[k];
+        float depth = lanes.depth[k];
+        
+        // 偏移幾何 = 接觸半徑 * 法線 (+ 穿透時額外的半個深度)；兩側先算再選擇，避免分支
+        float additionalOffset = depth * 0.5f;
+        additionalOffset = depth > 0.0f ? additionalOffset : 0.0f;
+        float ox = contactRadius * nx + additionalOffset * nx;
+        float oy = contactRadius * ny + additionalOffset * ny;
+        float oz = contactRadius * nz + additionalOffset * nz;
+        lanes.offsetX[k] = ox;
+        lanes.offsetY[k] = oy;
+        lanes.offsetZ[k] = oz;
+        
+        float offsetLength = std::sqrt(ox * ox + oy * oy + oz * oz);
+        float springForce = stiffness * (depth + offsetLength);
+        springForce = depth > 0.0f ? springForce : 0.0f;
+        
+        float normalVelocity = lanes.velocityX[k] * nx + lanes.velocityY[k] * ny + lanes.velocityZ[k] * nz;
+        float force = springForce - damping * normalVelocity;
+        force = force > 0.0f ? force : 0.0f;
+        
+        // 熱啟動權重為 0 時混合結果即為新力
+        float previous = lanes.previousForce[k];
+        float blended = warmStartFactor * previous + (1.0f - warmStartFactor) * force;
+        lanes.force[k] = previous >= 0.0f ? blended : force;
+    }
+}
+
+/**
+ * @brief 遍歷接觸兩側的粒子及其有向權重 (A側為正，B側為負)
+ */
+template <typename Fn>
+void forEachStencilParticle(const OGCContact& contact, Fn&& fn) {
+    fn(contact.particleIndexA, contact.weightsA.x);
+    if (contact.particleIndexA1 >= 0) fn(contact.particleIndexA1, contact.weightsA.y);
+    if (contact.particleIndexB >= 0) fn(contact.particleIndexB, -contact.weightsB.x);
+    if (contact.particleIndexB1 >= 0) fn(contact.particleIndexB1, -contact.weightsB.y);
+    if (contact.particleIndexB2 >= 0) fn(contact.particleIndexB2, -contact.weightsB.z);
+}
+
+/**
+ * @brief 遍歷接觸兩側的粒子及其槽位 (0: A, 1: A1, 2: B, 3: B1, 4: B2)
+ */
+template <typename Fn>
+void forEachStencilSlot(const OGCContact& contact, Fn&& fn) {
+    fn(contact.particleIndexA, 0);
+    if (contact.particleIndexA1 >= 0) fn(contact.particleIndexA1, 1);
+    if (contact.particleIndexB >= 0) fn(contact.particleIndexB, 2);
+    if (contact.particleIndexB1 >= 0) fn(contact.particleIndexB1, 3);
+    if (contact.particleIndexB2 >= 0) fn(contact.particleIndexB2, 4);
+}
+
+int slotParticle(const OGCContact& contact, int slot) {
+    switch (slot) {
+        case 0: return contact.particleIndexA;
+        case 1: return contact.particleIndexA1;
+        case 2: return contact.particleIndexB;
+        case 3: return contact.particleIndexB1;
+        default: return contact.particleIndexB2;
+    }
+}
+
+/**
+ * @brief 槽位的有向權重 (與 forEachStencilParticle 一致)
+ */
+float slotWeight(const OGCContact& contact, int slot) {
+    switch (slot) {
+        case 0: return contact.weightsA.x;
+        case 1: return contact.weightsA.y;
+        case 2: return -contact.weightsB.x;
+        case 3: return -contact.weightsB.y;
+        default: return -contact.weightsB.z;
+    }
+}
+
+} // namespace
+
 OGCContactModel::OGCContactModel(float contactRadius, float stiffness, float damping)
     : m_contactRadius(contactRadius)
     , m_stiffness(stiffness)
     , m_damping(damping)
     , m_positionCorrectionFactor(0.8f)
+    , m_warmStartFactor(0.5f)
+    , m_reductionBudget(3)
+    , m_reductionCosine(0.9f)
+    , m_reducedContactCount(0)
 {
 }
 
-void OGCContactModel::processContacts(std::vector<OGCContact>& contacts, float deltaTime) {
-    for (auto& contact : contacts) {
-        // 1. 計算OGC偏移幾何
-        contact.offsetGeometry = calculateOffsetGeometry(contact);
-        
-        // 2. 計算接觸力
-        calculateContactForce(contact, deltaTime);
+template <typename Real>
+void OGCContactModel::processContacts(Span<OGCContact> contacts, ParticleList<Real>& particles,
+                                      float deltaTime, const ParallelSettings& settings) {
+    // 1-2. 計算OGC偏移幾何和接觸力 (每個接觸獨立，可平行；每 8 個接觸轉為 SoA 通道批次求值)
+    parallelFor(static_cast<int>(contacts.size()), settings, [&](int begin, int end) {
+        ContactLanes lanes;
+        for (int base = begin; base < end; base += kLaneCount) {
+            int width = std::min(kLaneCount, end - base);
+            
+            // 收集：相對速度需按粒子索引讀取，不足 8 個時以最後一個接觸填滿
+            for (int k = 0; k < kLaneCount; ++k) {
+                const OGCContact& contact = contacts[base + std::min(k, width - 1)];
+                glm::vec3 relativeVelocity = calculateRelativeVelocity(contact, particles);
+                lanes.normalX[k] = contact.contactNormal.x;
+                lanes.normalY[k] = contact.contactNormal.y;
+                lanes.normalZ[k] = contact.contactNormal.z;
+                lanes.depth[k] = contact.penetrationDepth;
+                lanes.velocityX[k] = relativeVelocity.x;
+                lanes.velocityY[k] = relativeVelocity.y;
+                lanes.velocityZ[k] = relativeVelocity.z;
+                lanes.previousForce[k] = contact.previousForce;
+            }
+            
+            contactForceKernel(lanes, m_contactRadius, m_stiffness, m_damping, m_warmStartFactor);
+            
+            for (int k = 0; k < width; ++k) {
+                OGCContact& contact = contacts[base + k];
+                contact.offsetGeometry = glm::vec3(lanes.offsetX[k], lanes.offsetY[k], lanes.offsetZ[k]);
+                if (contact.particleIndexA < 0) continue;
+                contact.contactForce = lanes.force[k];
+                contact.forceDirection = contact.contactNormal;
+            }
+        }
+    });
+    
+    // 3-4. 應用OGC接觸力並執行位置修正
+    if (settings.threadCount <= 1) {
+        // 單執行緒：按接觸順序串行累加
+        for (auto& contact : contacts) {
+            applyOGCForce(contact, particles, deltaTime);
+            performPositionCorrection(contact, particles);
+        }
+        return;
+    }
+    
+    // 多執行緒：按粒子歸屬分組，每個粒子只由一個執行緒按接觸順序累加自己的力和修正。
+    // 每個接觸的貢獻只依賴接觸數據與逆質量，因此結果與串行路徑逐位相同。
+    buildParticleIncidence(contacts, static_cast<int>(particles.size()));
+    parallelFor(static_cast<int>(particles.size()), settings, [&](int begin, int end) {
+        for (int index = begin; index < end; ++index) {
+            for (int k = m_incidenceOffsets[index]; k < m_incidenceOffsets[index + 1]; ++k) {
+                const ContactIncidence& incidence = m_incidences[k];
+                applyContactToParticle(contacts[incidence.contact], incidence.slot, particles);
+            }
+        }
+    });
+}
+
+void OGCContactModel::buildParticleIncidence(Span<const OGCContact> contacts, int particleCount) {
+    // 計數排序 (穩定)：同一粒子的條目按接觸順序、再按接觸內的粒子順序排列
+    m_incidenceOffsets.assign(particleCount + 1, 0);
+    for (const OGCContact& contact : contacts) {
+        if (contact.particleIndexA < 0) continue;
+        forEachStencilSlot(contact, [&](int index, int) { ++m_incidenceOffsets[index + 1]; });
+    }
+    for (int i = 0; i < particleCount; ++i) {
+        m_incidenceOffsets[i + 1] += m_incidenceOffsets[i];
+    }
+    
+    m_incidences.resize(m_incidenceOffsets[particleCount]);
+    m_incidenceCursor.assign(m_incidenceOffsets.begin(), m_incidenceOffsets.end() - 1);
+    for (size_t c = 0; c < contacts.size(); ++c) {
+        if (contacts[c].particleIndexA < 0) continue;
+        forEachStencilSlot(contacts[c], [&](int index, int slot) {
+            m_incidences[m_incidenceCursor[index]++] = ContactIncidence{static_cast<int>(c), slot};
+        });
+    }
+}
+
+template <typename Real>
+void OGCContactModel::applyContactToParticle(const OGCContact& contact, int slot, ParticleList<Real>& particles) {
+    int index = slotParticle(contact, slot);
+    BasicParticle<Real>& particle = *particles[index];
+    float weight = slotWeight(contact, slot);
+    
+    // 接觸力 (與 applyOGCForce 相同的算式)
+    if (contact.contactForce > 0.0f) {
+        Vec3T<Real> force(contact.contactForce * contact.forceDirection);
+        if (contact.isStencilContact()) {
+            particle.addForce(Real(weight) * force);
+        } else if (slot == 0) {
+            particle.addForce(force);
+        } else {
+            particle.addForce(-force);
+        }
+    }
+    
+    // 位置修正 (與 performPositionCorrection 相同的算式)
+    if (contact.penetrationDepth <= 0.0f) return;
+    
+    float correctionFactor = contact.isImpactContact() ? 1.0f : m_positionCorrectionFactor;
+    Vec3T<Real> delta;
+    if (correctionDelta(contact, slot, contact.penetrationDepth * correctionFactor, particles, delta)) {
+        particle.setPosition(particle.getPosition() + delta);
+    }
+}
+
+template <typename Real>
+bool OGCContactModel::correctionDelta(const OGCContact& contact, int slot, float magnitude,
+                                      const ParticleList<Real>& particles, Vec3T<Real>& delta) const {
+    const BasicParticle<Real>& particle = *particles[slotParticle(contact, slot)];
+    Vec3T<Real> correction(magnitude * contact.contactNormal);
+    
+    if (contact.isStencilContact()) {
+        // 沿法線投影 n·(Σ wA xA - Σ wB xB)，按 w * invMass 分配
+        Real weightedInvMass = Real(0);
+        forEachStencilParticle(contact, [&](int stencilIndex, float stencilWeight) {
+            weightedInvMass += Real(stencilWeight) * Real(stencilWeight) * particles[stencilIndex]->getInverseMass();
+        });
+        if (weightedInvMass <= Real(0)) return false;
         
-        // 3. 應用OGC接觸力
-        applyOGCForce(contact, deltaTime);
+        Real scale = Real(slotWeight(contact, slot)) * particle.getInverseMass() / weightedInvMass;
+        delta = scale * correction;
+        return true;
+    }
+    
+    const BasicParticle<Real>& particleA = *particles[contact.particleIndexA];
+    if (contact.particleIndexB >= 0) {
+        const BasicParticle<Real>& particleB = *particles[contact.particleIndexB];
+        Real totalInvMass = particleA.getInverseMass() + particleB.getInverseMass();
+        if (totalInvMass <= Real(0)) return false;
         
-        // 4. 執行位置修正
-        performPositionCorrection(contact);
+        if (slot == 0) {
+            delta = (particleA.getInverseMass() / totalInvMass) * correction;
+        } else {
+            delta = -((particleB.getInverseMass() / totalInvMass) * correction);
+        }
+        return true;
+    }
+    
+    if (particle.getInverseMass() <= Real(0)) return false;
+    delta = correction;
+    return true;
+}
+
+template <typename Real>
+float OGCContactModel::currentDepth(const OGCContact& contact, const ParticleList<Real>& particles,
+                                    const std::vector<Vec3T<Real>>& anchors) const {
+    Vec3T<Real> displacement(Real(0));
+    forEachStencilParticle(contact, [&](int index, float weight) {
+        displacement += Real(weight) * (particles[index]->getPosition() - anchors[index]);
+    });
+    return contact.penetrationDepth - glm::dot(glm::vec3(displacement), contact.contactNormal);
+}
+
+template <typename Real>
+void OGCContactModel::projectContacts(Span<const OGCContact> contacts, ParticleList<Real>& particles,
+                                      const std::vector<Vec3T<Real>>& anchors, const ParallelSettings& settings) {
+    // 1. 每個接觸在當前位置的穿透深度 (只讀粒子)
+    m_projectionDepths.resize(contacts.size());
+    parallelFor(static_cast<int>(contacts.size()), settings, [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            const OGCContact& contact = contacts[i];
+            m_projectionDepths[i] = contact.particleIndexA >= 0 ? currentDepth(contact, particles, anchors) : 0.0f;
+        }
+    });
+    
+    // 2. 每個粒子平均其仍穿透的接觸給出的修正 (Jacobi)，只寫入自己
+    buildParticleIncidence(contacts, static_cast<int>(particles.size()));
+    parallelFor(static_cast<int>(particles.size()), settings, [&](int begin, int end) {
+        for (int index = begin; index < end; ++index) {
+            Vec3T<Real> sum(Real(0));
+            int activeCount = 0;
+            for (int k = m_incidenceOffsets[index]; k < m_incidenceOffsets[index + 1]; ++k) {
+                const ContactIncidence& incidence = m_incidences[k];
+                float depth = m_projectionDepths[incidence.contact];
+                if (depth <= 0.0f) continue;
+                
+                Vec3T<Real> delta;
+                if (correctionDelta(contacts[incidence.contact], incidence.slot, depth, particles, delta)) {
+                    sum += delta;
+                    ++activeCount;
+                }
+            }
+            if (activeCount > 0) {
+                BasicParticle<Real>& particle = *particles[index];
+                particle.setPosition(particle.getPosition() + sum / Real(activeCount));
+            }
+        }
+    });
+}
+
+void OGCContactModel::reduceContacts(std::vector<OGCContact>& contacts, int particleCount,
+                                     const ParallelSettings& settings) {
+    auto isReducible = [particleCount](const OGCContact& contact) {
+        return contact.particleIndexB < 0 && !contact.isStencilContact() && !contact.isImpactContact() &&
+               contact.particleIndexA >= 0 && contact.particleIndexA < particleCount;
+    };
+    
+    // 1. 單粒子靜態接觸按粒子分組 (CSR)
+    m_reductionOffsets.assign(particleCount + 1, 0);
+    for (const OGCContact& contact : contacts) {
+        if (isReducible(contact)) ++m_reductionOffsets[contact.particleIndexA + 1];
+    }
+    for (int i = 0; i < particleCount; ++i) {
+        m_reductionOffsets[i + 1] += m_reductionOffsets[i];
+    }
+    m_incidenceCursor.assign(m_reductionOffsets.begin(), m_reductionOffsets.end() - 1);
+    m_reductionOrder.resize(m_reductionOffsets[particleCount]);
+    for (size_t k = 0; k < contacts.size(); ++k) {
+        if (isReducible(contacts[k])) {
+            m_reductionOrder[m_incidenceCursor[contacts[k].particleIndexA]++] = static_cast<int>(k);
+        }
+    }
+    
+    // 2. 每個粒子各自分簇，結果寫入自己的區段
+    m_reducedContacts.resize(m_reductionOrder.size());
+    m_reducedCounts.resize(particleCount);
+    parallelFor(particleCount, settings, [&](int begin, int end) {
+        for (int particle = begin; particle < end; ++particle) {
+            int first = m_reductionOffsets[particle];
+            int last = m_reductionOffsets[particle + 1];
+            if (last - first <= 1) {
+                if (last > first) m_reducedContacts[first] = contacts[m_reductionOrder[first]];
+                m_reducedCounts[particle] = last - first;
+                continue;
+            }
+            
+            std::sort(m_reductionOrder.begin() + first, m_reductionOrder.begin() + last, [&](int a, int b) {
+                const OGCContact& ca = contacts[a];
+                const OGCContact& cb = contacts[b];
+                if (ca.penetrationDepth != cb.penetrationDepth) return ca.penetrationDepth > cb.penetrationDepth;
+                if (ca.featureId != cb.featureId) return ca.featureId < cb.featureId;
+                return a < b;
+            });
+            
+            glm::vec3 normalSums[kMaxReductionBudget];
+            int clusterCount = 0;
+            for (int k = first; k < last; ++k) {
+                const OGCContact& contact = contacts[m_reductionOrder[k]];
+                float weight = std::max(contact.penetrationDepth, 1e-6f);
+                
+                int cluster = -1;
+                float bestCosine = m_reductionCosine;
+                for (int c = 0; c < clusterCount; ++c) {
+                    float cosine = glm::dot(m_reducedContacts[first + c].contactNormal, contact.contactNormal);
+                    if (cosine >= bestCosine) {
+                        bestCosine = cosine;
+                        cluster = c;
+                    }
+                }
+                
+                if (cluster >= 0) {
+                    normalSums[cluster] += weight * contact.contactNormal;
+                } else if (clusterCount < m_reductionBudget) {
+                    m_reducedContacts[first + clusterCount] = contact;
+                    normalSums[clusterCount] = weight * contact.contactNormal;
+                    ++clusterCount;
+                }
+            }
+            
+            for (int c = 0; c < clusterCount; ++c) {
+                float length = glm::length(normalSums[c]);
+                if (length > 1e-8f) {
+                    m_reducedContacts[first + c].contactNormal = normalSums[c] / length;
+                }
+            }
+            m_reducedCounts[particle] = clusterCount;
+        }
+    });
+    
+    // 3. 壓實：合併後的接觸按粒子排列，其餘接觸保持原順序
+    m_reductionOutput.clear();
+    for (int particle = 0; particle < particleCount; ++particle) {
+        auto begin = m_reducedContacts.begin() + m_reductionOffsets[particle];
+        m_reductionOutput.insert(m_reductionOutput.end(), begin, begin + m_reducedCounts[particle]);
     }
+    for (const OGCContact& contact : contacts) {
+        if (!isReducible(contact)) m_reductionOutput.push_back(contact);
+    }
+    m_reducedContactCount = static_cast<int>(contacts.size() - m_reductionOutput.size());
+    contacts.swap(m_reductionOutput);
+}
+
+void OGCContactModel::sortContacts(Span<OGCContact> contacts) {
+    auto key = [](const OGCContact& c) {
+        return std::make_tuple(c.particleIndexA, c.particleIndexB,
+                               c.particleIndexA1, c.particleIndexB1, c.particleIndexB2,
+                               c.contactPoint.x, c.contactPoint.y, c.contactPoint.z,
+                               c.contactNormal.x, c.contactNormal.y, c.contactNormal.z,
+                               c.penetrationDepth);
+    };
+    std::sort(contacts.begin(), contacts.end(),
+              [&key](const OGCContact& a, const OGCContact& b) { return key(a) < key(b); });
 }
 
 glm::vec3 OGCContactModel::calculateOffsetGeometry(const OGCContact& contact) {
@@ -44,12 +443,13 @@ glm::vec3 OGCContactModel::calculateOffsetGeometry(const OGCContact& contact) {
     return offset;
 }
 
-void OGCContactModel::calculateContactForce(OGCContact& contact, float deltaTime) {
-    if (!contact.particleA) return;
+template <typename Real>
+void OGCContactModel::calculateContactForce(OGCContact& contact, const ParticleList<Real>& particles,
+                                            float deltaTime) {
+    if (contact.particleIndexA < 0) return;
     
-    // 計算相對速度
-    glm::vec3 relativeVelocity = calculateRelativeVelocity(contact);
-    float normalVelocity = calculateNormalVelocity(contact);
+    // 法線方向的相對速度
+    float normalVelocity = calculateNormalVelocity(contact, particles);
     
     // OGC彈簧力：基於穿透深度和偏移幾何
     float springForce = 0.0f;
@@ -66,6 +466,12 @@ void OGCContactModel::calculateContactForce(OGCContact& contact, float deltaTime
     contact.contactForce = std::max(0.0f, springForce - dampingForce);
     contact.forceDirection = contact.contactNormal;
     
+    // 熱啟動：延續上一幀同一接觸的力
+    if (contact.previousForce >= 0.0f && m_warmStartFactor > 0.0f) {
+        contact.contactForce = m_warmStartFactor * contact.previousForce
+                             + (1.0f - m_warmStartFactor) * contact.contactForce;
+    }
+    
     // 確保力的方向正確 (從接觸表面推開)
     if (normalVelocity < 0.0f) {
         // 物體正在分離，不施加額外的推力
@@ -73,57 +479,115 @@ void OGCContactModel::calculateContactForce(OGCContact& contact, float deltaTime
     }
 }
 
-void OGCContactModel::applyOGCForce(OGCContact& contact, float deltaTime) {
-    if (!contact.particleA || contact.contactForce <= 0.0f) return;
+template <typename Real>
+void OGCContactModel::applyOGCForce(OGCContact& contact, ParticleList<Real>& particles, float deltaTime) {
+    if (contact.particleIndexA < 0 || contact.contactForce <= 0.0f) return;
     
-    glm::vec3 force = contact.contactForce * contact.forceDirection;
+    Vec3T<Real> force(contact.contactForce * contact.forceDirection);
+    
+    if (contact.isStencilContact()) {
+        // 點-面 / 邊-邊接觸：按重心權重分配到各粒子
+        forEachStencilParticle(contact, [&](int index, float weight) {
+            particles[index]->addForce(Real(weight) * force);
+        });
+        return;
+    }
     
     // 對粒子A施加力
-    contact.particleA->addForce(force);
+    particles[contact.particleIndexA]->addForce(force);
     
     // 如果有粒子B，施加反作用力
-    if (contact.particleB) {
-        contact.particleB->addForce(-force);
+    if (contact.particleIndexB >= 0) {
+        particles[contact.particleIndexB]->addForce(-force);
     }
 }
 
-void OGCContactModel::performPositionCorrection(const OGCContact& contact) {
-    if (!contact.particleA || contact.penetrationDepth <= 0.0f) return;
+template <typename Real>
+void OGCContactModel::performPositionCorrection(const OGCContact& contact, ParticleList<Real>& particles) {
+    if (contact.particleIndexA < 0 || contact.penetrationDepth <= 0.0f) return;
+    
+    // OGC位置修正：基於偏移幾何；撞擊接觸完全退回到撞擊表面
+    float correctionFactor = contact.isImpactContact() ? 1.0f : m_positionCorrectionFactor;
+    float correctionMagnitude = contact.penetrationDepth * correctionFactor;
+    Vec3T<Real> correction(correctionMagnitude * contact.contactNormal);
+    
+    if (contact.isStencilContact()) {
+        // 點-面 / 邊-邊接觸：沿法線投影約束 n·(Σ wA xA - Σ wB xB)，按 w * invMass 分配修正
+        Real weightedInvMass = Real(0);
+        forEachStencilParticle(contact, [&](int index, float weight) {
+            weightedInvMass += Real(weight) * Real(weight) * particles[index]->getInverseMass();
+        });
+        if (weightedInvMass <= Real(0)) return;
+        
+        forEachStencilParticle(contact, [&](int index, float weight) {
+            BasicParticle<Real>& particle = *particles[index];
+            Real scale = Real(weight) * particle.getInverseMass() / weightedInvMass;
+            particle.setPosition(particle.getPosition() + scale * correction);
+        });
+        return;
+    }
     
-    // OGC位置修正：基於偏移幾何
-    float correctionMagnitude = contact.penetrationDepth * m_positionCorrectionFactor;
-    glm::vec3 correction = correctionMagnitude * contact.contactNormal;
+    BasicParticle<Real>& particleA = *particles[contact.particleIndexA];
     
-    if (contact.particleB) {
+    if (contact.particleIndexB >= 0) {
         // 兩個粒子之間的接觸
-        float totalInvMass = contact.particleA->getInverseMass() + contact.particleB->getInverseMass();
-        if (totalInvMass > 0.0f) {
-            float ratioA = contact.particleA->getInverseMass() / totalInvMass;
-            float ratioB = contact.particleB->getInverseMass() / totalInvMass;
+        BasicParticle<Real>& particleB = *particles[contact.particleIndexB];
+        Real totalInvMass = particleA.getInverseMass() + particleB.getInverseMass();
+        if (totalInvMass > Real(0)) {
+            Real ratioA = particleA.getInverseMass() / totalInvMass;
+            Real ratioB = particleB.getInverseMass() / totalInvMass;
             
-            contact.particleA->setPosition(contact.particleA->getPosition() + ratioA * correction);
-            contact.particleB->setPosition(contact.particleB->getPosition() - ratioB * correction);
+            particleA.setPosition(particleA.getPosition() + ratioA * correction);
+            particleB.setPosition(particleB.getPosition() - ratioB * correction);
         }
     } else {
         // 與靜態物體的接觸
-        if (contact.particleA->getInverseMass() > 0.0f) {
-            contact.particleA->setPosition(contact.particleA->getPosition() + correction);
+        if (particleA.getInverseMass() > Real(0)) {
+            particleA.setPosition(particleA.getPosition() + correction);
         }
     }
 }
 
-glm::vec3 OGCContactModel::calculateRelativeVelocity(const OGCContact& contact) {
-    if (!contact.particleA) return glm::vec3(0.0f);
+template <typename Real>
+glm::vec3 OGCContactModel::calculateRelativeVelocity(const OGCContact& contact,
+                                                     const ParticleList<Real>& particles) {
+    if (contact.particleIndexA < 0) return glm::vec3(0.0f);
     
-    glm::vec3 velocityA = contact.particleA->getVelocity();
-    glm::vec3 velocityB = contact.particleB ? contact.particleB->getVelocity() : glm::vec3(0.0f);
+    if (contact.isStencilContact()) {
+        Vec3T<Real> relativeVelocity(Real(0));
+        forEachStencilParticle(contact, [&](int index, float weight) {
+            relativeVelocity += Real(weight) * particles[index]->getVelocity();
+        });
+        return glm::vec3(relativeVelocity);
+    }
+    
+    Vec3T<Real> velocityA = particles[contact.particleIndexA]->getVelocity();
+    Vec3T<Real> velocityB = contact.particleIndexB >= 0
+        ? particles[contact.particleIndexB]->getVelocity() : Vec3T<Real>(contact.colliderVelocity);
     
-    return velocityA - velocityB;
+    return glm::vec3(velocityA - velocityB);
 }
 
-float OGCContactModel::calculateNormalVelocity(const OGCContact& contact) {
-    glm::vec3 relativeVelocity = calculateRelativeVelocity(contact);
+template <typename Real>
+float OGCContactModel::calculateNormalVelocity(const OGCContact& contact, const ParticleList<Real>& particles) {
+    glm::vec3 relativeVelocity = calculateRelativeVelocity(contact, particles);
     return glm::dot(relativeVelocity, contact.contactNormal);
 }
 
+// 顯式實例化 float 和 double 精度
+#define OGC_INSTANTIATE_CONTACT_MODEL(Real) \
+    template void OGCContactModel::processContacts<Real>(Span<OGCContact>, ParticleList<Real>&, \
+                                                         float, const ParallelSettings&); \
+    template void OGCContactModel::calculateContactForce<Real>(OGCContact&, const ParticleList<Real>&, float); \
+    template void OGCContactModel::applyOGCForce<Real>(OGCContact&, ParticleList<Real>&, float); \
+    template void OGCContactModel::performPositionCorrection<Real>(const OGCContact&, ParticleList<Real>&); \
+    template void OGCContactModel::applyContactToParticle<Real>(const OGCContact&, int, ParticleList<Real>&); \
+    template void OGCContactModel::projectContacts<Real>(Span<const OGCContact>, ParticleList<Real>&, \
+                                                         const std::vector<Vec3T<Real>>&, const ParallelSettings&);
+
+OGC_INSTANTIATE_CONTACT_MODEL(float)
+OGC_INSTANTIATE_CONTACT_MODEL(double)
+
+#undef OGC_INSTANTIATE_CONTACT_MODEL
+
 } // namespace Physics
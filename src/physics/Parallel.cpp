@@ -0,0 +1,78 @@
+#include "physics/Parallel.h"
+#include "physics/TaskScheduler.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+
+namespace Physics {
+
+namespace {
+
+/**
+ * @brief 一次 parallelFor 的共享狀態 (位於呼叫者堆疊上)
+ */
+struct ParallelForJob {
+    ParallelBlockFn invoke;
+    void* body;
+    int count;
+    int chunkSize;
+    int chunkCount;
+    std::atomic<int> nextChunk;
+};
+
+// 參與者以原子計數領取區塊，先完成者繼續領取，負載自動平衡
+void runChunks(void* data) {
+    ParallelForJob& job = *static_cast<ParallelForJob*>(data);
+    for (int chunk = job.nextChunk.fetch_add(1, std::memory_order_relaxed); chunk < job.chunkCount;
+         chunk = job.nextChunk.fetch_add(1, std::memory_order_relaxed)) {
+        int begin = chunk * job.chunkSize;
+        int end = std::min(job.count, begin + job.chunkSize);
+        job.invoke(job.body, begin, end);
+    }
+}
+
+constexpr int kMaxHelperTasks = 64;
+
+} // namespace
+
+void parallelForBlocks(int count, const ParallelSettings& settings, ParallelBlockFn invoke, void* body) {
+    if (count <= 0) return;
+
+    int threadCount = std::max(1, settings.threadCount);
+
+    // 確定性模式使用固定分塊大小；否則按執行緒數平均切分
+    int chunkSize = settings.deterministic
+        ? std::max(1, settings.grainSize)
+        : (count + threadCount - 1) / threadCount;
+    int chunkCount = (count + chunkSize - 1) / chunkSize;
+    threadCount = std::min(threadCount, chunkCount);
+
+    if (threadCount == 1) {
+        for (int chunk = 0; chunk < chunkCount; ++chunk) {
+            int begin = chunk * chunkSize;
+            invoke(body, begin, std::min(count, begin + chunkSize));
+        }
+        return;
+    }
+
+    // 區塊邊界與誰執行無關，確定性模式下結果不受領取順序影響
+    ParallelForJob job{invoke, body, count, chunkSize, chunkCount, {0}};
+
+    TaskScheduler& scheduler = TaskScheduler::instance();
+    int helperCount = std::min(threadCount - 1, kMaxHelperTasks);
+    scheduler.reserveWorkers(helperCount);
+
+    std::array<Task, kMaxHelperTasks> helpers;
+    TaskGroup group(scheduler);
+    for (int i = 0; i < helperCount; ++i) {
+        helpers[i].execute = &runChunks;
+        helpers[i].data = &job;
+        group.run(helpers[i]);
+    }
+
+    // 呼叫者也參與，之後取回尚未被竊取的輔助任務 (此時已無區塊可領，立即返回)
+    runChunks(&job);
+    group.wait();
+}
+
+} // namespace Physics
@@ -3,16 +3,18 @@
 
 namespace Physics {
 
-Particle::Particle(const glm::vec3& position, float mass)
+template <typename Real>
+BasicParticle<Real>::BasicParticle(const Vec3& position, Real mass)
     : m_position(position)
     , m_previousPosition(position)
-    , m_force(0.0f)
+    , m_force(Real(0))
     , m_mass(mass)
-    , m_inverseMass(mass > 0.0f ? 1.0f / mass : 0.0f)
+    , m_inverseMass(mass > Real(0) ? Real(1) / mass : Real(0))
 {
 }
 
-void Particle::update(float deltaTime) {
+template <typename Real>
+void BasicParticle<Real>::update(Real deltaTime) {
     if (isFixed()) {
         // 固定粒子不更新位置
         clearForces();
@@ -20,8 +22,8 @@ void Particle::update(float deltaTime) {
     }
     
     // Verlet 積分
-    glm::vec3 acceleration = m_force * m_inverseMass;
-    glm::vec3 newPosition = 2.0f * m_position - m_previousPosition + acceleration * deltaTime * deltaTime;
+    Vec3 acceleration = m_force * m_inverseMass;
+    Vec3 newPosition = Real(2) * m_position - m_previousPosition + acceleration * deltaTime * deltaTime;
     
     // 更新位置
     m_previousPosition = m_position;
@@ -31,39 +33,49 @@ void Particle::update(float deltaTime) {
     clearForces();
 }
 
-void Particle::addForce(const glm::vec3& force) {
+template <typename Real>
+void BasicParticle<Real>::addForce(const Vec3& force) {
     m_force += force;
 }
 
-void Particle::clearForces() {
-    m_force = glm::vec3(0.0f);
+template <typename Real>
+void BasicParticle<Real>::clearForces() {
+    m_force = Vec3(Real(0));
 }
 
-void Particle::setPosition(const glm::vec3& position) {
+template <typename Real>
+void BasicParticle<Real>::setPosition(const Vec3& position) {
     m_position = position;
 }
 
-glm::vec3 Particle::getVelocity() const {
+template <typename Real>
+typename BasicParticle<Real>::Vec3 BasicParticle<Real>::getVelocity() const {
     // 使用 Verlet 積分計算速度
     return (m_position - m_previousPosition);
 }
 
-void Particle::setVelocity(const glm::vec3& velocity) {
+template <typename Real>
+void BasicParticle<Real>::setVelocity(const Vec3& velocity) {
     // 通過調整上一幀位置來設定速度
     m_previousPosition = m_position - velocity;
 }
 
-void Particle::setMass(float mass) {
+template <typename Real>
+void BasicParticle<Real>::setMass(Real mass) {
     m_mass = mass;
-    m_inverseMass = mass > 0.0f ? 1.0f / mass : 0.0f;
+    m_inverseMass = mass > Real(0) ? Real(1) / mass : Real(0);
 }
 
-void Particle::setFixed(bool fixed) {
+template <typename Real>
+void BasicParticle<Real>::setFixed(bool fixed) {
     if (fixed) {
-        m_inverseMass = 0.0f;
+        m_inverseMass = Real(0);
     } else {
-        m_inverseMass = m_mass > 0.0f ? 1.0f / m_mass : 0.0f;
+        m_inverseMass = m_mass > Real(0) ? Real(1) / m_mass : Real(0);
     }
 }
 
+template class BasicParticle<float>;
+template class BasicParticle<double>;
+
 } // namespace Physics
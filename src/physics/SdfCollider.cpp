@@ -0,0 +1,396 @@
+#include "physics/SdfCollider.h"
+#include "physics/Geometry.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <unordered_map>
+
+namespace Physics {
+
+namespace {
+
+// 快取檔案標頭
+constexpr char kCacheMagic[8] = {'O', 'G', 'C', 'S', 'D', 'F', '0', '1'};
+
+// 體素網格樣本數上限，避免過小的體素耗盡記憶體
+constexpr size_t kMaxSamples = size_t(256) * 256 * 256;
+
+// 批次查詢寬度 (一組 SoA 暫存)
+constexpr int kQueryWidth = 8;
+
+// 接觸檢測時每個區塊包含的粒子數
+constexpr int kDetectBlockSize = 256;
+
+uint64_t edgeKey(int a, int b) {
+    if (a > b) std::swap(a, b);
+    return (static_cast<uint64_t>(static_cast<uint32_t>(a)) << 32) | static_cast<uint32_t>(b);
+}
+
+} // namespace
+
+SdfCollider::SdfCollider()
+    : m_origin(0.0f)
+    , m_resolution(0)
+    , m_voxelSize(0.0f)
+    , m_bandWidth(0.0f)
+{
+}
+
+bool SdfCollider::build(const std::vector<glm::vec3>& vertices, const std::vector<glm::ivec3>& triangles,
+                        float voxelSize, float bandWidth, const std::string& cachePath) {
+    if (vertices.empty() || triangles.empty() || voxelSize <= 0.0f) {
+        std::cerr << "SDF collider: empty mesh or invalid voxel size" << std::endl;
+        return false;
+    }
+
+    // 窄帶至少涵蓋兩個體素，保證帶內樣本圍成封閉外殼
+    m_voxelSize = voxelSize;
+    m_bandWidth = std::max(bandWidth, 2.0f * voxelSize);
+
+    uint64_t inputHash = hashInput(vertices, triangles, m_voxelSize, m_bandWidth);
+    if (!cachePath.empty() && loadCache(cachePath, inputHash)) {
+        std::cout << "Loaded SDF collider from cache: " << cachePath << std::endl;
+        return true;
+    }
+
+    glm::vec3 boundsMin = vertices[0];
+    glm::vec3 boundsMax = vertices[0];
+    for (const glm::vec3& vertex : vertices) {
+        boundsMin = glm::min(boundsMin, vertex);
+        boundsMax = glm::max(boundsMax, vertex);
+    }
+
+    float padding = m_bandWidth + m_voxelSize;
+    m_origin = boundsMin - glm::vec3(padding);
+    glm::vec3 extent = boundsMax - boundsMin + glm::vec3(2.0f * padding);
+    m_resolution = glm::ivec3(static_cast<int>(std::ceil(extent.x / m_voxelSize)) + 1,
+                              static_cast<int>(std::ceil(extent.y / m_voxelSize)) + 1,
+                              static_cast<int>(std::ceil(extent.z / m_voxelSize)) + 1);
+
+    size_t sampleCount = static_cast<size_t>(m_resolution.x) * m_resolution.y * m_resolution.z;
+    if (sampleCount > kMaxSamples) {
+        std::cerr << "SDF collider: grid " << m_resolution.x << "x" << m_resolution.y << "x" << m_resolution.z
+                  << " exceeds the sample limit, increase the voxel size" << std::endl;
+        m_values.clear();
+        return false;
+    }
+
+    voxelize(vertices, triangles);
+
+    std::cout << "Built SDF collider: " << triangles.size() << " triangles, grid "
+              << m_resolution.x << "x" << m_resolution.y << "x" << m_resolution.z << std::endl;
+
+    if (!cachePath.empty() && !saveCache(cachePath, inputHash)) {
+        std::cerr << "SDF collider: failed to write cache " << cachePath << std::endl;
+    }
+    return true;
+}
+
+void SdfCollider::voxelize(const std::vector<glm::vec3>& vertices, const std::vector<glm::ivec3>& triangles) {
+    size_t sampleCount = static_cast<size_t>(m_resolution.x) * m_resolution.y * m_resolution.z;
+    m_values.assign(sampleCount, m_bandWidth);
+    std::vector<float> unsignedDistances(sampleCount, m_bandWidth);
+    std::vector<char> known(sampleCount, 0);
+
+    // 角度加權偽法線：面、邊 (相鄰面法線和)、頂點 (角度加權面法線和)
+    std::vector<glm::vec3> faceNormals(triangles.size());
+    std::vector<glm::vec3> vertexNormals(vertices.size(), glm::vec3(0.0f));
+    std::unordered_map<uint64_t, glm::vec3> edgeNormals;
+    edgeNormals.reserve(triangles.size() * 2);
+
+    for (size_t t = 0; t < triangles.size(); ++t) {
+        const glm::ivec3& triangle = triangles[t];
+        glm::vec3 normal = glm::cross(vertices[triangle.y] - vertices[triangle.x],
+                                      vertices[triangle.z] - vertices[triangle.x]);
+        float length = glm::length(normal);
+        faceNormals[t] = length > 1e-12f ? normal / length : glm::vec3(0.0f);
+
+        for (int k = 0; k < 3; ++k) {
+            glm::vec3 e1 = vertices[triangle[(k + 1) % 3]] - vertices[triangle[k]];
+            glm::vec3 e2 = vertices[triangle[(k + 2) % 3]] - vertices[triangle[k]];
+            float l1 = glm::length(e1), l2 = glm::length(e2);
+            if (l1 > 1e-12f && l2 > 1e-12f) {
+                float angle = std::acos(glm::clamp(glm::dot(e1, e2) / (l1 * l2), -1.0f, 1.0f));
+                vertexNormals[triangle[k]] += angle * faceNormals[t];
+            }
+            edgeNormals[edgeKey(triangle[k], triangle[(k + 1) % 3])] += faceNormals[t];
+        }
+    }
+
+    // 逐三角形掃描其窄帶包圍盒內的樣本，保留最近距離
+    for (size_t t = 0; t < triangles.size(); ++t) {
+        const glm::ivec3& triangle = triangles[t];
+        const glm::vec3& a = vertices[triangle.x];
+        const glm::vec3& b = vertices[triangle.y];
+        const glm::vec3& c = vertices[triangle.z];
+
+        glm::vec3 lower = (glm::min(a, glm::min(b, c)) - glm::vec3(m_bandWidth) - m_origin) / m_voxelSize;
+        glm::vec3 upper = (glm::max(a, glm::max(b, c)) + glm::vec3(m_bandWidth) - m_origin) / m_voxelSize;
+        glm::ivec3 first = glm::max(glm::ivec3(glm::floor(lower)), glm::ivec3(0));
+        glm::ivec3 last = glm::min(glm::ivec3(glm::ceil(upper)), m_resolution - glm::ivec3(1));
+
+        for (int z = first.z; z <= last.z; ++z) {
+            for (int y = first.y; y <= last.y; ++y) {
+                for (int x = first.x; x <= last.x; ++x) {
+                    glm::vec3 p = m_origin + glm::vec3(float(x), float(y), float(z)) * m_voxelSize;
+                    glm::vec3 weights = closestPointOnTriangle(p, a, b, c);
+                    glm::vec3 closest = weights.x * a + weights.y * b + weights.z * c;
+                    float distance = glm::length(p - closest);
+
+                    size_t index = sampleIndex(x, y, z);
+                    if (distance >= unsignedDistances[index]) continue;
+
+                    // 依最近點所在區域選擇偽法線
+                    glm::vec3 pseudoNormal;
+                    int zeroCount = (weights.x == 0.0f) + (weights.y == 0.0f) + (weights.z == 0.0f);
+                    if (zeroCount == 2) {
+                        int k = weights.x != 0.0f ? 0 : (weights.y != 0.0f ? 1 : 2);
+                        pseudoNormal = vertexNormals[triangle[k]];
+                    } else if (zeroCount == 1) {
+                        int k = weights.x == 0.0f ? 0 : (weights.y == 0.0f ? 1 : 2);
+                        pseudoNormal = edgeNormals[edgeKey(triangle[(k + 1) % 3], triangle[(k + 2) % 3])];
+                    } else {
+                        pseudoNormal = faceNormals[t];
+                    }
+
+                    unsignedDistances[index] = distance;
+                    m_values[index] = glm::dot(p - closest, pseudoNormal) >= 0.0f ? distance : -distance;
+                    known[index] = 1;
+                }
+            }
+        }
+    }
+
+    propagateSigns(known);
+}
+
+void SdfCollider::propagateSigns(std::vector<char>& known) {
+    std::deque<size_t> queue;
+    for (size_t i = 0; i < known.size(); ++i) {
+        if (known[i]) queue.push_back(i);
+    }
+
+    size_t strideY = static_cast<size_t>(m_resolution.x);
+    size_t strideZ = strideY * m_resolution.y;
+
+    while (!queue.empty()) {
+        size_t index = queue.front();
+        queue.pop_front();
+
+        int x = static_cast<int>(index % strideY);
+        int y = static_cast<int>((index / strideY) % m_resolution.y);
+        int z = static_cast<int>(index / strideZ);
+        float value = m_values[index] < 0.0f ? -m_bandWidth : m_bandWidth;
+
+        const int offsets[6][3] = {{-1, 0, 0}, {1, 0, 0}, {0, -1, 0}, {0, 1, 0}, {0, 0, -1}, {0, 0, 1}};
+        for (const auto& offset : offsets) {
+            int nx = x + offset[0], ny = y + offset[1], nz = z + offset[2];
+            if (nx < 0 || ny < 0 || nz < 0 ||
+                nx >= m_resolution.x || ny >= m_resolution.y || nz >= m_resolution.z) {
+                continue;
+            }
+
+            size_t neighbour = sampleIndex(nx, ny, nz);
+            if (known[neighbour]) continue;
+
+            known[neighbour] = 1;
+            m_values[neighbour] = value;
+            queue.push_back(neighbour);
+        }
+    }
+}
+
+void SdfCollider::query(const glm::vec3* positions, int count, float* distances, glm::vec3* gradients) const {
+    glm::vec3 upperBound = glm::vec3(m_resolution - glm::ivec3(1)) * 0.9999f;
+    float inverseVoxel = 1.0f / m_voxelSize;
+    size_t strideY = static_cast<size_t>(m_resolution.x);
+    size_t strideZ = strideY * m_resolution.y;
+
+    for (int base = 0; base < count; base += kQueryWidth) {
+        int width = std::min(kQueryWidth, count - base);
+
+        // SoA 暫存：格子座標、插值分數、網格外距離與八個角的樣本
+        float fx[kQueryWidth], fy[kQueryWidth], fz[kQueryWidth];
+        float outside[kQueryWidth];
+        glm::vec3 outsideDirection[kQueryWidth];
+        size_t corner[kQueryWidth];
+        float c000[kQueryWidth], c100[kQueryWidth], c010[kQueryWidth], c110[kQueryWidth];
+        float c001[kQueryWidth], c101[kQueryWidth], c011[kQueryWidth], c111[kQueryWidth];
+
+        for (int k = 0; k < width; ++k) {
+            glm::vec3 local = (positions[base + k] - m_origin) * inverseVoxel;
+            glm::vec3 clamped = glm::clamp(local, glm::vec3(0.0f), upperBound);
+            glm::vec3 cell = glm::floor(clamped);
+
+            glm::vec3 offset = (local - clamped) * m_voxelSize;
+            outside[k] = glm::length(offset);
+            outsideDirection[k] = outside[k] > 0.0f ? offset / outside[k] : glm::vec3(0.0f);
+
+            fx[k] = clamped.x - cell.x;
+            fy[k] = clamped.y - cell.y;
+            fz[k] = clamped.z - cell.z;
+            corner[k] = sampleIndex(static_cast<int>(cell.x), static_cast<int>(cell.y), static_cast<int>(cell.z));
+        }
+
+        for (int k = 0; k < width; ++k) {
+            size_t i = corner[k];
+            c000[k] = m_values[i];
+            c100[k] = m_values[i + 1];
+            c010[k] = m_values[i + strideY];
+            c110[k] = m_values[i + strideY + 1];
+            c001[k] = m_values[i + strideZ];
+            c101[k] = m_values[i + strideZ + 1];
+            c011[k] = m_values[i + strideZ + strideY];
+            c111[k] = m_values[i + strideZ + strideY + 1];
+        }
+
+        for (int k = 0; k < width; ++k) {
+            float x = fx[k], y = fy[k], z = fz[k];
+
+            // 沿 x 插值，再沿 y、z
+            float c00 = c000[k] + x * (c100[k] - c000[k]);
+            float c10 = c010[k] + x * (c110[k] - c010[k]);
+            float c01 = c001[k] + x * (c101[k] - c001[k]);
+            float c11 = c011[k] + x * (c111[k] - c011[k]);
+            float c0 = c00 + y * (c10 - c00);
+            float c1 = c01 + y * (c11 - c01);
+            float value = c0 + z * (c1 - c0);
+
+            // 三線性插值的解析梯度
+            float dx0 = (c100[k] - c000[k]) + y * ((c110[k] - c010[k]) - (c100[k] - c000[k]));
+            float dx1 = (c101[k] - c001[k]) + y * ((c111[k] - c011[k]) - (c101[k] - c001[k]));
+            float gx = dx0 + z * (dx1 - dx0);
+            float gy = (c10 - c00) + z * ((c11 - c01) - (c10 - c00));
+            float gz = c1 - c0;
+
+            distances[base + k] = value + outside[k];
+            gradients[base + k] = outside[k] > 0.0f
+                ? outsideDirection[k]
+                : glm::vec3(gx, gy, gz) * inverseVoxel;
+        }
+    }
+}
+
+float SdfCollider::distance(const glm::vec3& position) const {
+    if (!isValid()) return m_bandWidth;
+
+    float result;
+    glm::vec3 gradient;
+    query(&position, 1, &result, &gradient);
+    return result;
+}
+
+void SdfCollider::detect(const std::vector<glm::vec3>& positions, float particleRadius,
+                         std::vector<OGCContact>& contacts, const ParallelSettings& settings) {
+    if (!isValid()) return;
+
+    int particleCount = static_cast<int>(positions.size());
+    int blockCount = (particleCount + kDetectBlockSize - 1) / kDetectBlockSize;
+    m_blockContacts.resize(blockCount);
+
+    ParallelSettings blockSettings(settings.threadCount, settings.deterministic, 1);
+    parallelFor(blockCount, blockSettings, [&](int blockBegin, int blockEnd) {
+        float distances[kDetectBlockSize];
+        glm::vec3 gradients[kDetectBlockSize];
+
+        for (int block = blockBegin; block < blockEnd; ++block) {
+            std::vector<OGCContact>& blockContacts = m_blockContacts[block];
+            blockContacts.clear();
+
+            int begin = block * kDetectBlockSize;
+            int count = std::min(kDetectBlockSize, particleCount - begin);
+            query(positions.data() + begin, count, distances, gradients);
+
+            for (int k = 0; k < count; ++k) {
+                if (distances[k] >= particleRadius) continue;
+
+                float gradientLength = glm::length(gradients[k]);
+                if (gradientLength <= 1e-8f) continue;
+
+                glm::vec3 normal = gradients[k] / gradientLength;
+
+                OGCContact contact;
+                contact.particleIndexA = begin + k;
+                contact.particleIndexB = -1;
+                contact.contactPoint = positions[begin + k] - distances[k] * normal;
+                contact.contactNormal = normal;
+                contact.penetrationDepth = particleRadius - distances[k];
+                blockContacts.push_back(contact);
+            }
+        }
+    });
+
+    // 按區塊順序壓實合併
+    compactBlocks(m_blockContacts, contacts, settings);
+}
+
+uint64_t SdfCollider::hashInput(const std::vector<glm::vec3>& vertices, const std::vector<glm::ivec3>& triangles,
+                                float voxelSize, float bandWidth) {
+    // FNV-1a 64 位元
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+    };
+
+    for (const glm::vec3& vertex : vertices) {
+        const float components[3] = {vertex.x, vertex.y, vertex.z};
+        mix(components, sizeof(components));
+    }
+    for (const glm::ivec3& triangle : triangles) {
+        const int32_t indices[3] = {triangle.x, triangle.y, triangle.z};
+        mix(indices, sizeof(indices));
+    }
+    mix(&voxelSize, sizeof(voxelSize));
+    mix(&bandWidth, sizeof(bandWidth));
+    return hash;
+}
+
+bool SdfCollider::loadCache(const std::string& path, uint64_t inputHash) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+
+    char magic[sizeof(kCacheMagic)];
+    uint64_t hash = 0;
+    float origin[3];
+    int32_t resolution[3];
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(&hash), sizeof(hash));
+    file.read(reinterpret_cast<char*>(origin), sizeof(origin));
+    file.read(reinterpret_cast<char*>(resolution), sizeof(resolution));
+    if (!file || std::memcmp(magic, kCacheMagic, sizeof(kCacheMagic)) != 0 || hash != inputHash) return false;
+
+    size_t sampleCount = static_cast<size_t>(resolution[0]) * resolution[1] * resolution[2];
+    if (resolution[0] < 2 || resolution[1] < 2 || resolution[2] < 2 || sampleCount > kMaxSamples) return false;
+
+    std::vector<float> values(sampleCount);
+    file.read(reinterpret_cast<char*>(values.data()), sampleCount * sizeof(float));
+    if (!file) return false;
+
+    m_origin = glm::vec3(origin[0], origin[1], origin[2]);
+    m_resolution = glm::ivec3(resolution[0], resolution[1], resolution[2]);
+    m_values = std::move(values);
+    return true;
+}
+
+bool SdfCollider::saveCache(const std::string& path, uint64_t inputHash) const {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) return false;
+
+    const float origin[3] = {m_origin.x, m_origin.y, m_origin.z};
+    const int32_t resolution[3] = {m_resolution.x, m_resolution.y, m_resolution.z};
+    file.write(kCacheMagic, sizeof(kCacheMagic));
+    file.write(reinterpret_cast<const char*>(&inputHash), sizeof(inputHash));
+    file.write(reinterpret_cast<const char*>(origin), sizeof(origin));
+    file.write(reinterpret_cast<const char*>(resolution), sizeof(resolution));
+    file.write(reinterpret_cast<const char*>(m_values.data()), m_values.size() * sizeof(float));
+    return static_cast<bool>(file);
+}
+
+} // namespace Physics
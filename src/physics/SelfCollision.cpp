@@ -0,0 +1,172 @@
+#include "physics/SelfCollision.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace Physics {
+
+namespace {
+
+// 查詢時每個區塊包含的粒子數，區塊邊界與執行緒數無關
+constexpr int kQueryBlockSize = 256;
+
+} // namespace
+
+SelfCollision::SelfCollision(float particleRadius, int excludedRingDistance)
+    : m_particleRadius(particleRadius)
+    , m_excludedRingDistance(excludedRingDistance)
+    , m_gridWidth(0)
+    , m_gridHeight(0)
+    , m_cellSize(2.0f * particleRadius)
+{
+}
+
+void SelfCollision::setGridTopology(int width, int height) {
+    m_gridWidth = width;
+    m_gridHeight = height;
+}
+
+void SelfCollision::detect(const std::vector<glm::vec3>& positions, std::vector<OGCContact>& contacts,
+                           const ParallelSettings& settings) {
+    int particleCount = static_cast<int>(positions.size());
+    if (particleCount < 2 || m_particleRadius <= 0.0f) return;
+
+    // 格子大小等於接觸距離，鄰近粒子必定落在相鄰的 27 個格子內
+    m_cellSize = 2.0f * m_particleRadius;
+    buildHash(positions, settings);
+
+    float contactDistance = 2.0f * m_particleRadius;
+    float contactDistanceSq = contactDistance * contactDistance;
+
+    int blockCount = (particleCount + kQueryBlockSize - 1) / kQueryBlockSize;
+    m_blockContacts.resize(blockCount);
+
+    ParallelSettings blockSettings(settings.threadCount, settings.deterministic, 1);
+    parallelFor(blockCount, blockSettings, [&](int blockBegin, int blockEnd) {
+        for (int block = blockBegin; block < blockEnd; ++block) {
+            std::vector<OGCContact>& blockContacts = m_blockContacts[block];
+            blockContacts.clear();
+
+            int begin = block * kQueryBlockSize;
+            int end = std::min(particleCount, begin + kQueryBlockSize);
+
+            for (int i = begin; i < end; ++i) {
+                const glm::vec3& positionA = positions[i];
+                glm::ivec3 cell = cellCoord(positionA);
+
+                // 不同格子可能雜湊到同一個桶，記錄已訪問的桶以避免重複配對
+                int visited[27];
+                int visitedCount = 0;
+
+                for (int dz = -1; dz <= 1; ++dz) {
+                    for (int dy = -1; dy <= 1; ++dy) {
+                        for (int dx = -1; dx <= 1; ++dx) {
+                            int bucket = hashCell(cell + glm::ivec3(dx, dy, dz));
+                            if (std::find(visited, visited + visitedCount, bucket) != visited + visitedCount) {
+                                continue;
+                            }
+                            visited[visitedCount++] = bucket;
+
+                            for (int k = m_cellStart[bucket]; k < m_cellStart[bucket + 1]; ++k) {
+                                int j = m_sortedParticles[k];
+
+                                // 每對只由較小索引的粒子產生一次
+                                if (j <= i || areTopologicalNeighbours(i, j)) continue;
+
+                                glm::vec3 delta = positionA - positions[j];
+                                float distanceSq = glm::dot(delta, delta);
+                                if (distanceSq >= contactDistanceSq || distanceSq < 1e-12f) continue;
+
+                                float distance = std::sqrt(distanceSq);
+
+                                OGCContact contact;
+                                contact.particleIndexA = i;
+                                contact.particleIndexB = j;
+                                contact.contactNormal = delta / distance;   // 將A推離B
+                                contact.contactPoint = 0.5f * (positionA + positions[j]);
+                                contact.penetrationDepth = contactDistance - distance;
+                                contact.contactRadius = contactDistance;
+                                blockContacts.push_back(contact);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    });
+
+    // 按區塊順序壓實合併
+    compactBlocks(m_blockContacts, contacts, settings);
+}
+
+void SelfCollision::buildHash(const std::vector<glm::vec3>& positions, const ParallelSettings& settings) {
+    int particleCount = static_cast<int>(positions.size());
+
+    // 雜湊表大小取不小於粒子數兩倍的 2 的冪
+    int tableSize = 64;
+    while (tableSize < 2 * particleCount) {
+        tableSize <<= 1;
+    }
+
+    if (static_cast<int>(m_cellCounts.size()) != tableSize) {
+        m_cellCounts = std::vector<std::atomic<int>>(tableSize);
+        m_cellStart.resize(tableSize + 1);
+    }
+    m_particleCells.resize(particleCount);
+    m_sortedParticles.resize(particleCount);
+
+    // 1. 清空計數
+    parallelFor(tableSize, settings, [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            m_cellCounts[i].store(0, std::memory_order_relaxed);
+        }
+    });
+
+    // 2. 計算每個粒子的桶並計數
+    parallelFor(particleCount, settings, [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            int bucket = hashCell(cellCoord(positions[i]));
+            m_particleCells[i] = bucket;
+            m_cellCounts[bucket].fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    // 3. 前綴和得到每個桶的起始位置，計數器改作寫入游標
+    m_cellStart[0] = 0;
+    for (int bucket = 0; bucket < tableSize; ++bucket) {
+        int count = m_cellCounts[bucket].load(std::memory_order_relaxed);
+        m_cellStart[bucket + 1] = m_cellStart[bucket] + count;
+        m_cellCounts[bucket].store(m_cellStart[bucket], std::memory_order_relaxed);
+    }
+
+    // 4. 分散寫入 (桶內順序不固定；確定性模式下接觸在處理前會排序)
+    parallelFor(particleCount, settings, [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            int slot = m_cellCounts[m_particleCells[i]].fetch_add(1, std::memory_order_relaxed);
+            m_sortedParticles[slot] = i;
+        }
+    });
+}
+
+int SelfCollision::hashCell(const glm::ivec3& cell) const {
+    unsigned int hash = (static_cast<unsigned int>(cell.x) * 73856093u) ^
+                        (static_cast<unsigned int>(cell.y) * 19349663u) ^
+                        (static_cast<unsigned int>(cell.z) * 83492791u);
+    return static_cast<int>(hash & static_cast<unsigned int>(m_cellCounts.size() - 1));
+}
+
+glm::ivec3 SelfCollision::cellCoord(const glm::vec3& position) const {
+    return glm::ivec3(static_cast<int>(std::floor(position.x / m_cellSize)),
+                      static_cast<int>(std::floor(position.y / m_cellSize)),
+                      static_cast<int>(std::floor(position.z / m_cellSize)));
+}
+
+bool SelfCollision::areTopologicalNeighbours(int a, int b) const {
+    if (m_gridWidth <= 0 || m_gridHeight <= 0) return false;
+
+    int dx = std::abs(a % m_gridWidth - b % m_gridWidth);
+    int dy = std::abs(a / m_gridWidth - b / m_gridWidth);
+    return dx <= m_excludedRingDistance && dy <= m_excludedRingDistance;
+}
+
+} // namespace Physics
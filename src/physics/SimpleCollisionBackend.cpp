@@ -0,0 +1,197 @@
+#include "physics/SimpleCollisionBackend.h"
+#include "physics/TriangleMeshCollider.h"
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+
+namespace Physics {
+
+namespace {
+
+// 接觸檢測時每個區塊包含的粒子數
+constexpr int kDetectBlockSize = 256;
+
+// 不依賴外部函式庫，始終可用，作為最低優先級的預設後端
+const bool kRegistered = CollisionBackendRegistry::registerBackend("simplified", 0, [] {
+    return std::unique_ptr<CollisionBackend>(new SimpleCollisionBackend());
+});
+
+} // namespace
+
+SimpleCollisionBackend::SimpleCollisionBackend() {
+    std::cout << "Using simplified collision detection" << std::endl;
+}
+
+void SimpleCollisionBackend::addCylinder(const glm::vec3& center, float radius, float height) {
+    m_staticObjects.emplace_back(CollisionObject::CYLINDER, center, glm::vec3(radius, height, radius));
+
+    std::cout << "Added simplified cylinder: center(" << center.x << ", " << center.y << ", " << center.z
+              << "), radius=" << radius << ", height=" << height << std::endl;
+}
+
+void SimpleCollisionBackend::addFloor(const glm::vec3& center, const glm::vec3& size) {
+    m_staticObjects.emplace_back(CollisionObject::BOX, center, size);
+
+    std::cout << "Added simplified floor: center(" << center.x << ", " << center.y << ", " << center.z
+              << "), size(" << size.x << ", " << size.y << ", " << size.z << ")" << std::endl;
+}
+
+void SimpleCollisionBackend::addTriangleMesh(const std::shared_ptr<TriangleMeshCollider>& mesh) {
+    if (!mesh) return;
+
+    m_staticObjects.emplace_back(CollisionObject::MESH, glm::vec3(0.0f), glm::vec3(0.0f));
+    m_staticObjects.back().mesh = mesh;
+
+    std::cout << "Added simplified triangle mesh: " << mesh->getTriangleCount() << " triangles" << std::endl;
+}
+
+int SimpleCollisionBackend::addParticle(int particleIndex, const glm::vec3& position, float radius) {
+    if (particleIndex < 0) return -1;
+
+    m_particles.emplace_back(CollisionObject::SPHERE, position, glm::vec3(radius), particleIndex);
+    return static_cast<int>(m_particles.size()) - 1;
+}
+
+void SimpleCollisionBackend::updateParticlePosition(int handle, const glm::vec3& position) {
+    if (handle < 0 || handle >= static_cast<int>(m_particles.size())) return;
+    m_particles[handle].center = position;
+}
+
+void SimpleCollisionBackend::removeParticle(int handle) {
+    if (handle < 0 || handle >= static_cast<int>(m_particles.size())) return;
+
+    // 保留槽位，其他句柄不變
+    m_particles[handle].particleIndex = -1;
+}
+
+void SimpleCollisionBackend::performCollisionDetection(std::vector<OGCContact>& contacts,
+                                                       const ParallelSettings& settings,
+                                                       const std::vector<char>* skipMask) {
+    contacts.clear();
+
+    // 網格的逐粒子命中快取需在平行查詢前配置好
+    int particleLimit = 0;
+    for (const CollisionObject& particle : m_particles) {
+        particleLimit = std::max(particleLimit, particle.particleIndex + 1);
+    }
+    for (const CollisionObject& staticObject : m_staticObjects) {
+        if (staticObject.mesh) staticObject.mesh->reserveHints(particleLimit);
+    }
+
+    // 檢查每個粒子與靜態物體的碰撞 (區塊邊界固定，與執行緒數無關)
+    int particleCount = static_cast<int>(m_particles.size());
+    int blockCount = (particleCount + kDetectBlockSize - 1) / kDetectBlockSize;
+    m_blockContacts.resize(blockCount);
+
+    ParallelSettings blockSettings(settings.threadCount, settings.deterministic, 1);
+    parallelFor(blockCount, blockSettings, [&](int blockBegin, int blockEnd) {
+        for (int block = blockBegin; block < blockEnd; ++block) {
+            std::vector<OGCContact>& blockContacts = m_blockContacts[block];
+            blockContacts.clear();
+
+            int begin = block * kDetectBlockSize;
+            int end = std::min(particleCount, begin + kDetectBlockSize);
+            for (int handle = begin; handle < end; ++handle) {
+                const CollisionObject& particle = m_particles[handle];
+                if (particle.particleIndex < 0 || isSkipped(skipMask, particle.particleIndex)) continue;
+
+                for (size_t objectIndex = 0; objectIndex < m_staticObjects.size(); ++objectIndex) {
+                    OGCContact contact;
+                    if (checkCollision(particle, m_staticObjects[objectIndex], contact)) {
+                        contact.featureId = static_cast<int>(objectIndex);
+                        blockContacts.push_back(contact);
+                    }
+                }
+            }
+        }
+    });
+
+    // 按區塊順序壓實合併
+    compactBlocks(m_blockContacts, contacts, settings);
+}
+
+bool SimpleCollisionBackend::checkCollision(const CollisionObject& sphere, const CollisionObject& other,
+                                            OGCContact& contact) const {
+    if (other.type == CollisionObject::CYLINDER) {
+        return checkSphereCylinderCollision(sphere, other, contact);
+    } else if (other.type == CollisionObject::BOX) {
+        return checkSphereBoxCollision(sphere, other, contact);
+    } else if (other.type == CollisionObject::MESH) {
+        return other.mesh->generateContact(sphere.particleIndex, sphere.center, sphere.size.x, contact);
+    }
+    return false;
+}
+
+bool SimpleCollisionBackend::checkSphereCylinderCollision(const CollisionObject& sphere,
+                                                          const CollisionObject& cylinder, OGCContact& contact) const {
+    glm::vec3 spherePos = sphere.center;
+    float sphereRadius = sphere.size.x;
+
+    glm::vec3 cylinderPos = cylinder.center;
+    float cylinderRadius = cylinder.size.x;
+    float cylinderHeight = cylinder.size.y;
+
+    // 檢查垂直範圍
+    float yMin = cylinderPos.y - cylinderHeight * 0.5f;
+    float yMax = cylinderPos.y + cylinderHeight * 0.5f;
+
+    if (spherePos.y < yMin - sphereRadius || spherePos.y > yMax + sphereRadius) {
+        return false; // 不在圓柱體的高度範圍內
+    }
+
+    // 計算到圓柱體軸的距離
+    glm::vec2 sphereXZ(spherePos.x, spherePos.z);
+    glm::vec2 cylinderXZ(cylinderPos.x, cylinderPos.z);
+    float distanceToAxis = glm::length(sphereXZ - cylinderXZ);
+
+    // 檢查是否碰撞
+    float totalRadius = sphereRadius + cylinderRadius;
+    if (distanceToAxis < totalRadius) {
+        // 計算接觸點和法線
+        glm::vec2 direction = glm::normalize(sphereXZ - cylinderXZ);
+        glm::vec3 contactNormal = glm::vec3(direction.x, 0.0f, direction.y);
+
+        // 限制 Y 座標在圓柱體範圍內
+        float contactY = std::max(yMin, std::min(yMax, spherePos.y));
+
+        contact.particleIndexA = sphere.particleIndex;
+        contact.particleIndexB = -1;
+        contact.contactPoint = cylinderPos + glm::vec3(direction.x * cylinderRadius, contactY - cylinderPos.y, direction.y * cylinderRadius);
+        contact.contactNormal = contactNormal;
+        contact.penetrationDepth = totalRadius - distanceToAxis;
+
+        return true;
+    }
+
+    return false;
+}
+
+bool SimpleCollisionBackend::checkSphereBoxCollision(const CollisionObject& sphere, const CollisionObject& box,
+                                                     OGCContact& contact) const {
+    glm::vec3 spherePos = sphere.center;
+    float sphereRadius = sphere.size.x;
+
+    glm::vec3 boxPos = box.center;
+    glm::vec3 boxSize = box.size;
+
+    // 計算最近點
+    glm::vec3 closestPoint = glm::clamp(spherePos, boxPos - boxSize * 0.5f, boxPos + boxSize * 0.5f);
+
+    // 檢查距離
+    glm::vec3 diff = spherePos - closestPoint;
+    float distance = glm::length(diff);
+
+    if (distance < sphereRadius) {
+        contact.particleIndexA = sphere.particleIndex;
+        contact.particleIndexB = -1;
+        contact.contactPoint = closestPoint;
+        contact.contactNormal = (distance > 0.001f) ? glm::normalize(diff) : glm::vec3(0.0f, 1.0f, 0.0f);
+        contact.penetrationDepth = sphereRadius - distance;
+
+        return true;
+    }
+
+    return false;
+}
+
+} // namespace Physics
@@ -0,0 +1,75 @@
+#include "physics/SweepAndPrune.h"
+#include <algorithm>
+
+namespace Physics {
+
+void SweepAndPrune::resize(int probeCount, int colliderCount) {
+    if (probeCount == m_probeCount && colliderCount == m_colliderCount && !m_endpoints.empty()) return;
+
+    m_probeCount = probeCount;
+    m_colliderCount = colliderCount;
+    int objectCount = probeCount + colliderCount;
+    m_boundsMin.assign(objectCount, glm::vec3(0.0f));
+    m_boundsMax.assign(objectCount, glm::vec3(0.0f));
+    m_activeSlot.assign(objectCount, -1);
+
+    // 新的端點集合：第一次 update 的插入排序相當於完整排序
+    m_endpoints.resize(2 * objectCount);
+    for (int object = 0; object < objectCount; ++object) {
+        m_endpoints[2 * object] = Endpoint{0.0f, static_cast<uint32_t>(2 * object)};
+        m_endpoints[2 * object + 1] = Endpoint{0.0f, static_cast<uint32_t>(2 * object + 1)};
+    }
+}
+
+void SweepAndPrune::update(std::vector<Pair>& pairs) {
+    pairs.clear();
+
+    // 1. 更新端點值並插入排序 (幀間連貫時只有少量交換)
+    for (Endpoint& endpoint : m_endpoints) {
+        int object = static_cast<int>(endpoint.key >> 1);
+        endpoint.value = (endpoint.key & 1u) ? m_boundsMax[object].x : m_boundsMin[object].x;
+    }
+    m_swapCount = 0;
+    for (size_t i = 1; i < m_endpoints.size(); ++i) {
+        Endpoint endpoint = m_endpoints[i];
+        size_t j = i;
+        while (j > 0 && precedes(endpoint, m_endpoints[j - 1])) {
+            m_endpoints[j] = m_endpoints[j - 1];
+            --j;
+        }
+        m_swapCount += static_cast<int>(i - j);
+        m_endpoints[j] = endpoint;
+    }
+
+    // 2. 掃掠：起點與另一類的活躍物件比較 Y/Z，終點把物件移出活躍集
+    m_activeProbes.clear();
+    m_activeColliders.clear();
+    for (const Endpoint& endpoint : m_endpoints) {
+        int object = static_cast<int>(endpoint.key >> 1);
+        bool isProbe = object < m_probeCount;
+        std::vector<int>& active = isProbe ? m_activeProbes : m_activeColliders;
+
+        if (endpoint.key & 1u) {
+            int slot = m_activeSlot[object];
+            active[slot] = active.back();
+            m_activeSlot[active[slot]] = slot;
+            active.pop_back();
+            m_activeSlot[object] = -1;
+            continue;
+        }
+
+        if (isProbe) {
+            for (int other : m_activeColliders) {
+                if (overlapsYZ(object, other)) pairs.push_back(Pair{object, other - m_probeCount});
+            }
+        } else {
+            for (int other : m_activeProbes) {
+                if (overlapsYZ(object, other)) pairs.push_back(Pair{other, object - m_probeCount});
+            }
+        }
+        m_activeSlot[object] = static_cast<int>(active.size());
+        active.push_back(object);
+    }
+}
+
+} // namespace Physics
@@ -0,0 +1,313 @@
+#include "physics/TaskScheduler.h"
+#include <algorithm>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace Physics {
+
+namespace {
+
+// 當前執行緒所屬的排程器與佇列索引 (非工作執行緒為 nullptr / -1)
+thread_local TaskScheduler* t_scheduler = nullptr;
+thread_local int t_workerIndex = -1;
+
+// 等待者在休眠前自旋的次數 (短的竊取任務通常在此期間完成)
+constexpr int kWaitSpinCount = 64;
+
+void pinCurrentThread(int core) {
+#ifdef __linux__
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(core % std::max(1, TaskScheduler::hardwareThreadCount()), &cpuSet);
+    pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+#else
+    (void)core;
+#endif
+}
+
+} // namespace
+
+void TaskScheduler::WorkQueue::pushBack(Task* task) {
+    if (count == slots.size()) {
+        // 按邏輯順序搬到加倍的新緩衝
+        std::vector<Task*> grown(std::max<size_t>(16, slots.size() * 2), nullptr);
+        for (size_t i = 0; i < count; ++i) {
+            grown[i] = slots[(head + i) & (slots.size() - 1)];
+        }
+        slots.swap(grown);
+        head = 0;
+    }
+    slots[(head + count) & (slots.size() - 1)] = task;
+    ++count;
+}
+
+Task* TaskScheduler::WorkQueue::popBack() {
+    Task* task = back();
+    --count;
+    return task;
+}
+
+Task* TaskScheduler::WorkQueue::popFront() {
+    Task* task = slots[head];
+    head = (head + 1) & (slots.size() - 1);
+    --count;
+    return task;
+}
+
+TaskScheduler::TaskScheduler()
+    : m_workerCount(0)
+    , m_queuedTasks(0)
+    , m_sleepingWorkers(0)
+    , m_stopping(false)
+{
+    for (auto& queue : m_queues) {
+        queue = std::make_unique<WorkQueue>();
+    }
+}
+
+TaskScheduler::~TaskScheduler() {
+    std::lock_guard<std::mutex> lock(m_configMutex);
+    stopWorkers();
+}
+
+TaskScheduler& TaskScheduler::instance() {
+    static TaskScheduler scheduler;
+    return scheduler;
+}
+
+int TaskScheduler::hardwareThreadCount() {
+    return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+}
+
+void TaskScheduler::configure(const SchedulerSettings& settings) {
+    std::lock_guard<std::mutex> lock(m_configMutex);
+    stopWorkers();
+    m_settings = settings;
+    startWorkers(std::min(std::max(0, settings.workerCount), kMaxWorkers));
+}
+
+void TaskScheduler::reserveWorkers(int workerCount) {
+    workerCount = std::min(workerCount, kMaxWorkers);
+    if (workerCount <= getWorkerCount()) return;
+
+    std::lock_guard<std::mutex> lock(m_configMutex);
+    if (workerCount > getWorkerCount()) {
+        m_settings.workerCount = workerCount;
+        startWorkers(workerCount);
+    }
+}
+
+void TaskScheduler::startWorkers(int workerCount) {
+    // 佇列預先配置，新增執行緒時其他執行緒可安全地並行竊取
+    for (int index = static_cast<int>(m_workers.size()); index < workerCount; ++index) {
+        m_workers.emplace_back(&TaskScheduler::workerLoop, this, index);
+    }
+    m_workerCount.store(workerCount, std::memory_order_release);
+}
+
+void TaskScheduler::stopWorkers() {
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+    m_workers.clear();
+    m_workerCount.store(0, std::memory_order_release);
+    m_stopping = false;
+}
+
+int TaskScheduler::currentQueue() const {
+    return (t_scheduler == this && t_workerIndex >= 0) ? t_workerIndex : kMaxWorkers;
+}
+
+void TaskScheduler::submit(Task& task) {
+    WorkQueue& queue = *m_queues[currentQueue()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.pushBack(&task);
+    }
+    m_queuedTasks.fetch_add(1);
+
+    // 先增加計數再檢查休眠數：與 workerLoop 的順序相反，兩者至少一方能看見對方
+    if (m_sleepingWorkers.load() > 0) {
+        { std::lock_guard<std::mutex> lock(m_sleepMutex); }
+        m_wake.notify_one();
+    }
+}
+
+bool TaskScheduler::runOwnTask(TaskGroup& group) {
+    WorkQueue& queue = *m_queues[currentQueue()];
+    Task* task = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.empty() && queue.back()->group == &group) {
+            task = queue.popBack();
+        }
+    }
+    if (!task) return false;
+
+    m_queuedTasks.fetch_sub(1, std::memory_order_relaxed);
+    execute(task);
+    return true;
+}
+
+Task* TaskScheduler::steal(int thief) {
+    int workerCount = getWorkerCount();
+    int queueCount = workerCount + 1;
+
+    // 從竊取者的下一個佇列開始輪詢，注入佇列排在最後
+    for (int offset = 1; offset <= queueCount; ++offset) {
+        int slot = (thief + offset) % queueCount;
+        int index = slot == workerCount ? kMaxWorkers : slot;
+        if (index == thief) continue;
+
+        WorkQueue& queue = *m_queues[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.empty()) {
+            Task* task = queue.popFront();
+            m_queuedTasks.fetch_sub(1, std::memory_order_relaxed);
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+void TaskScheduler::execute(Task* task) {
+    // 遞減計數後任務物件可能已被等待者釋放，先取出群組
+    TaskGroup* group = task->group;
+    task->execute(task->data);
+    group->finishTask();
+}
+
+void TaskScheduler::workerLoop(int index) {
+    t_scheduler = this;
+    t_workerIndex = index;
+    if (m_settings.pinThreads) {
+        pinCurrentThread(m_settings.firstCore + index);
+    }
+
+    WorkQueue& ownQueue = *m_queues[index];
+    while (!m_stopping) {
+        Task* task = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(ownQueue.mutex);
+            if (!ownQueue.empty()) {
+                task = ownQueue.popBack();
+            }
+        }
+        if (task) {
+            m_queuedTasks.fetch_sub(1, std::memory_order_relaxed);
+        } else {
+            task = steal(index);
+        }
+
+        if (task) {
+            execute(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_sleepingWorkers.fetch_add(1);
+        m_wake.wait(lock, [this] { return m_queuedTasks.load() > 0 || m_stopping; });
+        m_sleepingWorkers.fetch_sub(1);
+    }
+}
+
+void TaskGroup::run(Task& task) {
+    task.group = this;
+    m_pending.fetch_add(1, std::memory_order_relaxed);
+
+    // 沒有工作執行緒時直接在當前執行緒執行
+    if (m_scheduler.getWorkerCount() == 0) {
+        m_scheduler.execute(&task);
+        return;
+    }
+    m_scheduler.submit(task);
+}
+
+void TaskGroup::finishTask() {
+    // 在鎖內遞減：等待者返回前會取得同一把鎖，之後不會再存取已釋放的群組
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1 && m_waiting) {
+        m_done.notify_all();
+    }
+}
+
+void TaskGroup::wait() {
+    int spins = 0;
+    while (m_pending.load(std::memory_order_acquire) > 0) {
+        if (m_scheduler.runOwnTask(*this)) {
+            spins = 0;
+            continue;
+        }
+        if (spins < kWaitSpinCount) {
+            ++spins;
+            std::this_thread::yield();
+            continue;
+        }
+
+        // 自己的任務已取完，剩下的都被竊取並在執行中 (只有本執行緒會往自己的佇列提交)
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_waiting = true;
+        m_done.wait(lock, [this] { return m_pending.load(std::memory_order_acquire) == 0; });
+        m_waiting = false;
+    }
+
+    // 與最後一個 finishTask 的臨界區同步，之後呼叫者才能釋放群組
+    std::lock_guard<std::mutex> lock(m_mutex);
+}
+
+int TaskGraph::addNode(NodeFn fn) {
+    auto node = std::make_unique<Node>();
+    node->graph = this;
+    node->fn = std::move(fn);
+    node->task.execute = &TaskGraph::executeNode;
+    node->task.data = node.get();
+    m_nodes.push_back(std::move(node));
+    return static_cast<int>(m_nodes.size()) - 1;
+}
+
+void TaskGraph::addDependency(int before, int after) {
+    m_nodes[before]->successors.push_back(after);
+    m_nodes[after]->predecessorCount++;
+}
+
+void TaskGraph::executeNode(void* data) {
+    Node& node = *static_cast<Node*>(data);
+    node.fn();
+
+    // 最後一個完成的前驅負責提交後繼
+    TaskGraph& graph = *node.graph;
+    for (int successor : node.successors) {
+        Node& next = *graph.m_nodes[successor];
+        if (next.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            graph.m_group->run(next.task);
+        }
+    }
+}
+
+void TaskGraph::run(TaskScheduler& scheduler) {
+    if (m_nodes.empty()) return;
+
+    for (auto& node : m_nodes) {
+        node->remaining.store(node->predecessorCount, std::memory_order_relaxed);
+    }
+
+    TaskGroup group(scheduler);
+    m_group = &group;
+    for (auto& node : m_nodes) {
+        if (node->predecessorCount == 0) {
+            group.run(node->task);
+        }
+    }
+    group.wait();
+    m_group = nullptr;
+}
+
+} // namespace Physics
@@ -0,0 +1,315 @@
+#include "physics/TriangleMeshCollider.h"
+#include "physics/Geometry.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Physics {
+
+namespace {
+
+// SAH 分箱數
+constexpr int kBinCount = 12;
+
+// 葉節點最多包含的三角形數
+constexpr int kMaxLeafSize = 4;
+
+// 最大樹深，保證查詢時的固定大小堆疊足夠
+constexpr int kMaxDepth = 60;
+
+// 粒子位於面背側時仍產生接觸的最大深度 (以粒子半徑為單位)
+constexpr float kInsideCutoffRadii = 4.0f;
+
+float surfaceArea(const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
+    glm::vec3 extent = glm::max(boundsMax - boundsMin, glm::vec3(0.0f));
+    return 2.0f * (extent.x * extent.y + extent.y * extent.z + extent.z * extent.x);
+}
+
+float distanceSqToBounds(const glm::vec3& position, const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
+    glm::vec3 delta = glm::max(glm::max(boundsMin - position, position - boundsMax), glm::vec3(0.0f));
+    return glm::dot(delta, delta);
+}
+
+} // namespace
+
+TriangleMeshCollider::TriangleMeshCollider(const std::vector<glm::vec3>& vertices,
+                                           const std::vector<glm::ivec3>& triangles)
+    : m_vertices(vertices)
+    , m_triangles(triangles)
+{
+    build();
+
+    m_faceNormals.resize(m_triangles.size());
+    for (size_t t = 0; t < m_triangles.size(); ++t) {
+        const glm::ivec3& triangle = m_triangles[t];
+        glm::vec3 normal = glm::cross(m_vertices[triangle.y] - m_vertices[triangle.x],
+                                      m_vertices[triangle.z] - m_vertices[triangle.x]);
+        float length = glm::length(normal);
+        m_faceNormals[t] = length > 1e-12f ? normal / length : glm::vec3(0.0f, 1.0f, 0.0f);
+    }
+}
+
+void TriangleMeshCollider::build() {
+    int triangleCount = static_cast<int>(m_triangles.size());
+    m_nodes.clear();
+    if (triangleCount == 0) return;
+
+    std::vector<glm::vec3> boundsMin(triangleCount), boundsMax(triangleCount), centroids(triangleCount);
+    for (int t = 0; t < triangleCount; ++t) {
+        const glm::vec3& a = m_vertices[m_triangles[t].x];
+        const glm::vec3& b = m_vertices[m_triangles[t].y];
+        const glm::vec3& c = m_vertices[m_triangles[t].z];
+        boundsMin[t] = glm::min(a, glm::min(b, c));
+        boundsMax[t] = glm::max(a, glm::max(b, c));
+        centroids[t] = (a + b + c) / 3.0f;
+    }
+
+    std::vector<int> order(triangleCount);
+    for (int t = 0; t < triangleCount; ++t) order[t] = t;
+
+    struct BuildTask {
+        int node, begin, end, depth;
+    };
+    std::vector<BuildTask> stack;
+    m_nodes.reserve(2 * triangleCount / kMaxLeafSize + 1);
+    m_nodes.push_back(Node());
+    stack.push_back({0, 0, triangleCount, 0});
+
+    while (!stack.empty()) {
+        BuildTask task = stack.back();
+        stack.pop_back();
+
+        glm::vec3 nodeMin(std::numeric_limits<float>::max());
+        glm::vec3 nodeMax(-std::numeric_limits<float>::max());
+        glm::vec3 centroidMin(std::numeric_limits<float>::max());
+        glm::vec3 centroidMax(-std::numeric_limits<float>::max());
+        for (int i = task.begin; i < task.end; ++i) {
+            int t = order[i];
+            nodeMin = glm::min(nodeMin, boundsMin[t]);
+            nodeMax = glm::max(nodeMax, boundsMax[t]);
+            centroidMin = glm::min(centroidMin, centroids[t]);
+            centroidMax = glm::max(centroidMax, centroids[t]);
+        }
+        m_nodes[task.node].boundsMin = nodeMin;
+        m_nodes[task.node].boundsMax = nodeMax;
+
+        int count = task.end - task.begin;
+        auto makeLeaf = [&]() {
+            m_nodes[task.node].first = task.begin;
+            m_nodes[task.node].count = count;
+        };
+        if (count <= kMaxLeafSize || task.depth >= kMaxDepth) {
+            makeLeaf();
+            continue;
+        }
+
+        // 分箱 SAH：在三個軸上評估 kBinCount - 1 個切分平面
+        int bestAxis = -1;
+        int bestSplit = 0;
+        float bestCost = std::numeric_limits<float>::max();
+        glm::vec3 centroidExtent = centroidMax - centroidMin;
+
+        for (int axis = 0; axis < 3; ++axis) {
+            if (centroidExtent[axis] <= 1e-12f) continue;
+
+            struct Bin {
+                glm::vec3 boundsMin{std::numeric_limits<float>::max()};
+                glm::vec3 boundsMax{-std::numeric_limits<float>::max()};
+                int count = 0;
+            };
+            Bin bins[kBinCount];
+            float scale = kBinCount / centroidExtent[axis];
+
+            for (int i = task.begin; i < task.end; ++i) {
+                int t = order[i];
+                int bin = std::min(kBinCount - 1, static_cast<int>((centroids[t][axis] - centroidMin[axis]) * scale));
+                bins[bin].boundsMin = glm::min(bins[bin].boundsMin, boundsMin[t]);
+                bins[bin].boundsMax = glm::max(bins[bin].boundsMax, boundsMax[t]);
+                bins[bin].count++;
+            }
+
+            // 由右向左累積右側面積
+            float rightArea[kBinCount];
+            int rightCount[kBinCount];
+            glm::vec3 accumulatedMin(std::numeric_limits<float>::max());
+            glm::vec3 accumulatedMax(-std::numeric_limits<float>::max());
+            int accumulatedCount = 0;
+            for (int bin = kBinCount - 1; bin > 0; --bin) {
+                accumulatedMin = glm::min(accumulatedMin, bins[bin].boundsMin);
+                accumulatedMax = glm::max(accumulatedMax, bins[bin].boundsMax);
+                accumulatedCount += bins[bin].count;
+                rightArea[bin] = surfaceArea(accumulatedMin, accumulatedMax);
+                rightCount[bin] = accumulatedCount;
+            }
+
+            accumulatedMin = glm::vec3(std::numeric_limits<float>::max());
+            accumulatedMax = glm::vec3(-std::numeric_limits<float>::max());
+            accumulatedCount = 0;
+            for (int split = 1; split < kBinCount; ++split) {
+                accumulatedMin = glm::min(accumulatedMin, bins[split - 1].boundsMin);
+                accumulatedMax = glm::max(accumulatedMax, bins[split - 1].boundsMax);
+                accumulatedCount += bins[split - 1].count;
+                if (accumulatedCount == 0 || rightCount[split] == 0) continue;
+
+                float cost = accumulatedCount * surfaceArea(accumulatedMin, accumulatedMax) +
+                             rightCount[split] * rightArea[split];
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestSplit = split;
+                }
+            }
+        }
+
+        // 質心重合，無法切分
+        if (bestAxis < 0) {
+            makeLeaf();
+            continue;
+        }
+
+        float scale = kBinCount / centroidExtent[bestAxis];
+        auto middle = std::partition(order.begin() + task.begin, order.begin() + task.end, [&](int t) {
+            int bin = std::min(kBinCount - 1,
+                               static_cast<int>((centroids[t][bestAxis] - centroidMin[bestAxis]) * scale));
+            return bin < bestSplit;
+        });
+        int mid = static_cast<int>(middle - order.begin());
+
+        int left = static_cast<int>(m_nodes.size());
+        m_nodes.push_back(Node());
+        m_nodes.push_back(Node());
+        m_nodes[task.node].first = left;
+        m_nodes[task.node].count = 0;
+
+        stack.push_back({left + 1, mid, task.end, task.depth + 1});
+        stack.push_back({left, task.begin, mid, task.depth + 1});
+    }
+
+    // 按葉節點順序重排三角形，查詢時連續存取
+    std::vector<glm::ivec3> ordered(triangleCount);
+    for (int i = 0; i < triangleCount; ++i) {
+        ordered[i] = m_triangles[order[i]];
+    }
+    m_triangles.swap(ordered);
+}
+
+float TriangleMeshCollider::closestOnTriangle(int triangle, const glm::vec3& position, glm::vec3& closest) const {
+    const glm::ivec3& indices = m_triangles[triangle];
+    const glm::vec3& a = m_vertices[indices.x];
+    const glm::vec3& b = m_vertices[indices.y];
+    const glm::vec3& c = m_vertices[indices.z];
+    glm::vec3 weights = closestPointOnTriangle(position, a, b, c);
+    closest = weights.x * a + weights.y * b + weights.z * c;
+    glm::vec3 delta = position - closest;
+    return glm::dot(delta, delta);
+}
+
+bool TriangleMeshCollider::closestPoint(const glm::vec3& position, float maxDistance, int& triangleHint,
+                                        glm::vec3& closest) const {
+    if (m_nodes.empty()) return false;
+
+    float bestDistanceSq = maxDistance * maxDistance;
+    int bestTriangle = -1;
+
+    // 以上一幀命中的三角形收緊初始搜尋半徑
+    if (triangleHint >= 0 && triangleHint < static_cast<int>(m_triangles.size())) {
+        glm::vec3 candidate;
+        float distanceSq = closestOnTriangle(triangleHint, position, candidate);
+        if (distanceSq <= bestDistanceSq) {
+            bestDistanceSq = distanceSq;
+            bestTriangle = triangleHint;
+            closest = candidate;
+        }
+    }
+
+    int stack[64];
+    int stackSize = 0;
+    stack[stackSize++] = 0;
+
+    while (stackSize > 0) {
+        const Node& node = m_nodes[stack[--stackSize]];
+        if (distanceSqToBounds(position, node.boundsMin, node.boundsMax) > bestDistanceSq) continue;
+
+        if (node.count > 0) {
+            for (int t = node.first; t < node.first + node.count; ++t) {
+                if (t == bestTriangle) continue;
+
+                glm::vec3 candidate;
+                float distanceSq = closestOnTriangle(t, position, candidate);
+                if (distanceSq < bestDistanceSq) {
+                    bestDistanceSq = distanceSq;
+                    bestTriangle = t;
+                    closest = candidate;
+                }
+            }
+            continue;
+        }
+
+        // 先訪問較近的子節點 (後入棧)
+        const Node& left = m_nodes[node.first];
+        const Node& right = m_nodes[node.first + 1];
+        float leftDistance = distanceSqToBounds(position, left.boundsMin, left.boundsMax);
+        float rightDistance = distanceSqToBounds(position, right.boundsMin, right.boundsMax);
+        if (leftDistance < rightDistance) {
+            stack[stackSize++] = node.first + 1;
+            stack[stackSize++] = node.first;
+        } else {
+            stack[stackSize++] = node.first;
+            stack[stackSize++] = node.first + 1;
+        }
+    }
+
+    if (bestTriangle < 0) return false;
+    triangleHint = bestTriangle;
+    return true;
+}
+
+void TriangleMeshCollider::reserveHints(int particleCount) {
+    if (particleCount > static_cast<int>(m_triangleHints.size())) {
+        m_triangleHints.resize(particleCount, -1);
+    }
+}
+
+bool TriangleMeshCollider::generateContact(int particleIndex, const glm::vec3& position, float radius,
+                                           OGCContact& contact) {
+    if (particleIndex < 0) return false;
+    reserveHints(particleIndex + 1);
+
+    int& hint = m_triangleHints[particleIndex];
+    glm::vec3 closest;
+    if (!closestPoint(position, kInsideCutoffRadii * radius, hint, closest)) {
+        hint = -1;
+        return false;
+    }
+
+    const glm::vec3& faceNormal = m_faceNormals[hint];
+    glm::vec3 delta = position - closest;
+    float distance = glm::length(delta);
+    bool inside = glm::dot(delta, faceNormal) < 0.0f;
+
+    if (!inside && distance >= radius) return false;
+
+    contact.particleIndexA = particleIndex;
+    contact.particleIndexB = -1;
+    contact.contactPoint = closest;
+    if (inside) {
+        // 位於面背側：沿面法線推出
+        contact.contactNormal = faceNormal;
+        contact.penetrationDepth = radius + distance;
+    } else {
+        contact.contactNormal = distance > 1e-6f ? delta / distance : faceNormal;
+        contact.penetrationDepth = radius - distance;
+    }
+    return true;
+}
+
+float TriangleMeshCollider::distance(const glm::vec3& position) const {
+    int hint = -1;
+    glm::vec3 closest;
+    if (!closestPoint(position, std::numeric_limits<float>::max(), hint, closest)) {
+        return std::numeric_limits<float>::max();
+    }
+    return glm::length(position - closest);
+}
+
+} // namespace Physics
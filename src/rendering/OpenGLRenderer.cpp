@@ -6,6 +6,7 @@
 #include "physics/OGCContactModel.h"
 #include <iostream>
 #include <cmath>
+#include <algorithm>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -20,7 +21,10 @@ OpenGLRenderer::OpenGLRenderer()
     , m_sphereVAO(0), m_sphereVBO(0), m_sphereEBO(0)
     , m_cylinderVAO(0), m_cylinderVBO(0), m_cylinderEBO(0)
     , m_floorVAO(0), m_floorVBO(0), m_floorEBO(0)
-    , m_lineVAO(0), m_lineVBO(0)
+    , m_lineVAO(0), m_lineVBO(0), m_lineEBO(0)
+    , m_edgeTopologyVersion(kUncachedTopology)
+    , m_edgeIndexCount(0)
+    , m_edgeMaxIndex(0)
 {
 }
 
@@ -59,6 +63,7 @@ bool OpenGLRenderer::initialize(int width, int height, const char* title) {
     }
     
     glfwMakeContextCurrent(m_window);
+    glfwSwapInterval(1); // 垂直同步：渲染迴圈由顯示器節拍限速
     glfwSetWindowUserPointer(m_window, this);
     glfwSetFramebufferSizeCallback(m_window, framebufferSizeCallback);
     
@@ -107,6 +112,7 @@ void OpenGLRenderer::cleanup() {
     if (m_floorEBO) glDeleteBuffers(1, &m_floorEBO);
     if (m_lineVAO) glDeleteVertexArrays(1, &m_lineVAO);
     if (m_lineVBO) glDeleteBuffers(1, &m_lineVBO);
+    if (m_lineEBO) glDeleteBuffers(1, &m_lineEBO);
     
     // 清理 GLFW
     if (m_window) {
@@ -197,7 +203,16 @@ void OpenGLRenderer::processInput() {
 }
 
 void OpenGLRenderer::renderClothParticles(const std::vector<Physics::Particle*>& particles) {
-    if (!m_basicShader || particles.empty()) return;
+    std::vector<glm::vec3> positions;
+    positions.reserve(particles.size());
+    for (const auto& particle : particles) {
+        positions.push_back(particle->getPosition());
+    }
+    renderClothParticles(positions);
+}
+
+void OpenGLRenderer::renderClothParticles(Physics::Span<const glm::vec3> positions) {
+    if (!m_basicShader || positions.empty()) return;
     
     glm::mat4 view = m_camera->getViewMatrix();
     glm::mat4 projection = m_camera->getProjectionMatrix(
@@ -211,9 +226,9 @@ void OpenGLRenderer::renderClothParticles(const std::vector<Physics::Particle*>&
     
     glBindVertexArray(m_sphereVAO);
     
-    for (const auto& particle : particles) {
+    for (const auto& position : positions) {
         glm::mat4 model = glm::mat4(1.0f);
-        model = glm::translate(model, particle->getPosition());
+        model = glm::translate(model, position);
         model = glm::scale(model, glm::vec3(0.02f)); // 小球體
         
         m_basicShader->setMatrix4("model", model);
@@ -225,7 +240,28 @@ void OpenGLRenderer::renderClothParticles(const std::vector<Physics::Particle*>&
 
 void OpenGLRenderer::renderClothConstraints(const std::vector<Physics::Particle*>& particles,
                                            const std::vector<std::pair<int, int>>& constraints) {
-    if (!m_lineShader || particles.empty() || constraints.empty()) return;
+    std::vector<glm::vec3> positions;
+    positions.reserve(particles.size());
+    for (const auto& particle : particles) {
+        positions.push_back(particle->getPosition());
+    }
+    
+    std::vector<uint32_t> edgeIndices;
+    edgeIndices.reserve(2 * constraints.size());
+    for (const auto& constraint : constraints) {
+        if (constraint.first >= 0 && constraint.first < static_cast<int>(particles.size()) &&
+            constraint.second >= 0 && constraint.second < static_cast<int>(particles.size())) {
+            edgeIndices.push_back(static_cast<uint32_t>(constraint.first));
+            edgeIndices.push_back(static_cast<uint32_t>(constraint.second));
+        }
+    }
+    renderClothConstraints(positions, edgeIndices, kUncachedTopology);
+}
+
+void OpenGLRenderer::renderClothConstraints(Physics::Span<const glm::vec3> positions,
+                                           Physics::Span<const uint32_t> edgeIndices,
+                                           uint64_t topologyVersion) {
+    if (!m_lineShader || positions.empty() || edgeIndices.empty()) return;
     
     glm::mat4 view = m_camera->getViewMatrix();
     glm::mat4 projection = m_camera->getProjectionMatrix(
@@ -239,23 +275,26 @@ void OpenGLRenderer::renderClothConstraints(const std::vector<Physics::Particle*
     
     glBindVertexArray(m_lineVAO);
     
-    for (const auto& constraint : constraints) {
-        if (constraint.first < particles.size() && constraint.second < particles.size()) {
-            glm::vec3 pos1 = particles[constraint.first]->getPosition();
-            glm::vec3 pos2 = particles[constraint.second]->getPosition();
-            
-            float lineData[] = {
-                pos1.x, pos1.y, pos1.z,
-                pos2.x, pos2.y, pos2.z
-            };
-            
-            glBindBuffer(GL_ARRAY_BUFFER, m_lineVBO);
-            glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(lineData), lineData);
-            
-            glDrawArrays(GL_LINES, 0, 2);
+    // 邊索引只在拓撲改變時上傳
+    if (topologyVersion == kUncachedTopology || topologyVersion != m_edgeTopologyVersion ||
+        edgeIndices.size() != m_edgeIndexCount) {
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, edgeIndices.size() * sizeof(uint32_t),
+                     edgeIndices.data(), GL_STATIC_DRAW);
+        m_edgeTopologyVersion = topologyVersion;
+        m_edgeIndexCount = edgeIndices.size();
+        m_edgeMaxIndex = 0;
+        for (uint32_t index : edgeIndices) {
+            m_edgeMaxIndex = std::max(m_edgeMaxIndex, index);
         }
     }
     
+    // 位置整批上傳 (重新指定大小以讓驅動丟棄舊緩衝)，一次繪製所有線段
+    if (m_edgeMaxIndex < positions.size()) {
+        glBindBuffer(GL_ARRAY_BUFFER, m_lineVBO);
+        glBufferData(GL_ARRAY_BUFFER, positions.size() * sizeof(glm::vec3), positions.data(), GL_DYNAMIC_DRAW);
+        glDrawElements(GL_LINES, static_cast<GLsizei>(m_edgeIndexCount), GL_UNSIGNED_INT, 0);
+    }
+    
     glBindVertexArray(0);
 }
 
@@ -409,10 +448,12 @@ void OpenGLRenderer::createGeometry() {
     // 創建線條 VAO
     glGenVertexArrays(1, &m_lineVAO);
     glGenBuffers(1, &m_lineVBO);
+    glGenBuffers(1, &m_lineEBO);
     
     glBindVertexArray(m_lineVAO);
     glBindBuffer(GL_ARRAY_BUFFER, m_lineVBO);
     glBufferData(GL_ARRAY_BUFFER, 6 * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_lineEBO); // 索引緩衝綁定記錄在 VAO 中
     
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
@@ -0,0 +1,107 @@
+#include "TestSupport.h"
+#include "physics/ClothSimulation.h"
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <new>
+
+/**
+ * @brief 計數版全域 operator new (只在量測期間計數)
+ */
+namespace {
+
+std::atomic<bool> g_counting{false};
+std::atomic<long> g_allocations{0};
+
+void* countedAllocate(std::size_t size) {
+    if (g_counting.load(std::memory_order_relaxed)) {
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    void* pointer = std::malloc(size ? size : 1);
+    if (!pointer) throw std::bad_alloc();
+    return pointer;
+}
+
+} // namespace
+
+void* operator new(std::size_t size) { return countedAllocate(size); }
+void* operator new[](std::size_t size) { return countedAllocate(size); }
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { std::free(pointer); }
+
+using namespace Physics;
+
+namespace {
+
+/**
+ * @brief 預熱後量測每步的配置次數
+ * @return 量測期間的總配置次數
+ */
+long measureSteadyState(const char* name, int threadCount, const std::function<void(ClothSimulation&)>& configure) {
+    ClothSimulation simulation;
+    CHECK(simulation.initialize(24, 24, glm::vec2(2.0f, 2.0f), glm::vec3(0.0f, 1.0f, 0.0f)));
+    simulation.setThreadCount(threadCount);
+    simulation.setDeterministic(true);
+    simulation.addCylinder(glm::vec3(0.0f, 0.3f, 0.0f), 0.5f, 0.6f);
+    simulation.addFloor(glm::vec3(0.0f, -0.05f, 0.0f), glm::vec3(5.0f, 0.1f, 5.0f));
+    simulation.setParticlesFixed({0, 23, 552, 575}, true);     // 四角固定，布料垂掛在圓柱上保持接觸
+    configure(simulation);
+
+    // 預熱：各緩衝 (包括逐區塊的接觸緩衝) 達到高水位
+    for (int step = 0; step < 300; ++step) {
+        simulation.update(1.0f / 60.0f);
+    }
+    CHECK(!simulation.getContacts().empty());
+
+    const int measuredSteps = 60;
+    g_allocations.store(0);
+    g_counting.store(true);
+    for (int step = 0; step < measuredSteps; ++step) {
+        simulation.update(1.0f / 60.0f);
+    }
+    g_counting.store(false);
+
+    long allocations = g_allocations.load();
+    if (allocations != 0) {
+        std::fprintf(stderr, "%s (%d threads): %ld allocations in %d steps\n", name, threadCount, allocations,
+                     measuredSteps);
+    }
+    return allocations;
+}
+
+} // namespace
+
+int main() {
+    auto none = [](ClothSimulation&) {};
+    auto cached = [](ClothSimulation& simulation) {
+        simulation.setContactCacheEnabled(true);
+        simulation.setDisplacementBoundsEnabled(true);
+    };
+
+    auto allStages = [](ClothSimulation& simulation) {
+        simulation.setSelfCollisionEnabled(true);
+        simulation.setTriangleCollisionEnabled(true);
+        simulation.setContinuousCollisionEnabled(true);
+        simulation.setNarrowBandEnabled(true);
+        simulation.setContactReductionEnabled(true);
+        simulation.setContactProjectionEnabled(true);
+        simulation.addSphere(glm::vec3(0.6f, 0.2f, 0.3f), 0.3f);
+    };
+
+    for (int threadCount : {1, 4}) {
+        CHECK(measureSteadyState("default", threadCount, none) == 0);
+        CHECK(measureSteadyState("cache+bounds", threadCount, cached) == 0);
+        CHECK(measureSteadyState("all-stages", threadCount, allStages) == 0);
+    }
+
+    // 確認計數器本身有效
+    g_counting.store(true);
+    int* probe = new int(1);
+    g_counting.store(false);
+    CHECK(g_allocations.load() >= 1);
+    delete probe;
+
+    return TEST_RESULT();
+}
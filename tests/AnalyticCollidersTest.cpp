@@ -0,0 +1,223 @@
+#include "TestSupport.h"
+#include "physics/AnalyticColliders.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+using namespace Physics;
+
+namespace {
+
+using Sdf = std::function<float(const glm::vec3&)>;
+
+float nextSigned(uint32_t& state) {
+    state = state * 1664525u + 1013904223u;
+    return static_cast<float>(state >> 8) / static_cast<float>(1u << 23) - 1.0f;
+}
+
+glm::mat3 rotationAboutZ(float angle) {
+    float c = std::cos(angle), s = std::sin(angle);
+    return glm::mat3(glm::vec3(c, s, 0.0f), glm::vec3(-s, c, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+}
+
+float boxDistance(const glm::vec3& local, const glm::vec3& halfExtents, float rounding) {
+    glm::vec3 q = glm::abs(local) - (halfExtents - glm::vec3(rounding));
+    return glm::length(glm::max(q, glm::vec3(0.0f))) + std::min(std::max(q.x, std::max(q.y, q.z)), 0.0f) - rounding;
+}
+
+/**
+ * @brief 批次核心 (數量不是 8 的倍數) 與逐點參考距離比較，外部點的法線與數值梯度比較
+ */
+void checkShape(const char* name, const AnalyticColliders& colliders, int collider, const Sdf& reference) {
+    uint32_t state = 17u + static_cast<uint32_t>(collider);
+    std::vector<glm::vec3> points;
+    for (int i = 0; i < 203; ++i) {
+        points.push_back(glm::vec3(1.5f * nextSigned(state), 1.5f * nextSigned(state), 1.5f * nextSigned(state)));
+    }
+
+    std::vector<float> distances(points.size());
+    std::vector<glm::vec3> normals(points.size());
+    colliders.query(collider, points.data(), static_cast<int>(points.size()), distances.data(), normals.data());
+
+    int failures = Test::failureCount();
+    const float h = 1e-3f;
+    for (size_t i = 0; i < points.size(); ++i) {
+        const glm::vec3& p = points[i];
+        CHECK_NEAR(distances[i], reference(p), 1e-4);
+        CHECK_NEAR(glm::length(normals[i]), 1.0, 1e-4);
+
+        if (distances[i] > 0.01f) {
+            glm::vec3 gradient(reference(p + glm::vec3(h, 0, 0)) - reference(p - glm::vec3(h, 0, 0)),
+                               reference(p + glm::vec3(0, h, 0)) - reference(p - glm::vec3(0, h, 0)),
+                               reference(p + glm::vec3(0, 0, h)) - reference(p - glm::vec3(0, 0, h)));
+            CHECK(glm::dot(normals[i], glm::normalize(gradient)) > 0.99f);
+        }
+    }
+    if (Test::failureCount() != failures) {
+        std::fprintf(stderr, "  in shape %s\n", name);
+    }
+}
+
+void testKernels() {
+    AnalyticColliders colliders;
+    const glm::mat3 rotation = rotationAboutZ(0.4f);
+    const glm::vec3 center(0.1f, -0.2f, 0.05f);
+
+    int sphere = colliders.addSphere(center, 0.6f);
+    checkShape("sphere", colliders, sphere, [&](const glm::vec3& p) { return glm::length(p - center) - 0.6f; });
+
+    glm::vec3 a(-0.5f, -0.3f, 0.1f), b(0.4f, 0.5f, -0.2f);
+    int capsule = colliders.addCapsule(a, b, 0.25f);
+    checkShape("capsule", colliders, capsule, [&](const glm::vec3& p) {
+        float t = glm::clamp(glm::dot(p - a, b - a) / glm::dot(b - a, b - a), 0.0f, 1.0f);
+        return glm::length(p - (a + t * (b - a))) - 0.25f;
+    });
+
+    glm::vec3 halfExtents(0.6f, 0.3f, 0.45f);
+    auto toLocal = [&](const glm::vec3& p) { return glm::transpose(rotation) * (p - center); };
+    int box = colliders.addOrientedBox(center, halfExtents, rotation);
+    checkShape("box", colliders, box, [&](const glm::vec3& p) { return boxDistance(toLocal(p), halfExtents, 0.0f); });
+
+    int rounded = colliders.addRoundedBox(center, halfExtents, rotation, 0.1f);
+    checkShape("rounded box", colliders, rounded,
+               [&](const glm::vec3& p) { return boxDistance(toLocal(p), halfExtents, 0.1f); });
+
+    glm::vec3 axis = glm::normalize(glm::vec3(0.2f, 1.0f, 0.1f));
+    int torus = colliders.addTorus(center, axis, 0.7f, 0.2f);
+    checkShape("torus", colliders, torus, [&](const glm::vec3& p) {
+        glm::vec3 offset = p - center;
+        float height = glm::dot(offset, axis);
+        float radial = glm::length(offset - height * axis) - 0.7f;
+        return std::sqrt(radial * radial + height * height) - 0.2f;
+    });
+
+    glm::vec3 planeNormal = glm::normalize(glm::vec3(0.3f, 1.0f, -0.2f));
+    int plane = colliders.addPlane(center, planeNormal);
+    checkShape("plane", colliders, plane, [&](const glm::vec3& p) { return glm::dot(p - center, planeNormal); });
+
+    CHECK(colliders.getColliderCount() == 6);
+}
+
+/**
+ * @brief 接觸集與暴力比對一致，且與執行緒數無關
+ */
+void testDetect() {
+    AnalyticColliders colliders;
+    colliders.addSphere(glm::vec3(0.0f, 0.0f, 0.0f), 0.3f);
+    colliders.addCapsule(glm::vec3(-1.0f, 0.5f, 0.0f), glm::vec3(1.0f, 0.5f, 0.0f), 0.1f);
+    colliders.addPlane(glm::vec3(0.0f, -0.8f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    colliders.setVelocity(0, glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 2.0f, 0.0f));
+
+    uint32_t state = 5u;
+    std::vector<glm::vec3> positions;
+    for (int i = 0; i < 3001; ++i) {
+        positions.push_back(glm::vec3(1.2f * nextSigned(state), nextSigned(state), 1.2f * nextSigned(state)));
+    }
+
+    const float radius = 0.05f;
+    std::vector<std::pair<int, int>> expected;
+    for (int i = 0; i < static_cast<int>(positions.size()); ++i) {
+        for (int c = 0; c < static_cast<int>(colliders.getColliderCount()); ++c) {
+            float distance;
+            glm::vec3 normal;
+            colliders.query(c, &positions[i], 1, &distance, &normal);
+            if (distance < radius) expected.push_back({i, c});
+        }
+    }
+    CHECK(!expected.empty());
+
+    std::vector<OGCContact> serial;
+    colliders.detect(positions, radius, serial, ParallelSettings(1, true));
+
+    std::vector<std::pair<int, int>> found;
+    for (const OGCContact& contact : serial) {
+        found.push_back({contact.particleIndexA, contact.featureId});
+        if (contact.featureId == 0) {
+            // 接觸點速度 = 線速度 + 角速度 × (接觸點 - 中心)
+            glm::vec3 velocity = glm::vec3(1.0f, 0.0f, 0.0f) + glm::cross(glm::vec3(0.0f, 2.0f, 0.0f), contact.contactPoint);
+            CHECK_NEAR(glm::length(contact.colliderVelocity - velocity), 0.0, 1e-5);
+        } else {
+            CHECK(contact.colliderVelocity == glm::vec3(0.0f));
+        }
+    }
+    std::sort(found.begin(), found.end());
+    CHECK(found == expected);
+
+    for (int threadCount : {2, 4, 16}) {
+        std::vector<OGCContact> parallel;
+        colliders.detect(positions, radius, parallel, ParallelSettings(threadCount, true));
+        CHECK(parallel.size() == serial.size());
+        for (size_t k = 0; k < std::min(parallel.size(), serial.size()); ++k) {
+            CHECK(parallel[k].particleIndexA == serial[k].particleIndexA);
+            CHECK(parallel[k].featureId == serial[k].featureId);
+            CHECK(parallel[k].penetrationDepth == serial[k].penetrationDepth);
+        }
+    }
+
+    // 單點距離取最近的碰撞體
+    CHECK_NEAR(colliders.distance(glm::vec3(0.0f, 0.0f, 0.5f)), 0.2, 1e-5);
+}
+
+/**
+ * @brief 運動學碰撞體：setTransform 後的距離與接觸集和新位姿一致 (寬相端點跨幀沿用)
+ */
+void testKinematic() {
+    AnalyticColliders colliders;
+    int capsule = colliders.addCapsule(glm::vec3(-0.4f, 0.0f, 0.0f), glm::vec3(0.4f, 0.0f, 0.0f), 0.1f);
+    int box = colliders.addOrientedBox(glm::vec3(0.0f, -0.6f, 0.0f), glm::vec3(0.3f, 0.1f, 0.3f), glm::mat3(1.0f));
+    colliders.addSphere(glm::vec3(0.0f, 0.6f, 0.0f), 0.2f);
+
+    uint32_t state = 29u;
+    std::vector<glm::vec3> positions;
+    for (int i = 0; i < 1001; ++i) {
+        positions.push_back(glm::vec3(nextSigned(state), nextSigned(state), nextSigned(state)));
+    }
+
+    const float radius = 0.05f;
+    for (int frame = 0; frame < 12; ++frame) {
+        float angle = 0.3f * frame;
+        glm::vec3 center(0.05f * frame - 0.3f, 0.0f, 0.0f);
+        colliders.setTransform(capsule, center, rotationAboutZ(angle));
+        colliders.setTransform(box, glm::vec3(0.0f, -0.6f, 0.04f * frame), rotationAboutZ(-angle));
+
+        // 膠囊的對稱軸取局部 Y 軸：軸端外 0.1 處距離為 0
+        glm::vec3 axis = rotationAboutZ(angle)[1];
+        glm::vec3 tip = center + (0.4f + 0.1f) * axis;
+        float distance;
+        glm::vec3 normal;
+        colliders.query(capsule, &tip, 1, &distance, &normal);
+        CHECK_NEAR(distance, 0.0, 1e-5);
+
+        std::vector<std::pair<int, int>> expected;
+        for (int i = 0; i < static_cast<int>(positions.size()); ++i) {
+            for (int c = 0; c < static_cast<int>(colliders.getColliderCount()); ++c) {
+                colliders.query(c, &positions[i], 1, &distance, &normal);
+                if (distance < radius) expected.push_back({i, c});
+            }
+        }
+
+        std::vector<OGCContact> contacts;
+        colliders.detect(positions, radius, contacts, ParallelSettings(4, true));
+        std::vector<std::pair<int, int>> found;
+        for (const OGCContact& contact : contacts) found.push_back({contact.particleIndexA, contact.featureId});
+        std::sort(found.begin(), found.end());
+        CHECK(!expected.empty());
+        CHECK(found == expected);
+    }
+
+    // 無效索引被忽略
+    colliders.setTransform(99, glm::vec3(0.0f), glm::mat3(1.0f));
+    CHECK(colliders.getColliderCount() == 3);
+}
+
+} // namespace
+
+int main() {
+    testKernels();
+    testDetect();
+    testKinematic();
+    return TEST_RESULT();
+}
@@ -0,0 +1,106 @@
+#include "TestSupport.h"
+#include "physics/ClothBVH.h"
+#include <algorithm>
+#include <array>
+
+using namespace Physics;
+
+namespace {
+
+const int kWidth = 16;
+const int kHeight = 16;
+const float kSpacing = 0.05f;
+const float kContactRadius = 0.02f;
+
+std::vector<glm::vec3> flatGrid() {
+    std::vector<glm::vec3> positions(kWidth * kHeight);
+    for (int y = 0; y < kHeight; ++y) {
+        for (int x = 0; x < kWidth; ++x) {
+            positions[y * kWidth + x] = glm::vec3(kSpacing * x, 0.0f, kSpacing * y);
+        }
+    }
+    return positions;
+}
+
+// 沿 x 中線對折：右半翻到左半上方 0.015 處
+std::vector<glm::vec3> foldedGrid() {
+    std::vector<glm::vec3> positions = flatGrid();
+    for (int y = 0; y < kHeight; ++y) {
+        for (int x = kWidth / 2; x < kWidth; ++x) {
+            int mirrored = kWidth - 1 - x;
+            positions[y * kWidth + x] = glm::vec3(kSpacing * mirrored + 0.011f, 0.015f, kSpacing * y + 0.007f);
+        }
+    }
+    return positions;
+}
+
+using ContactKey = std::array<int, 5>;
+
+std::vector<ContactKey> contactKeys(const std::vector<OGCContact>& contacts) {
+    std::vector<ContactKey> keys;
+    for (const OGCContact& contact : contacts) {
+        keys.push_back({contact.particleIndexA, contact.particleIndexA1, contact.particleIndexB,
+                        contact.particleIndexB1, contact.particleIndexB2});
+    }
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+
+} // namespace
+
+int main() {
+    ParallelSettings settings(1, true);
+    std::vector<glm::vec3> folded = foldedGrid();
+
+    // 由平面建立後重新擬合到對折狀態
+    ClothBVH refitted;
+    refitted.setGridTopology(kWidth, kHeight);
+    refitted.setRebuildThreshold(1.0e9f);
+    refitted.update(flatGrid(), settings);
+    refitted.update(folded, settings);
+    CHECK(refitted.getRebuildCount() == 1);
+
+    // 直接以對折狀態建立
+    ClothBVH rebuilt;
+    rebuilt.setGridTopology(kWidth, kHeight);
+    rebuilt.update(folded, settings);
+    CHECK(rebuilt.getRebuildCount() == 1);
+
+    std::vector<OGCContact> refitContacts;
+    std::vector<OGCContact> rebuildContacts;
+    refitted.detect(folded, kContactRadius, refitContacts, settings);
+    rebuilt.detect(folded, kContactRadius, rebuildContacts, settings);
+
+    // 擬合後的樹較鬆但必須找到相同的接近對
+    CHECK(!rebuildContacts.empty());
+    CHECK(contactKeys(refitContacts) == contactKeys(rebuildContacts));
+    for (const OGCContact& contact : rebuildContacts) {
+        CHECK(contact.isStencilContact());
+    }
+
+    // 平面狀態下拓撲鄰居被排除，沒有接觸
+    std::vector<OGCContact> flatContacts;
+    rebuilt.update(flatGrid(), settings);
+    rebuilt.detect(flatGrid(), kContactRadius, flatContacts, settings);
+    CHECK(flatContacts.empty());
+
+    // 閾值為零時每次更新都重建 (首次建立計一次，之後兩棵樹各計一次)
+    ClothBVH eager;
+    eager.setGridTopology(kWidth, kHeight);
+    eager.setRebuildThreshold(0.0f);
+    eager.update(flatGrid(), settings);
+    eager.update(folded, settings);
+    CHECK(eager.getRebuildCount() == 3);
+
+    // 多執行緒擬合與檢測結果一致
+    std::vector<OGCContact> parallelContacts;
+    ClothBVH parallel;
+    parallel.setGridTopology(kWidth, kHeight);
+    parallel.setRebuildThreshold(1.0e9f);
+    parallel.update(flatGrid(), ParallelSettings(4, true));
+    parallel.update(folded, ParallelSettings(4, true));
+    parallel.detect(folded, kContactRadius, parallelContacts, ParallelSettings(4, true));
+    CHECK(contactKeys(parallelContacts) == contactKeys(refitContacts));
+
+    return TEST_RESULT();
+}
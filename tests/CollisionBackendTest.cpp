@@ -0,0 +1,170 @@
+#include "TestSupport.h"
+#include "physics/ClothSimulation.h"
+#include "physics/CollisionBackend.h"
+#include "physics/TriangleMeshCollider.h"
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace Physics;
+
+namespace {
+
+/**
+ * @brief 只記錄呼叫次數的測試後端
+ */
+class CountingBackend : public CollisionBackend {
+public:
+    static int s_detectCalls;
+
+    const char* getName() const override { return "counting"; }
+    void addCylinder(const glm::vec3&, float, float) override {}
+    void addFloor(const glm::vec3&, const glm::vec3&) override {}
+    void addTriangleMesh(const std::shared_ptr<TriangleMeshCollider>&) override {}
+    int addParticle(int, const glm::vec3&, float) override { return m_particleCount++; }
+    void updateParticlePosition(int, const glm::vec3&) override {}
+    void removeParticle(int) override {}
+    void performCollisionDetection(std::vector<OGCContact>& contacts, const ParallelSettings&,
+                                   const std::vector<char>*) override {
+        contacts.clear();
+        ++s_detectCalls;
+    }
+
+private:
+    int m_particleCount = 0;
+};
+
+int CountingBackend::s_detectCalls = 0;
+
+void testRegistry() {
+    // 簡化後端總是編譯進來；Bullet 視建置而定
+    CHECK(CollisionBackendRegistry::isRegistered("simplified"));
+    CHECK(!CollisionBackendRegistry::isRegistered("no-such-backend"));
+    CHECK(!CollisionBackendRegistry::create("no-such-backend"));
+
+    std::unique_ptr<CollisionBackend> simplified = CollisionBackendRegistry::create("simplified");
+    CHECK(simplified && std::string(simplified->getName()) == "simplified");
+
+    std::vector<std::string> available = CollisionBackendRegistry::getAvailableBackends();
+    CHECK(!available.empty());
+    CHECK(available.front() == CollisionBackendRegistry::getDefaultName());
+    CHECK(std::find(available.begin(), available.end(), "simplified") != available.end());
+
+    std::unique_ptr<CollisionBackend> fallback = CollisionBackendRegistry::create();
+    CHECK(fallback && CollisionBackendRegistry::getDefaultName() == fallback->getName());
+
+    // 名稱重複時註冊失敗
+    CHECK(!CollisionBackendRegistry::registerBackend("simplified", 0, [] {
+        return std::unique_ptr<CollisionBackend>(new CountingBackend());
+    }));
+}
+
+void testRuntimeSelection() {
+    CHECK(CollisionBackendRegistry::registerBackend("counting", -1, [] {
+        return std::unique_ptr<CollisionBackend>(new CountingBackend());
+    }));
+    CHECK(CollisionBackendRegistry::getAvailableBackends().back() == "counting");
+    CHECK(CollisionBackendRegistry::getDefaultName() != "counting");
+
+    // 同一個執行檔中兩個模擬使用不同後端
+    ClothSimulation counted;
+    CHECK(!counted.setCollisionBackend("no-such-backend"));
+    CHECK(counted.setCollisionBackend("counting"));
+    CHECK(counted.initialize(4, 4));
+    CHECK(std::string(counted.getCollisionBackendName()) == "counting");
+    CHECK(!counted.setCollisionBackend("simplified"));     // 初始化後不能再換
+
+    ClothSimulation simplified;
+    CHECK(simplified.setCollisionBackend("simplified"));
+    CHECK(simplified.initialize(4, 4));
+    CHECK(std::string(simplified.getCollisionBackendName()) == "simplified");
+
+    counted.update(1.0f / 60.0f);
+    counted.update(1.0f / 60.0f);
+    simplified.update(1.0f / 60.0f);
+    CHECK(CountingBackend::s_detectCalls == 2);
+}
+
+float nextSigned(uint32_t& state) {
+    state = state * 1664525u + 1013904223u;
+    return static_cast<float>(state >> 8) / static_cast<float>(1u << 23) - 1.0f;
+}
+
+/**
+ * @brief 平行檢測：接觸序列與執行緒數無關，並按粒子句柄、碰撞體順序排列
+ */
+void testParallelDetection(const std::string& name) {
+    std::unique_ptr<CollisionBackend> backend = CollisionBackendRegistry::create(name);
+    CHECK(backend != nullptr);
+    if (!backend) return;
+
+    backend->addCylinder(glm::vec3(0.0f), 0.4f, 1.0f);
+    backend->addFloor(glm::vec3(0.0f, -0.55f, 0.0f), glm::vec3(3.0f, 0.1f, 3.0f));
+    std::vector<glm::vec3> meshVertices{glm::vec3(-1.0f, 0.3f, -1.0f), glm::vec3(-1.0f, 0.3f, 1.0f),
+                                        glm::vec3(1.0f, 0.3f, -1.0f)};
+    backend->addTriangleMesh(std::make_shared<TriangleMeshCollider>(
+        meshVertices, std::vector<glm::ivec3>{glm::ivec3(0, 1, 2)}));
+
+    uint32_t state = 11u;
+    const int particleCount = 5000;
+    std::vector<int> handles;
+    for (int i = 0; i < particleCount; ++i) {
+        glm::vec3 position(nextSigned(state), 0.6f * nextSigned(state), nextSigned(state));
+        handles.push_back(backend->addParticle(i, position, 0.05f));
+    }
+    backend->removeParticle(handles[7]);
+
+    std::vector<OGCContact> serial;
+    backend->performCollisionDetection(serial, ParallelSettings(1, true), nullptr);
+    CHECK(!serial.empty());
+
+    bool ordered = true;
+    for (size_t k = 0; k < serial.size(); ++k) {
+        CHECK(serial[k].particleIndexA != 7);
+        CHECK(serial[k].featureId >= 0 && serial[k].featureId < 3);
+        if (k > 0) {
+            const OGCContact& previous = serial[k - 1];
+            ordered = ordered && (previous.particleIndexA < serial[k].particleIndexA ||
+                                  (previous.particleIndexA == serial[k].particleIndexA &&
+                                   previous.featureId < serial[k].featureId));
+        }
+    }
+    CHECK(ordered);
+
+    std::vector<OGCContact> parallel(3);    // 輸出先被清空
+    for (int threadCount : {2, 4, 16}) {
+        backend->performCollisionDetection(parallel, ParallelSettings(threadCount, true), nullptr);
+        CHECK(parallel.size() == serial.size());
+        for (size_t k = 0; k < std::min(parallel.size(), serial.size()); ++k) {
+            CHECK(parallel[k].particleIndexA == serial[k].particleIndexA);
+            CHECK(parallel[k].featureId == serial[k].featureId);
+            CHECK(parallel[k].penetrationDepth == serial[k].penetrationDepth);
+        }
+    }
+
+    // 略過遮罩：被標記的粒子不輸出接觸，其他接觸不變
+    std::vector<char> skipMask(particleCount, 0);
+    for (int i = 0; i < particleCount; i += 2) skipMask[i] = 1;
+    std::vector<OGCContact> masked;
+    backend->performCollisionDetection(masked, ParallelSettings(4, true), &skipMask);
+    size_t expected = 0;
+    for (const OGCContact& contact : serial) {
+        expected += contact.particleIndexA % 2 != 0;
+    }
+    CHECK(masked.size() == expected);
+    for (const OGCContact& contact : masked) {
+        CHECK(contact.particleIndexA % 2 != 0);
+    }
+}
+
+} // namespace
+
+int main() {
+    testRegistry();
+    testRuntimeSelection();
+    for (const std::string& name : CollisionBackendRegistry::getAvailableBackends()) {
+        if (name != "counting") testParallelDetection(name);
+    }
+    return TEST_RESULT();
+}
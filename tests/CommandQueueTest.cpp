@@ -0,0 +1,120 @@
+#include "TestSupport.h"
+#include "physics/ClothSimulation.h"
+#include "physics/CommandQueue.h"
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace Physics;
+
+namespace {
+
+void testFifo() {
+    CommandQueue<int> queue;
+    CHECK(queue.empty());
+    int value = -1;
+    CHECK(!queue.tryPop(value));
+
+    for (int i = 0; i < 5; ++i) queue.push(i);
+    CHECK(!queue.empty());
+    for (int i = 0; i < 5; ++i) {
+        CHECK(queue.tryPop(value) && value == i);
+    }
+    CHECK(queue.empty());
+
+    // 析構時釋放未取出的命令
+    auto payload = std::make_shared<int>(7);
+    {
+        CommandQueue<std::shared_ptr<int>> pending;
+        pending.push(payload);
+        pending.push(payload);
+        CHECK(payload.use_count() == 3);
+    }
+    CHECK(payload.use_count() == 1);
+}
+
+/**
+ * @brief 多生產者同時推入、消費者同時取出：每個命令恰好取出一次，同一生產者的命令保持順序
+ */
+void testMultipleProducers() {
+    const int producerCount = 4;
+    const int perProducer = 20000;
+    CommandQueue<std::pair<int, int>> queue;
+
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < producerCount; ++producer) {
+        producers.emplace_back([&queue, producer] {
+            for (int sequence = 0; sequence < perProducer; ++sequence) {
+                queue.push({producer, sequence});
+            }
+        });
+    }
+
+    std::vector<int> nextSequence(producerCount, 0);
+    bool ordered = true;
+    int received = 0;
+    std::pair<int, int> command;
+    while (received < producerCount * perProducer) {
+        if (!queue.tryPop(command)) {
+            std::this_thread::yield();
+            continue;
+        }
+        ordered = ordered && command.second == nextSequence[command.first];
+        ++nextSequence[command.first];
+        ++received;
+    }
+    for (std::thread& producer : producers) producer.join();
+
+    CHECK(ordered);
+    CHECK(queue.empty());
+    for (int producer = 0; producer < producerCount; ++producer) {
+        CHECK(nextSequence[producer] == perProducer);
+    }
+}
+
+/**
+ * @brief 模擬的命令在 update 開始前按提交順序執行
+ */
+void testSimulationCommands() {
+    ClothSimulation simulation;
+    CHECK(simulation.initialize(8, 8));
+    CHECK(simulation.applyCommands() == 0);
+
+    std::vector<int> order;
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < 3; ++producer) {
+        producers.emplace_back([&simulation, &order, producer] {
+            simulation.enqueueCommand([&order, producer](ClothSimulation&) { order.push_back(producer); });
+        });
+    }
+    for (std::thread& producer : producers) producer.join();
+    simulation.enqueueCommand(nullptr);     // 空命令被略過但計數
+    CHECK(simulation.applyCommands() == 4);
+    CHECK(order.size() == 3);
+
+    // 在同一個命令內固定整排粒子，下一步開始前生效
+    order.clear();
+    simulation.enqueueCommand([&order](ClothSimulation& target) {
+        std::vector<int> row;
+        for (int i = 0; i < 8; ++i) row.push_back(i);
+        target.setParticlesFixed(row, true);
+        order.push_back(1);
+    });
+    simulation.enqueueCommand([&order](ClothSimulation&) { order.push_back(2); });
+    glm::vec3 pinned = simulation.getParticles()[3]->getPosition();
+    simulation.update(1.0f / 60.0f);
+    CHECK(order == std::vector<int>({1, 2}));
+    CHECK(simulation.getParticles()[3]->getPosition() == pinned);
+    CHECK(simulation.getParticles()[60]->getPosition() != simulation.getParticles()[60]->getPreviousPosition());
+    CHECK(simulation.applyCommands() == 0);
+}
+
+} // namespace
+
+int main() {
+    testFifo();
+    testMultipleProducers();
+    testSimulationCommands();
+    return TEST_RESULT();
+}
@@ -0,0 +1,171 @@
+#include "TestSupport.h"
+#include "physics/ContactCache.h"
+#include <vector>
+
+using namespace Physics;
+
+namespace {
+
+OGCContact staticContact(int particle, int feature, float depth) {
+    OGCContact contact;
+    contact.particleIndexA = particle;
+    contact.particleIndexB = -1;
+    contact.featureId = feature;
+    contact.penetrationDepth = depth;
+    contact.contactNormal = glm::vec3(0.0f, 1.0f, 0.0f);
+    return contact;
+}
+
+/**
+ * @brief 大量接觸的熱啟動往返 (開放定址表必須處理探測鏈)
+ */
+void testWarmStartRoundTrip() {
+    ContactCache cache;
+    std::vector<OGCContact> contacts;
+    for (int i = 0; i < 4000; ++i) {
+        contacts.push_back(staticContact(i / 3, i % 3, 0.01f));
+    }
+    // 同一粒子與同一特徵的重複接觸以出現順序區分
+    contacts.push_back(staticContact(0, 0, 0.02f));
+
+    cache.warmStart(contacts);
+    CHECK(cache.getWarmStartedContactCount() == 0);
+    for (const OGCContact& contact : contacts) {
+        CHECK(contact.previousForce == -1.0f);
+    }
+
+    for (size_t k = 0; k < contacts.size(); ++k) {
+        contacts[k].contactForce = static_cast<float>(k + 1);
+    }
+    cache.store(contacts);
+
+    cache.warmStart(contacts);
+    CHECK(cache.getWarmStartedContactCount() == static_cast<int>(contacts.size()));
+    bool allMatched = true;
+    for (size_t k = 0; k < contacts.size(); ++k) {
+        allMatched = allMatched && contacts[k].previousForce == static_cast<float>(k + 1);
+    }
+    CHECK(allMatched);
+
+    // 未見過的接觸不命中
+    std::vector<OGCContact> unseen{staticContact(9999, 0, 0.01f)};
+    cache.warmStart(unseen);
+    CHECK(unseen[0].previousForce == -1.0f);
+
+    cache.reset();
+    cache.warmStart(contacts);
+    CHECK(cache.getWarmStartedContactCount() == 0);
+}
+
+/**
+ * @brief 短暫分離的接觸在最大沿用幀數內保留其力
+ */
+void testForceAging() {
+    const int maxFrames = 3;
+    ContactCache cache(0.002f, maxFrames);
+
+    std::vector<OGCContact> both{staticContact(1, 0, 0.01f), staticContact(2, 0, 0.01f)};
+    both[0].contactForce = 5.0f;
+    both[1].contactForce = 7.0f;
+    cache.warmStart(both);
+    cache.store(both);
+
+    // 粒子 2 的接觸消失 maxFrames 幀後回來：仍命中
+    std::vector<OGCContact> onlyFirst{staticContact(1, 0, 0.01f)};
+    for (int frame = 0; frame < maxFrames; ++frame) {
+        cache.warmStart(onlyFirst);
+        onlyFirst[0].contactForce = 5.0f;
+        cache.store(onlyFirst);
+    }
+    std::vector<OGCContact> returned{staticContact(1, 0, 0.01f), staticContact(2, 0, 0.01f)};
+    cache.warmStart(returned);
+    CHECK(returned[1].previousForce == 7.0f);
+
+    // 再多消失一幀即過期
+    for (int frame = 0; frame <= maxFrames; ++frame) {
+        cache.warmStart(onlyFirst);
+        cache.store(onlyFirst);
+    }
+    cache.warmStart(returned);
+    CHECK(returned[0].previousForce == 5.0f);
+    CHECK(returned[1].previousForce == -1.0f);
+}
+
+/**
+ * @brief 窄相重用：錨點位移小於邊距時略過並沿用接觸，深度按位移更新
+ */
+void testNarrowphaseReuse() {
+    const int maxFrames = 2;
+    ContactCache cache(0.01f, maxFrames);
+    std::vector<glm::vec3> positions{glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(2.0f, 0.0f, 0.0f)};
+
+    auto backendContacts = [&](const std::vector<char>& skip) {
+        // 模擬後端：粒子 0 與 1 各有一個靜態接觸，另附一個布料接觸
+        std::vector<OGCContact> contacts;
+        if (!skip[0]) contacts.push_back(staticContact(0, 4, 0.02f));
+        if (!skip[1]) contacts.push_back(staticContact(1, 4, 0.03f));
+        OGCContact cloth;
+        cloth.particleIndexA = 0;
+        cloth.particleIndexB = 2;
+        contacts.insert(contacts.begin(), cloth);
+        return contacts;
+    };
+
+    // 第一幀沒有錨點：全部檢測
+    const std::vector<char>& first = cache.prepare(positions);
+    CHECK(first.size() == 3 && !first[0] && !first[1] && !first[2]);
+    std::vector<OGCContact> contacts = backendContacts(first);
+    cache.mergeNarrowphase(contacts, positions);
+    CHECK(contacts.size() == 3);
+    CHECK(contacts[0].particleIndexA == 0 && contacts[1].particleIndexA == 1);
+    CHECK(contacts[2].particleIndexB == 2);     // 非靜態接觸附在後面
+
+    // 粒子 0 沿法線移動 0.005 (< 邊距)：略過；粒子 1 移動 0.05：重新檢測；粒子 2 沒有接觸：不略過
+    positions[0].y += 0.005f;
+    positions[1].y += 0.05f;
+    const std::vector<char>& second = cache.prepare(positions);
+    CHECK(second[0] && !second[1] && !second[2]);
+    CHECK(cache.getReusedParticleCount() == 1);
+    contacts = backendContacts(second);
+    cache.mergeNarrowphase(contacts, positions);
+    CHECK(contacts.size() == 3);
+    CHECK(contacts[0].particleIndexA == 0 && contacts[0].featureId == 4);
+    CHECK_NEAR(contacts[0].penetrationDepth, 0.02 - 0.005, 1e-6);
+    CHECK_NEAR(contacts[1].penetrationDepth, 0.03, 1e-6);
+
+    // 連續略過達上限後強制重新檢測
+    CHECK(cache.prepare(positions)[0]);
+    contacts = backendContacts(cache.prepare(positions));
+    cache.mergeNarrowphase(contacts, positions);
+    CHECK(!cache.prepare(positions)[0]);
+}
+
+void testTagSource() {
+    std::vector<OGCContact> contacts{staticContact(0, 3, 0.01f), staticContact(0, 3, 0.01f)};
+    ContactCache::tagSource(contacts, 1, 2);
+    CHECK(contacts[0].featureId == 3);
+    CHECK(contacts[1].featureId != 3);
+
+    // 不同來源的同編號碰撞體不共用熱啟動
+    ContactCache cache;
+    std::vector<OGCContact> tagged{contacts[1]};
+    tagged[0].contactForce = 2.0f;
+    cache.warmStart(tagged);
+    cache.store(tagged);
+
+    std::vector<OGCContact> untagged{contacts[0]};
+    cache.warmStart(untagged);
+    CHECK(untagged[0].previousForce == -1.0f);
+    cache.warmStart(tagged);
+    CHECK(tagged[0].previousForce == 2.0f);
+}
+
+} // namespace
+
+int main() {
+    testWarmStartRoundTrip();
+    testForceAging();
+    testNarrowphaseReuse();
+    testTagSource();
+    return TEST_RESULT();
+}
@@ -0,0 +1,120 @@
+#include "TestSupport.h"
+#include "physics/ClothSimulation.h"
+#include "physics/ContinuousCollision.h"
+#include <vector>
+
+using namespace Physics;
+
+namespace {
+
+const float kRadius = 0.02f;
+
+/**
+ * @brief 單一粒子掃掠，返回追加的 TOI 接觸 (沒有命中時 timeOfImpact < 0)
+ */
+OGCContact sweepOne(ContinuousCollision& ccd, const glm::vec3& start, const glm::vec3& end) {
+    std::vector<glm::vec3> previous{start};
+    std::vector<glm::vec3> current{end};
+    std::vector<OGCContact> contacts;
+    ccd.detect(previous, current, contacts, ParallelSettings());
+    if (contacts.empty()) {
+        OGCContact miss;
+        miss.timeOfImpact = -1.0f;
+        return miss;
+    }
+    CHECK(contacts.size() == 1);
+    return contacts[0];
+}
+
+void testCylinder() {
+    ContinuousCollision ccd(kRadius);
+    ccd.addCylinder(glm::vec3(0.0f), 0.5f, 1.0f);
+
+    // 側面：膨脹半徑 0.52，從 x=-2 到 x=2 在 t=(2-0.52)/4 進入
+    OGCContact side = sweepOne(ccd, glm::vec3(-2.0f, 0.0f, 0.0f), glm::vec3(2.0f, 0.0f, 0.0f));
+    CHECK_NEAR(side.timeOfImpact, 0.37, 1e-5);
+    CHECK_NEAR(side.contactNormal.x, -1.0, 1e-5);
+    CHECK_NEAR(side.penetrationDepth, 2.52, 1e-4);
+    CHECK(side.particleIndexA == 0 && side.particleIndexB == -1);
+
+    // 頂面：膨脹後頂面 y=0.52
+    OGCContact cap = sweepOne(ccd, glm::vec3(0.1f, 2.0f, 0.1f), glm::vec3(0.1f, -2.0f, 0.1f));
+    CHECK_NEAR(cap.timeOfImpact, 0.37, 1e-5);
+    CHECK_NEAR(cap.contactNormal.y, 1.0, 1e-6);
+
+    // 從旁邊經過、起點已在內部的線段都不算命中
+    CHECK(sweepOne(ccd, glm::vec3(-2.0f, 0.0f, 1.0f), glm::vec3(2.0f, 0.0f, 1.0f)).timeOfImpact < 0.0f);
+    CHECK(sweepOne(ccd, glm::vec3(0.0f), glm::vec3(2.0f, 0.0f, 0.0f)).timeOfImpact < 0.0f);
+}
+
+void testBox() {
+    ContinuousCollision ccd(kRadius);
+    ccd.addBox(glm::vec3(0.0f, -1.0f, 0.0f), glm::vec3(4.0f, 0.2f, 4.0f));
+
+    // 膨脹後頂面 y=-0.88
+    OGCContact top = sweepOne(ccd, glm::vec3(1.0f, 0.0f, 1.0f), glm::vec3(1.0f, -2.0f, 1.0f));
+    CHECK_NEAR(top.timeOfImpact, 0.44, 1e-5);
+    CHECK_NEAR(top.contactNormal.y, 1.0, 1e-6);
+    CHECK_NEAR(top.contactPoint.y, -0.9, 1e-5);
+
+    // 側面進入：x 面先到
+    OGCContact side = sweepOne(ccd, glm::vec3(-4.0f, -1.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f));
+    CHECK_NEAR(side.timeOfImpact, (4.0 - 2.02) / 4.0, 1e-5);
+    CHECK_NEAR(side.contactNormal.x, -1.0, 1e-6);
+
+    // 位移小於掃掠閾值的粒子交由離散檢測
+    CHECK(sweepOne(ccd, glm::vec3(1.0f, -0.87f, 1.0f), glm::vec3(1.0f, -0.885f, 1.0f)).timeOfImpact < 0.0f);
+
+    // 命中粒子的離散靜態接觸被 TOI 接觸取代，其他粒子的接觸保留
+    std::vector<glm::vec3> previous{glm::vec3(1.0f, 0.0f, 1.0f), glm::vec3(0.0f, -0.85f, 0.0f)};
+    std::vector<glm::vec3> current{glm::vec3(1.0f, -2.0f, 1.0f), glm::vec3(0.0f, -0.86f, 0.0f)};
+    std::vector<OGCContact> contacts(2);
+    contacts[0].particleIndexA = 0;
+    contacts[0].contactNormal = glm::vec3(0.0f, -1.0f, 0.0f);
+    contacts[1].particleIndexA = 1;
+    ccd.detect(previous, current, contacts, ParallelSettings());
+    CHECK(contacts.size() == 2);
+    CHECK(contacts[0].particleIndexA == 1);
+    CHECK(contacts[1].particleIndexA == 0 && contacts[1].contactNormal.y > 0.0f);
+}
+
+/**
+ * @brief 大重力下落向薄地板，返回最終最低粒子的高度
+ */
+float dropOnThinFloor(bool continuous, float damping) {
+    ClothSimulation simulation;
+    CHECK(simulation.initialize(4, 4, glm::vec2(0.5f, 0.5f), glm::vec3(0.0f, 0.3f, 0.0f)));
+    simulation.setGravity(glm::vec3(0.0f, -600.0f, 0.0f));
+    simulation.setDamping(damping);
+    simulation.setContinuousCollisionEnabled(continuous);
+    simulation.addFloor(glm::vec3(0.0f), glm::vec3(4.0f, 0.05f, 4.0f));
+
+    for (int step = 0; step < 6; ++step) {
+        simulation.update(1.0f / 60.0f);
+    }
+
+    float lowest = 1e30f;
+    for (const auto& particle : simulation.getParticles()) {
+        lowest = std::min(lowest, static_cast<float>(particle->getPosition().y));
+    }
+    return lowest;
+}
+
+void testNoTunnelling() {
+    // 沒有 CCD 時每步位移遠大於地板厚度，粒子直接穿過
+    CHECK(dropOnThinFloor(false, 0.99f) < -0.5f);
+
+    // CCD 線段起點取阻尼前位置：阻尼很強時線段也不會被縮短到漏掉地板
+    for (float damping : {0.99f, 0.5f}) {
+        CHECK(dropOnThinFloor(true, damping) > 0.0f);
+    }
+}
+
+} // namespace
+
+int main() {
+    testCylinder();
+    testBox();
+    testNoTunnelling();
+    return TEST_RESULT();
+}
@@ -0,0 +1,67 @@
+#include "TestSupport.h"
+#include "physics/ClothSimulation.h"
+#include <cstdint>
+#include <functional>
+
+using namespace Physics;
+
+namespace {
+
+/**
+ * @brief 以指定執行緒數運行場景並返回最終狀態雜湊
+ */
+uint64_t runScene(int threadCount, int steps, const std::function<void(ClothSimulation&)>& configure) {
+    ClothSimulation simulation;
+    CHECK(simulation.initialize(24, 24, glm::vec2(2.0f, 2.0f), glm::vec3(0.0f, 3.0f, 0.0f)));
+    simulation.setWind(glm::vec3(0.5f, 0.0f, 0.2f));
+    simulation.setThreadCount(threadCount);
+    simulation.setDeterministic(true);
+    simulation.addCylinder(glm::vec3(0.0f, 1.0f, 0.0f), 0.5f, 1.0f);
+    simulation.addFloor(glm::vec3(0.0f, -1.0f, 0.0f), glm::vec3(5.0f, 0.1f, 5.0f));
+    configure(simulation);
+
+    for (int step = 0; step < steps; ++step) {
+        simulation.update(1.0f / 60.0f);
+    }
+    CHECK(!simulation.getContacts().empty());
+    return simulation.getStateHash();
+}
+
+void checkThreadCountInvariance(const char* name, int steps, const std::function<void(ClothSimulation&)>& configure) {
+    uint64_t reference = runScene(1, steps, configure);
+    for (int threadCount : {4, 16}) {
+        uint64_t hash = runScene(threadCount, steps, configure);
+        if (hash != reference) {
+            std::fprintf(stderr, "%s: hash at %d threads %016llx != %016llx at 1 thread\n", name, threadCount,
+                         static_cast<unsigned long long>(hash), static_cast<unsigned long long>(reference));
+        }
+        CHECK(hash == reference);
+    }
+}
+
+} // namespace
+
+int main() {
+    // 預設管線 (後端碰撞 + OGC 接觸)
+    checkThreadCountInvariance("default", 150, [](ClothSimulation&) {});
+
+    // 所有可選階段一起啟用
+    checkThreadCountInvariance("all-stages", 150, [](ClothSimulation& simulation) {
+        simulation.setSelfCollisionEnabled(true);
+        simulation.setTriangleCollisionEnabled(true);
+        simulation.setContinuousCollisionEnabled(true);
+        simulation.setDisplacementBoundsEnabled(true);
+        simulation.setContactCacheEnabled(true);
+        simulation.setNarrowBandEnabled(true);
+        simulation.setContactReductionEnabled(true);
+        simulation.setContactProjectionEnabled(true);
+        simulation.addSphere(glm::vec3(0.6f, 0.6f, 0.3f), 0.3f);
+        simulation.addCapsule(glm::vec3(-0.8f, 0.4f, -0.5f), glm::vec3(-0.2f, 0.4f, 0.6f), 0.15f);
+    });
+
+    // 不同執行緒數的完整重複：同一執行緒數兩次運行也必須相同
+    auto none = [](ClothSimulation&) {};
+    CHECK(runScene(4, 60, none) == runScene(4, 60, none));
+
+    return TEST_RESULT();
+}
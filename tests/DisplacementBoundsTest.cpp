@@ -0,0 +1,126 @@
+#include "TestSupport.h"
+#include "physics/DisplacementBounds.h"
+#include <cstdint>
+#include <vector>
+
+using namespace Physics;
+
+namespace {
+
+/**
+ * @brief 固定種子的 [-1, 1) 亂數 (測試可重現)
+ */
+float nextSigned(uint32_t& state) {
+    state = state * 1664525u + 1013904223u;
+    return static_cast<float>(state >> 8) / static_cast<float>(1u << 23) - 1.0f;
+}
+
+void testBoundsFromDistances() {
+    std::vector<glm::vec3> positions{glm::vec3(0.0f, 0.2f, 0.0f), glm::vec3(1.0f, 0.5f, 0.0f),
+                                     glm::vec3(2.0f, 0.6f, 0.0f), glm::vec3(2.0f, 0.65f, 0.0f)};
+    std::vector<float> distances{0.2f, 0.5f, 0.6f, -0.1f};
+
+    // 粒子 2 與 3 的布料接觸：分離距離 = 接觸半徑 - 穿透深度
+    std::vector<OGCContact> contacts(1);
+    contacts[0].particleIndexA = 2;
+    contacts[0].particleIndexB = 3;
+    contacts[0].contactRadius = 0.1f;
+    contacts[0].penetrationDepth = 0.05f;
+
+    DisplacementBounds bounds(0.45f);
+    CHECK(!bounds.isValid());
+    bounds.compute(positions, contacts, distances, 0.3f, ParallelSettings());
+    CHECK(bounds.isValid());
+
+    CHECK_NEAR(bounds.getBound(0), 0.45 * 0.2, 1e-6);      // 靜態碰撞體最近
+    CHECK_NEAR(bounds.getBound(1), 0.45 * 0.3, 1e-6);      // 布料查詢距離封頂
+    CHECK_NEAR(bounds.getBound(2), 0.45 * 0.05, 1e-6);     // 接觸分離距離
+    CHECK_NEAR(bounds.getBound(3), 0.0, 1e-6);             // 已在碰撞體內：不得移動
+
+    bounds.reset();
+    CHECK(!bounds.isValid());
+}
+
+/**
+ * @brief 在界內任意移動的頂點不會穿過平面碰撞體，也不會讓接觸中的兩頂點相交
+ */
+void testConservative() {
+    uint32_t state = 12345u;
+    const int count = 256;
+
+    std::vector<glm::vec3> anchors(count);
+    std::vector<float> distances(count);
+    for (int i = 0; i < count; ++i) {
+        anchors[i] = glm::vec3(nextSigned(state), 0.5f + 0.5f * nextSigned(state), nextSigned(state));
+        distances[i] = anchors[i].y;    // 平面 y = 0
+    }
+
+    // 相鄰頂點兩兩成對接觸，分離距離取實際間距
+    std::vector<OGCContact> contacts;
+    for (int i = 0; i + 1 < count; i += 2) {
+        OGCContact contact;
+        contact.particleIndexA = i;
+        contact.particleIndexB = i + 1;
+        contact.contactRadius = glm::length(anchors[i + 1] - anchors[i]);
+        contact.penetrationDepth = 0.0f;
+        contacts.push_back(contact);
+    }
+
+    DisplacementBounds bounds(0.45f);
+    bounds.compute(anchors, contacts, distances, 0.0f, ParallelSettings());
+
+    for (int trial = 0; trial < 20; ++trial) {
+        std::vector<glm::vec3> positions(count);
+        for (int i = 0; i < count; ++i) {
+            glm::vec3 push(nextSigned(state), nextSigned(state), nextSigned(state));
+            positions[i] = anchors[i] + push;
+        }
+
+        int clamped = bounds.clamp(positions, ParallelSettings());
+        CHECK(clamped > 0);
+
+        for (int i = 0; i < count; ++i) {
+            CHECK(glm::length(positions[i] - anchors[i]) <= bounds.getBound(i) * 1.0001f + 1e-6f);
+            CHECK(positions[i].y > 0.0f);
+        }
+        for (const OGCContact& contact : contacts) {
+            float gap = glm::length(positions[contact.particleIndexB] - positions[contact.particleIndexA]);
+            CHECK(gap > 0.05f * contact.contactRadius);
+        }
+    }
+}
+
+void testClampAndDepthUpdate() {
+    std::vector<glm::vec3> anchors{glm::vec3(0.0f, 1.0f, 0.0f)};
+    std::vector<OGCContact> contacts(1);
+    contacts[0].particleIndexA = 0;
+    contacts[0].penetrationDepth = 0.02f;
+    contacts[0].contactNormal = glm::vec3(0.0f, 1.0f, 0.0f);
+
+    DisplacementBounds bounds(0.4f);
+    bounds.compute(anchors, contacts, std::vector<float>{1.0f}, 0.0f, ParallelSettings());
+
+    // 界內移動不截斷
+    std::vector<glm::vec3> positions{glm::vec3(0.0f, 1.3f, 0.0f)};
+    CHECK(bounds.clamp(positions, ParallelSettings()) == 0);
+    CHECK(bounds.getClampedFlags()[0] == 0);
+
+    // 超出界時沿位移方向截斷到界上
+    positions[0] = glm::vec3(0.0f, 2.0f, 0.0f);
+    CHECK(bounds.clamp(positions, ParallelSettings()) == 1);
+    CHECK(bounds.getClampedFlags()[0] != 0);
+    CHECK_NEAR(positions[0].y, 1.4, 1e-6);
+
+    // 深度按錨點位移沿法線的分量線性更新 (A 沿法線移動 0.4 -> 深度減 0.4)
+    bounds.updateContactDepths(contacts, positions);
+    CHECK_NEAR(contacts[0].penetrationDepth, 0.02 - 0.4, 1e-6);
+}
+
+} // namespace
+
+int main() {
+    testBoundsFromDistances();
+    testConservative();
+    testClampAndDepthUpdate();
+    return TEST_RESULT();
+}
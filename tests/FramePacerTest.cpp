@@ -0,0 +1,137 @@
+#include "TestSupport.h"
+#include "physics/FramePacer.h"
+
+using namespace Physics;
+
+namespace {
+
+/**
+ * @brief 子步數按累積時間計算，超出上限的時間被丟棄並計數
+ */
+void testAdvance() {
+    const double step = 1.0 / 16.0;     // 可精確表示，便於比較
+    FramePacer pacer(step, 4, 0.8);
+
+    CHECK(pacer.advance(0.03) == 0);
+    CHECK_NEAR(pacer.timeUntilNextStep(), step - 0.03, 1e-12);
+    CHECK(pacer.advance(0.04) == 1);
+    CHECK_NEAR(pacer.timeUntilNextStep(), step - 0.0075, 1e-12);
+    CHECK(pacer.advance(-1.0) == 0);    // 負的經過時間被忽略
+
+    // 一次卡頓：16 步的時間只執行 4 步，其餘丟棄，不足一步的餘數保留
+    CHECK(pacer.advance(1.0) == 4);
+    CHECK(pacer.getCappedFrameCount() == 1);
+    CHECK_NEAR(pacer.getDroppedTime(), 0.75, 1e-12);
+    CHECK_NEAR(pacer.timeUntilNextStep(), step - 0.0075, 1e-12);
+
+    // 下一幀不補步
+    CHECK(pacer.advance(step) == 1);
+    CHECK(pacer.getCappedFrameCount() == 1);
+
+    // 時間守恆：執行的步 + 丟棄 + 累積 = 經過時間
+    FramePacer conserving(1.0 / 60.0, 3, 0.8);
+    double elapsed = 0.0;
+    int steps = 0;
+    for (int frame = 0; frame < 200; ++frame) {
+        double frameTime = (frame % 7 == 0) ? 0.1 : 0.013;
+        elapsed += frameTime;
+        int substeps = conserving.advance(frameTime);
+        CHECK(substeps <= 3);
+        steps += substeps;
+    }
+    double accumulated = conserving.getFixedTimeStep() - conserving.timeUntilNextStep();
+    CHECK_NEAR(steps / 60.0 + conserving.getDroppedTime() + accumulated, elapsed, 1e-9);
+    CHECK(conserving.getCappedFrameCount() > 0);
+
+    conserving.resetAccumulator();
+    CHECK_NEAR(conserving.timeUntilNextStep(), 1.0 / 60.0, 1e-15);
+}
+
+/**
+ * @brief 迭代數調整：超出預算減一、低於半預算加一，兩次調整之間冷卻 30 步，並受上下限約束
+ */
+void testAdjustIterations() {
+    const double step = 1.0 / 16.0;
+    FramePacer pacer(step, 4, 0.8);     // 預算 0.05 秒
+    const double overBudget = 0.07, underHalf = 0.01, between = 0.04;
+
+    pacer.recordStepCost(overBudget);
+    CHECK(pacer.getAverageStepCost() == overBudget);     // 第一個樣本直接作為平均
+    for (int i = 1; i < 29; ++i) pacer.recordStepCost(overBudget);
+    CHECK(pacer.adjustIterations(10, 2, 10) == 10);     // 冷卻中
+    pacer.recordStepCost(overBudget);
+    CHECK(pacer.adjustIterations(10, 2, 10) == 9);
+    CHECK(pacer.adjustIterations(9, 2, 10) == 9);       // 剛調整過
+
+    for (int i = 0; i < 30; ++i) pacer.recordStepCost(overBudget);
+    CHECK(pacer.adjustIterations(2, 2, 10) == 2);       // 已在下限
+
+    // 成本回落到半預算以下後逐步恢復
+    for (int i = 0; i < 30; ++i) pacer.recordStepCost(underHalf);
+    CHECK(pacer.getAverageStepCost() < 0.025);
+    CHECK(pacer.adjustIterations(9, 2, 10) == 10);
+    for (int i = 0; i < 30; ++i) pacer.recordStepCost(underHalf);
+    CHECK(pacer.adjustIterations(10, 2, 10) == 10);     // 已在上限
+
+    // 預算一半與預算之間：維持不變
+    for (int i = 0; i < 120; ++i) pacer.recordStepCost(between);
+    CHECK(pacer.adjustIterations(6, 2, 10) == 6);
+
+    // 預算比例可調
+    pacer.setBudgetFraction(0.5);       // 預算 0.03125 秒
+    CHECK(pacer.adjustIterations(6, 2, 10) == 5);
+    CHECK(pacer.getStepStats().getSampleCount() == 240);
+}
+
+/**
+ * @brief 最近秩百分位數與環形緩衝
+ */
+void testPercentiles() {
+    FrameTimeStats empty;
+    FrameTimeStats::Summary none = empty.summarize();
+    CHECK(none.samples == 0 && none.p50 == 0.0 && none.max == 0.0);
+
+    // 1..100 以打亂的順序記錄
+    FrameTimeStats stats(512);
+    for (int i = 0; i < 100; ++i) {
+        stats.record(static_cast<double>((i * 37) % 100 + 1));
+    }
+    FrameTimeStats::Summary summary = stats.summarize();
+    CHECK(summary.samples == 100);
+    CHECK(summary.p50 == 50.0);
+    CHECK(summary.p95 == 95.0);
+    CHECK(summary.p99 == 99.0);
+    CHECK(summary.max == 100.0);
+
+    // 10 個樣本：p95 與 p99 都取最大值
+    FrameTimeStats small;
+    for (int i = 10; i >= 1; --i) small.record(i);
+    summary = small.summarize();
+    CHECK(summary.p50 == 5.0 && summary.p95 == 10.0 && summary.p99 == 10.0);
+
+    FrameTimeStats single;
+    single.record(3.0);
+    summary = single.summarize();
+    CHECK(summary.p50 == 3.0 && summary.p99 == 3.0 && summary.max == 3.0);
+
+    // 容量 8：只保留最近的 13..20
+    FrameTimeStats ring(8);
+    for (int i = 1; i <= 20; ++i) ring.record(i);
+    summary = ring.summarize();
+    CHECK(summary.samples == 8);
+    CHECK(summary.p50 == 16.0);
+    CHECK(summary.max == 20.0);
+
+    ring.clear();
+    CHECK(ring.getSampleCount() == 0);
+    CHECK(ring.summarize().samples == 0);
+}
+
+} // namespace
+
+int main() {
+    testAdvance();
+    testAdjustIterations();
+    testPercentiles();
+    return TEST_RESULT();
+}
@@ -0,0 +1,137 @@
+#include "TestSupport.h"
+#include "physics/HeightfieldCollider.h"
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+using namespace Physics;
+
+namespace {
+
+const glm::vec3 kOrigin(-2.0f, 0.5f, -1.0f);
+const float kCellSize = 0.25f;
+
+float nextUnit(uint32_t& state) {
+    state = state * 1664525u + 1013904223u;
+    return static_cast<float>(state >> 8) / static_cast<float>(1u << 24);
+}
+
+/**
+ * @brief 傾斜平面：雙線性插值在平面上是精確的
+ */
+void testPlane() {
+    const int columns = 17, rows = 9;
+    const float slopeX = 0.3f, slopeZ = -0.2f;
+    std::vector<float> heights(columns * rows);
+    for (int z = 0; z < rows; ++z) {
+        for (int x = 0; x < columns; ++x) {
+            heights[z * columns + x] = slopeX * x * kCellSize + slopeZ * z * kCellSize;
+        }
+    }
+
+    HeightfieldCollider terrain;
+    CHECK(!terrain.isValid());
+    CHECK(terrain.build(heights, columns, rows, kOrigin, kCellSize));
+    CHECK(terrain.isValid());
+
+    glm::vec3 expectedNormal = glm::normalize(glm::vec3(-slopeX, 1.0f, -slopeZ));
+
+    uint32_t state = 3u;
+    std::vector<glm::vec3> points;
+    for (int i = 0; i < 101; ++i) {
+        points.push_back(kOrigin + glm::vec3(nextUnit(state) * (columns - 1) * kCellSize, nextUnit(state),
+                                             nextUnit(state) * (rows - 1) * kCellSize));
+    }
+    std::vector<float> queried(points.size());
+    std::vector<glm::vec3> normals(points.size());
+    terrain.query(points.data(), static_cast<int>(points.size()), queried.data(), normals.data());
+
+    for (size_t i = 0; i < points.size(); ++i) {
+        glm::vec3 local = points[i] - kOrigin;
+        float expectedHeight = kOrigin.y + slopeX * local.x + slopeZ * local.z;
+        CHECK_NEAR(queried[i], expectedHeight, 1e-5);
+        CHECK_NEAR(glm::dot(normals[i], expectedNormal), 1.0, 1e-5);
+
+        // 單點距離即到平面的垂直距離
+        float planeDistance = (points[i].y - expectedHeight) * expectedNormal.y;
+        CHECK_NEAR(terrain.distance(points[i]), planeDistance, 1e-5);
+    }
+
+    // 網格範圍外不接觸
+    glm::vec3 outside = kOrigin + glm::vec3(-0.1f, 0.0f, 0.5f);
+    float height;
+    glm::vec3 normal;
+    terrain.query(&outside, 1, &height, &normal);
+    CHECK(height == -std::numeric_limits<float>::max());
+    CHECK(terrain.distance(outside) == std::numeric_limits<float>::max());
+}
+
+/**
+ * @brief 起伏地形：樣本點上精確，格子內為雙線性插值
+ */
+void testBilinear() {
+    const int columns = 5, rows = 4;
+    std::vector<float> heights(columns * rows);
+    for (int i = 0; i < columns * rows; ++i) {
+        heights[i] = 0.1f * static_cast<float>((i * 7) % 5);
+    }
+
+    HeightfieldCollider terrain;
+    CHECK(terrain.build(heights, columns, rows, kOrigin, kCellSize));
+    CHECK(!HeightfieldCollider().build(heights, columns, rows + 1, kOrigin, kCellSize));
+
+    for (int z = 0; z < rows; ++z) {
+        for (int x = 0; x < columns; ++x) {
+            glm::vec3 sample = kOrigin + glm::vec3(x * kCellSize, 0.0f, z * kCellSize);
+            float height;
+            glm::vec3 normal;
+            terrain.query(&sample, 1, &height, &normal);
+            CHECK_NEAR(height, kOrigin.y + heights[z * columns + x], 1e-5);
+            CHECK_NEAR(glm::length(normal), 1.0, 1e-5);
+        }
+    }
+
+    // 格子中心為四角平均
+    glm::vec3 center = kOrigin + glm::vec3(1.5f * kCellSize, 0.0f, 2.5f * kCellSize);
+    float height;
+    glm::vec3 normal;
+    terrain.query(&center, 1, &height, &normal);
+    float average = 0.25f * (heights[2 * columns + 1] + heights[2 * columns + 2] +
+                             heights[3 * columns + 1] + heights[3 * columns + 2]);
+    CHECK_NEAR(height, kOrigin.y + average, 1e-5);
+}
+
+void testDetect() {
+    std::vector<float> heights(4 * 4, 0.0f);
+    HeightfieldCollider terrain;
+    CHECK(terrain.build(heights, 4, 4, kOrigin, kCellSize));
+
+    const float radius = 0.05f;
+    glm::vec3 inside = kOrigin + glm::vec3(0.3f, 0.0f, 0.3f);
+    std::vector<glm::vec3> positions;
+    for (int i = 0; i < 20; ++i) {
+        // 只有 5 和 13 號粒子靠近地形；13 號在地形下方
+        float y = i == 5 ? 0.02f : (i == 13 ? -0.1f : 0.5f);
+        positions.push_back(inside + glm::vec3(0.0f, y, 0.0f));
+    }
+
+    std::vector<OGCContact> contacts;
+    terrain.detect(positions, radius, contacts, ParallelSettings(4, true));
+    CHECK(contacts.size() == 2);
+    if (contacts.size() != 2) return;
+    CHECK(contacts[0].particleIndexA == 5 && contacts[1].particleIndexA == 13);
+    CHECK_NEAR(contacts[0].penetrationDepth, radius - 0.02, 1e-5);
+    CHECK_NEAR(contacts[1].penetrationDepth, radius + 0.1, 1e-5);
+    CHECK_NEAR(contacts[1].contactPoint.y, kOrigin.y, 1e-5);
+    CHECK_NEAR(contacts[1].contactNormal.y, 1.0, 1e-6);
+}
+
+} // namespace
+
+int main() {
+    testPlane();
+    testBilinear();
+    testDetect();
+    return TEST_RESULT();
+}
@@ -0,0 +1,128 @@
+#include "TestSupport.h"
+#include "physics/ClothSimulation.h"
+#include "physics/NarrowBand.h"
+#include <cstdint>
+#include <vector>
+
+using namespace Physics;
+
+namespace {
+
+float nextSigned(uint32_t& state) {
+    state = state * 1664525u + 1013904223u;
+    return static_cast<float>(state >> 8) / static_cast<float>(1u << 23) - 1.0f;
+}
+
+/**
+ * @brief 帶外粒子在位移不超過餘量前不可能進入接觸距離 (保守性)
+ */
+void testConservative() {
+    const int width = 32, height = 32;
+    const float contactDistance = 0.06f, slack = 0.1f;
+    NarrowBand band(slack, 8);
+    band.setGridTopology(width, height);
+
+    // 斜坡：格子一端貼著地面 (y = 0)，另一端遠離
+    std::vector<glm::vec3> positions;
+    for (int j = 0; j < height; ++j) {
+        for (int i = 0; i < width; ++i) {
+            positions.push_back(glm::vec3(0.1f * i, 0.05f * i + 0.01f, 0.1f * j));
+        }
+    }
+    auto floorDistance = [](const glm::vec3& position) { return position.y; };
+
+    auto checkMask = [&](const std::vector<char>& skip) {
+        int candidates = 0;
+        bool conservative = true;
+        for (size_t i = 0; i < positions.size(); ++i) {
+            conservative = conservative && (!skip[i] || floorDistance(positions[i]) >= contactDistance);
+            candidates += skip[i] ? 0 : 1;
+        }
+        CHECK(conservative);
+        CHECK(candidates == band.getCandidateCount());
+    };
+
+    const std::vector<char>& first = band.update(positions, contactDistance, floorDistance, ParallelSettings(4, true));
+    CHECK(first.size() == positions.size());
+    checkMask(first);
+    CHECK(band.getClusterCount() == 16);
+    CHECK(band.getRebuiltClusterCount() == 16);
+    CHECK(band.getCulledClusterCount() > 0);
+    CHECK(band.getCandidateCount() > 0 && band.getCandidateCount() < width * height);
+
+    // 小於餘量的抖動不觸發重建，遮罩仍保守
+    uint32_t state = 3u;
+    std::vector<glm::vec3> anchors = positions;
+    for (int step = 0; step < 10; ++step) {
+        for (size_t i = 0; i < positions.size(); ++i) {
+            positions[i] = anchors[i] + 0.05f * glm::vec3(nextSigned(state), nextSigned(state), nextSigned(state));
+        }
+        checkMask(band.update(positions, contactDistance, floorDistance, ParallelSettings(4, true)));
+        CHECK(band.getRebuiltClusterCount() == 0);
+    }
+
+    // 遠端的一個粒子落到地面：只重建其所在簇，並成為候選
+    int dropped = 31 * width + 31;
+    positions[dropped].y = 0.0f;
+    const std::vector<char>& moved = band.update(positions, contactDistance, floorDistance, ParallelSettings(1, true));
+    CHECK(band.getRebuiltClusterCount() == 1);
+    CHECK(!moved[dropped]);
+    checkMask(moved);
+
+    // reset 後全部重建
+    band.reset();
+    band.update(positions, contactDistance, floorDistance, ParallelSettings(1, true));
+    CHECK(band.getRebuiltClusterCount() == 16);
+}
+
+uint64_t runScene(bool narrowBand) {
+    ClothSimulation simulation;
+    CHECK(simulation.initialize(24, 24, glm::vec2(2.0f, 2.0f), glm::vec3(0.0f, 3.0f, 0.0f)));
+    simulation.setThreadCount(4);
+    simulation.setDeterministic(true);
+    simulation.addCylinder(glm::vec3(0.0f, 1.0f, 0.0f), 0.5f, 1.0f);
+    simulation.addFloor(glm::vec3(0.0f, -1.0f, 0.0f), glm::vec3(5.0f, 0.1f, 5.0f));
+    simulation.setNarrowBandEnabled(narrowBand);
+    simulation.setContactCacheEnabled(true);
+
+    int skippedSteps = 0;
+    for (int step = 0; step < 150; ++step) {
+        simulation.update(1.0f / 60.0f);
+        if (narrowBand) {
+            int particleCount = static_cast<int>(simulation.getParticles().size());
+            skippedSteps += simulation.getNarrowBand()->getCandidateCount() < particleCount ? 1 : 0;
+        }
+    }
+    CHECK(!simulation.getContacts().empty());
+    CHECK(!narrowBand || skippedSteps > 0);
+    return simulation.getStateHash();
+}
+
+/**
+ * @brief 模擬中啟用窄帶不改變結果；cleanup 釋放窄帶後可重新初始化
+ */
+void testSimulation() {
+    CHECK(runScene(true) == runScene(false));
+
+    ClothSimulation simulation;
+    CHECK(simulation.initialize(16, 16));
+    simulation.setNarrowBandEnabled(true);
+    simulation.addFloor(glm::vec3(0.0f, 2.5f, 0.0f), glm::vec3(5.0f, 0.1f, 5.0f));
+    simulation.update(1.0f / 60.0f);
+    CHECK(simulation.getNarrowBand() != nullptr);
+
+    simulation.cleanup();
+    CHECK(simulation.getNarrowBand() == nullptr);
+    CHECK(simulation.initialize(12, 12));
+    simulation.addFloor(glm::vec3(0.0f, 2.5f, 0.0f), glm::vec3(5.0f, 0.1f, 5.0f));
+    simulation.update(1.0f / 60.0f);
+    CHECK(simulation.getNarrowBand()->getClusterCount() == 4);
+}
+
+} // namespace
+
+int main() {
+    testConservative();
+    testSimulation();
+    return TEST_RESULT();
+}
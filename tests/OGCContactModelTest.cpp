@@ -0,0 +1,385 @@
+#include "TestSupport.h"
+#include "physics/OGCContactModel.h"
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace Physics;
+
+namespace {
+
+float nextUnit(uint32_t& state) {
+    state = state * 1664525u + 1013904223u;
+    return static_cast<float>(state >> 8) / static_cast<float>(1u << 24);
+}
+
+float nextSigned(uint32_t& state) {
+    return 2.0f * nextUnit(state) - 1.0f;
+}
+
+glm::vec3 nextDirection(uint32_t& state) {
+    glm::vec3 v(nextSigned(state), nextSigned(state), nextSigned(state));
+    return glm::length(v) > 1e-3f ? glm::normalize(v) : glm::vec3(0.0f, 1.0f, 0.0f);
+}
+
+ParticleList<float> makeParticles(int count, uint32_t seed) {
+    uint32_t state = seed;
+    ParticleList<float> particles;
+    for (int i = 0; i < count; ++i) {
+        glm::vec3 position(nextSigned(state), nextSigned(state), nextSigned(state));
+        auto particle = std::make_unique<Particle>(position, 0.05f + 0.1f * nextUnit(state));
+        particle->setVelocity(0.01f * nextDirection(state));
+        if (i % 17 == 0) particle->setFixed(true);
+        particles.push_back(std::move(particle));
+    }
+    return particles;
+}
+
+/**
+ * @brief 各類接觸混合：靜態、粒子對、點-面與邊-邊，粒子在多個接觸中重複出現
+ */
+std::vector<OGCContact> makeContacts(int particleCount, int contactCount, uint32_t seed) {
+    uint32_t state = seed;
+    auto pick = [&]() { return static_cast<int>(nextUnit(state) * particleCount) % particleCount; };
+
+    std::vector<OGCContact> contacts;
+    for (int k = 0; k < contactCount; ++k) {
+        OGCContact contact;
+        contact.particleIndexA = pick();
+        switch (k % 4) {
+        case 0:
+            contact.featureId = k % 5;
+            contact.colliderVelocity = 0.1f * nextDirection(state);
+            break;
+        case 1:
+            contact.particleIndexB = pick();
+            break;
+        case 2: {
+            contact.particleIndexB = pick();
+            contact.particleIndexB1 = pick();
+            contact.particleIndexB2 = pick();
+            float u = nextUnit(state), v = (1.0f - u) * nextUnit(state);
+            contact.weightsB = glm::vec3(1.0f - u - v, u, v);
+            break;
+        }
+        default: {
+            contact.particleIndexA1 = pick();
+            contact.particleIndexB = pick();
+            contact.particleIndexB1 = pick();
+            float s = nextUnit(state), t = nextUnit(state);
+            contact.weightsA = glm::vec2(1.0f - s, s);
+            contact.weightsB = glm::vec3(1.0f - t, t, 0.0f);
+            break;
+        }
+        }
+        contact.contactNormal = nextDirection(state);
+        contact.contactPoint = glm::vec3(nextSigned(state), nextSigned(state), nextSigned(state));
+        contact.penetrationDepth = 0.02f * nextUnit(state);
+        contact.previousForce = k % 3 == 0 ? 5.0f * nextUnit(state) : -1.0f;
+        contacts.push_back(contact);
+    }
+    return contacts;
+}
+
+/**
+ * @brief 多執行緒按粒子歸屬施加力與修正，結果與單執行緒串行累加逐位相同
+ */
+void testParallelMatchesSerial() {
+    const int particleCount = 300;
+    OGCContactModel model;
+    model.setWarmStartFactor(0.5f);
+
+    ParticleList<float> reference = makeParticles(particleCount, 21u);
+    std::vector<OGCContact> referenceContacts = makeContacts(particleCount, 2000, 33u);
+    model.processContacts(referenceContacts, reference, 1.0f / 60.0f, ParallelSettings(1, true));
+
+    // 有實際移動，否則比較沒有意義
+    ParticleList<float> untouched = makeParticles(particleCount, 21u);
+    int moved = 0;
+    for (int i = 0; i < particleCount; ++i) {
+        moved += reference[i]->getPosition() != untouched[i]->getPosition();
+    }
+    CHECK(moved > particleCount / 2);
+
+    for (int threadCount : {2, 4, 16}) {
+        for (bool deterministic : {true, false}) {
+            ParticleList<float> particles = makeParticles(particleCount, 21u);
+            std::vector<OGCContact> contacts = makeContacts(particleCount, 2000, 33u);
+            model.processContacts(contacts, particles, 1.0f / 60.0f, ParallelSettings(threadCount, deterministic, 16));
+
+            bool identical = true;
+            for (int i = 0; i < particleCount; ++i) {
+                identical = identical && particles[i]->getPosition() == reference[i]->getPosition() &&
+                            particles[i]->getPreviousPosition() == reference[i]->getPreviousPosition() &&
+                            particles[i]->getAccumulatedForce() == reference[i]->getAccumulatedForce();
+            }
+            for (size_t k = 0; k < contacts.size(); ++k) {
+                identical = identical && contacts[k].contactForce == referenceContacts[k].contactForce &&
+                            contacts[k].forceDirection == referenceContacts[k].forceDirection;
+            }
+            if (!identical) {
+                std::fprintf(stderr, "processContacts differs at %d threads (deterministic=%d)\n", threadCount,
+                             deterministic);
+            }
+            CHECK(identical);
+        }
+    }
+}
+
+/**
+ * @brief 8 通道批次核心 (接觸數不是 8 的倍數，含未穿透與熱啟動接觸) 與逐接觸的標量算式逐位相同
+ */
+void testForceKernelMatchesScalarPath() {
+    const int particleCount = 64;
+    OGCContactModel model(0.04f, 800.0f, 30.0f);
+    model.setWarmStartFactor(0.3f);
+
+    std::vector<OGCContact> contacts = makeContacts(particleCount, 203, 5u);
+    for (size_t k = 0; k < contacts.size(); k += 5) {
+        contacts[k].penetrationDepth = -0.01f;     // 未穿透：只有阻尼
+    }
+
+    // 參考值在粒子被修改之前求出
+    ParticleList<float> particles = makeParticles(particleCount, 9u);
+    std::vector<OGCContact> expected = contacts;
+    for (OGCContact& contact : expected) {
+        contact.offsetGeometry = model.calculateOffsetGeometry(contact);
+        model.calculateContactForce(contact, particles, 1.0f / 60.0f);
+    }
+
+    model.processContacts(contacts, particles, 1.0f / 60.0f);
+    bool identical = true;
+    int positive = 0;
+    for (size_t k = 0; k < contacts.size(); ++k) {
+        identical = identical && contacts[k].offsetGeometry == expected[k].offsetGeometry &&
+                    contacts[k].contactForce == expected[k].contactForce &&
+                    contacts[k].forceDirection == expected[k].forceDirection;
+        positive += contacts[k].contactForce > 0.0f;
+    }
+    CHECK(identical);
+    CHECK(positive > 0 && positive < static_cast<int>(contacts.size()));
+}
+
+/**
+ * @brief 接觸相對檢測時位置的剩餘穿透深度 (與 projectContacts 的定義相同)
+ */
+float residualDepth(const OGCContact& contact, const ParticleList<float>& particles,
+                    const std::vector<glm::vec3>& anchors) {
+    auto displacement = [&](int index) { return particles[index]->getPosition() - anchors[index]; };
+    glm::vec3 moved = contact.weightsA.x * displacement(contact.particleIndexA);
+    if (contact.particleIndexA1 >= 0) moved += contact.weightsA.y * displacement(contact.particleIndexA1);
+    if (contact.particleIndexB >= 0) moved -= contact.weightsB.x * displacement(contact.particleIndexB);
+    if (contact.particleIndexB1 >= 0) moved -= contact.weightsB.y * displacement(contact.particleIndexB1);
+    if (contact.particleIndexB2 >= 0) moved -= contact.weightsB.z * displacement(contact.particleIndexB2);
+    return contact.penetrationDepth - glm::dot(moved, contact.contactNormal);
+}
+
+std::vector<glm::vec3> capturePositions(const ParticleList<float>& particles) {
+    std::vector<glm::vec3> positions;
+    for (const auto& particle : particles) positions.push_back(particle->getPosition());
+    return positions;
+}
+
+/**
+ * @brief 單一靜態接觸：投影只補足剩餘深度，已解除的接觸不再移動粒子
+ */
+void testProjectionResolvesStaticContact() {
+    ParticleList<float> particles;
+    particles.push_back(std::make_unique<Particle>(glm::vec3(0.0f), 0.1f));
+    std::vector<glm::vec3> anchors = capturePositions(particles);
+
+    std::vector<OGCContact> contacts(1);
+    contacts[0].particleIndexA = 0;
+    contacts[0].contactNormal = glm::vec3(0.0f, 1.0f, 0.0f);
+    contacts[0].penetrationDepth = 0.03f;
+
+    // 約束迭代已把粒子沿法線推出 0.01：只剩 0.02
+    particles[0]->setPosition(glm::vec3(0.0f, 0.01f, 0.0f));
+    OGCContactModel model;
+    model.projectContacts(contacts, particles, anchors);
+    CHECK_NEAR(particles[0]->getPosition().y, 0.03, 1e-6);
+    CHECK_NEAR(residualDepth(contacts[0], particles, anchors), 0.0, 1e-6);
+
+    glm::vec3 resolved = particles[0]->getPosition();
+    model.projectContacts(contacts, particles, anchors);
+    CHECK(particles[0]->getPosition() == resolved);
+
+    // 固定粒子不移動
+    particles[0]->setFixed(true);
+    particles[0]->setPosition(glm::vec3(0.0f));
+    model.projectContacts(contacts, particles, anchors);
+    CHECK(particles[0]->getPosition() == glm::vec3(0.0f));
+}
+
+/**
+ * @brief 重複投影使剩餘穿透持續下降，且結果與執行緒數無關
+ */
+void testProjectionReducesPenetration() {
+    const int particleCount = 300;
+    std::vector<OGCContact> contacts = makeContacts(particleCount, 1200, 41u);
+
+    auto totalPenetration = [&](const ParticleList<float>& particles, const std::vector<glm::vec3>& anchors) {
+        double total = 0.0;
+        for (const OGCContact& contact : contacts) {
+            total += std::max(0.0f, residualDepth(contact, particles, anchors));
+        }
+        return total;
+    };
+
+    ParticleList<float> reference = makeParticles(particleCount, 3u);
+    std::vector<glm::vec3> anchors = capturePositions(reference);
+    OGCContactModel model;
+    const double initial = totalPenetration(reference, anchors);
+    double previous = initial;
+    for (int iteration = 0; iteration < 20; ++iteration) {
+        model.projectContacts(contacts, reference, anchors, ParallelSettings(1, true));
+        double current = totalPenetration(reference, anchors);
+        CHECK(current <= previous + 1e-6);
+        previous = current;
+    }
+    CHECK(initial > 1.0);
+    CHECK(previous < 0.5 * initial);     // 隨機法線互相衝突，不必完全解除
+
+    for (int threadCount : {2, 4, 16}) {
+        ParticleList<float> particles = makeParticles(particleCount, 3u);
+        for (int iteration = 0; iteration < 20; ++iteration) {
+            model.projectContacts(contacts, particles, anchors, ParallelSettings(threadCount, true, 16));
+        }
+        bool identical = true;
+        for (int i = 0; i < particleCount; ++i) {
+            identical = identical && particles[i]->getPosition() == reference[i]->getPosition();
+        }
+        CHECK(identical);
+    }
+}
+
+/**
+ * @brief 單一靜態接觸沿法線推開粒子
+ */
+void testStaticContactPushesAlongNormal() {
+    ParticleList<float> particles;
+    particles.push_back(std::make_unique<Particle>(glm::vec3(0.0f, -0.01f, 0.0f), 0.1f));
+
+    std::vector<OGCContact> contacts(1);
+    contacts[0].particleIndexA = 0;
+    contacts[0].contactNormal = glm::vec3(0.0f, 1.0f, 0.0f);
+    contacts[0].contactPoint = glm::vec3(0.0f);
+    contacts[0].penetrationDepth = 0.03f;
+
+    OGCContactModel model;
+    model.processContacts(contacts, particles, 1.0f / 60.0f);
+
+    CHECK(particles[0]->getPosition().y > -0.01f);
+    CHECK_NEAR(particles[0]->getPosition().x, 0.0, 1e-7);
+    CHECK(contacts[0].contactForce > 0.0f);
+    CHECK(particles[0]->getAccumulatedForce().y > 0.0f);
+}
+
+OGCContact staticContact(int particle, const glm::vec3& normal, float depth, int feature) {
+    OGCContact contact;
+    contact.particleIndexA = particle;
+    contact.contactNormal = glm::normalize(normal);
+    contact.penetrationDepth = depth;
+    contact.featureId = feature;
+    return contact;
+}
+
+bool sameContacts(const std::vector<OGCContact>& a, const std::vector<OGCContact>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t k = 0; k < a.size(); ++k) {
+        if (a[k].particleIndexA != b[k].particleIndexA || a[k].particleIndexB != b[k].particleIndexB ||
+            a[k].featureId != b[k].featureId || a[k].penetrationDepth != b[k].penetrationDepth ||
+            a[k].contactNormal != b[k].contactNormal) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 接觸合併：近似重複者併為最深接觸 (法線按深度加權平均)，超出預算的淺接觸捨棄，
+ *        其他類型的接觸原樣附在後面；結果與輸入順序和執行緒數無關
+ */
+void testReduceContacts() {
+    std::vector<OGCContact> contacts;
+    // 粒子 0：三個近似重複的地面接觸
+    contacts.push_back(staticContact(0, glm::vec3(0.1f, 1.0f, 0.0f), 0.01f, 0));
+    contacts.push_back(staticContact(0, glm::vec3(0.0f, 1.0f, 0.0f), 0.03f, 1));
+    contacts.push_back(staticContact(0, glm::vec3(-0.1f, 1.0f, 0.1f), 0.02f, 2));
+    // 粒子 1：四個互相垂直的接觸，預算 3
+    contacts.push_back(staticContact(1, glm::vec3(1.0f, 0.0f, 0.0f), 0.02f, 0));
+    contacts.push_back(staticContact(1, glm::vec3(0.0f, 1.0f, 0.0f), 0.04f, 0));
+    contacts.push_back(staticContact(1, glm::vec3(0.0f, 0.0f, 1.0f), 0.01f, 0));
+    contacts.push_back(staticContact(1, glm::vec3(-1.0f, 0.0f, 0.0f), 0.03f, 0));
+    // 不參與合併：粒子對、點-面與撞擊接觸
+    OGCContact pair = staticContact(0, glm::vec3(0.0f, 1.0f, 0.0f), 0.01f, -1);
+    pair.particleIndexB = 2;
+    OGCContact stencil = pair;
+    stencil.particleIndexB1 = 3;
+    stencil.particleIndexB2 = 4;
+    OGCContact impact = staticContact(0, glm::vec3(0.0f, 1.0f, 0.0f), 0.05f, 0);
+    impact.timeOfImpact = 0.5f;
+    contacts.insert(contacts.begin() + 2, pair);
+    contacts.push_back(stencil);
+    contacts.push_back(impact);
+    // 粒子 2：單一接觸原樣保留
+    contacts.push_back(staticContact(2, glm::vec3(0.0f, 0.0f, -1.0f), 0.02f, 3));
+
+    OGCContactModel model;
+    model.setReductionBudget(3);
+    model.setReductionCosine(0.9f);
+    std::vector<OGCContact> reduced = contacts;
+    model.reduceContacts(reduced, 5);
+
+    CHECK(reduced.size() == 8);
+    CHECK(model.getReducedContactCount() == static_cast<int>(contacts.size() - reduced.size()));
+    if (reduced.size() != 8) return;
+
+    // 粒子 0 的簇以最深接觸 (特徵 1) 代表
+    CHECK(reduced[0].particleIndexA == 0 && reduced[0].featureId == 1);
+    CHECK(reduced[0].penetrationDepth == 0.03f);
+    glm::vec3 weighted = 0.03f * contacts[1].contactNormal + 0.02f * contacts[3].contactNormal +
+                         0.01f * contacts[0].contactNormal;
+    CHECK_NEAR(glm::length(reduced[0].contactNormal - glm::normalize(weighted)), 0.0, 1e-6);
+
+    // 粒子 1 保留最深的三個，按深度遞減
+    CHECK(reduced[1].particleIndexA == 1 && reduced[1].penetrationDepth == 0.04f);
+    CHECK(reduced[2].penetrationDepth == 0.03f && reduced[3].penetrationDepth == 0.02f);
+    CHECK(reduced[3].contactNormal == glm::vec3(1.0f, 0.0f, 0.0f));
+
+    CHECK(reduced[4].particleIndexA == 2 && reduced[4].featureId == 3);
+    CHECK(reduced[5].particleIndexB == 2 && !reduced[5].isStencilContact());
+    CHECK(reduced[6].isStencilContact());
+    CHECK(reduced[7].isImpactContact());
+
+    // 輸入順序與執行緒數不影響結果：合併接觸倒序，其他接觸 (保持相對順序) 移到最前
+    std::vector<OGCContact> shuffled;
+    for (const OGCContact& contact : contacts) {
+        if (contact.particleIndexB >= 0 || contact.isImpactContact()) shuffled.push_back(contact);
+    }
+    for (auto it = contacts.rbegin(); it != contacts.rend(); ++it) {
+        if (it->particleIndexB < 0 && !it->isImpactContact()) shuffled.push_back(*it);
+    }
+    model.reduceContacts(shuffled, 5, ParallelSettings(4, true, 1));
+    CHECK(sameContacts(shuffled, reduced));
+
+    // 預算為 1 時粒子 1 只剩最深的接觸
+    model.setReductionBudget(1);
+    std::vector<OGCContact> single = contacts;
+    model.reduceContacts(single, 5);
+    CHECK(single.size() == 6);
+    CHECK(single[1].particleIndexA == 1 && single[1].penetrationDepth == 0.04f);
+}
+
+} // namespace
+
+int main() {
+    testParallelMatchesSerial();
+    testForceKernelMatchesScalarPath();
+    testStaticContactPushesAlongNormal();
+    testProjectionResolvesStaticContact();
+    testProjectionReducesPenetration();
+    testReduceContacts();
+    return TEST_RESULT();
+}
@@ -0,0 +1,64 @@
+#include "TestSupport.h"
+#include "physics/ClothSimulation.h"
+#include "physics/Particle.h"
+#include <algorithm>
+
+using namespace Physics;
+
+namespace {
+
+template <typename Real>
+Real fallFrom(Real height, int steps, Real deltaTime) {
+    BasicParticle<Real> particle(Vec3T<Real>(Real(0), height, Real(0)), Real(1));
+    for (int step = 0; step < steps; ++step) {
+        particle.addForce(Vec3T<Real>(Real(0), Real(-9.81), Real(0)));
+        particle.update(deltaTime);
+    }
+    return particle.getPosition().y - height;
+}
+
+} // namespace
+
+int main() {
+    // Verlet 從靜止開始：n 步後位移為 a dt^2 n(n+1)/2
+    const int steps = 120;
+    const double deltaTime = 1.0 / 60.0;
+    const double expected = -9.81 * deltaTime * deltaTime * steps * (steps + 1) / 2.0;
+
+    // double 粒子在大座標下仍保持精確
+    CHECK_NEAR(fallFrom<double>(1.0e5, steps, deltaTime), expected, 1e-6);
+
+    // 原點附近 float 與 double 一致
+    CHECK_NEAR(fallFrom<float>(1.0f, steps, static_cast<float>(deltaTime)), expected, 1e-3);
+
+    // float 在 1e5 處每步位移小於一個 ulp，粒子停住 (double 模板存在的原因)
+    CHECK(std::fabs(fallFrom<float>(1.0e5f, steps, static_cast<float>(deltaTime)) - expected) > 1.0);
+
+    // float 與 double 布料在相同場景下結果接近
+    ClothSimulation clothF;
+    ClothSimulationD clothD;
+    CHECK(clothF.initialize(10, 10));
+    CHECK(clothD.initialize(10, 10));
+    clothF.setParticleFixed(0, true);
+    clothD.setParticleFixed(0, true);
+    for (int step = 0; step < 60; ++step) {
+        clothF.update(1.0f / 60.0f);
+        clothD.update(1.0 / 60.0);
+    }
+    double maxDifference = 0.0;
+    for (size_t i = 0; i < clothF.getParticles().size(); ++i) {
+        glm::dvec3 difference = glm::dvec3(clothF.getParticles()[i]->getPosition()) -
+                                clothD.getParticles()[i]->getPosition();
+        maxDifference = std::max(maxDifference, glm::length(difference));
+    }
+    CHECK(maxDifference < 1e-3);
+
+    // 混合精度：世界座標為 double 原點加 float 局部座標
+    glm::dvec3 origin(1.0e7, -2.0e6, 3.5e6);
+    clothF.setWorldOrigin(origin);
+    glm::dvec3 world = clothF.getWorldPosition(5);
+    glm::dvec3 local(clothF.getParticles()[5]->getPosition());
+    CHECK(world == origin + local);
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,141 @@
+#include "TestSupport.h"
+#include "physics/SdfCollider.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+using namespace Physics;
+
+namespace {
+
+const glm::vec3 kHalfExtents(0.5f, 0.3f, 0.4f);
+
+/**
+ * @brief 以中心在原點的盒子建立三角形網格 (逆時針為外側)
+ */
+void makeBox(std::vector<glm::vec3>& vertices, std::vector<glm::ivec3>& triangles) {
+    for (int i = 0; i < 8; ++i) {
+        vertices.push_back(glm::vec3(i & 1 ? kHalfExtents.x : -kHalfExtents.x,
+                                     i & 2 ? kHalfExtents.y : -kHalfExtents.y,
+                                     i & 4 ? kHalfExtents.z : -kHalfExtents.z));
+    }
+    const int faces[6][4] = {{0, 2, 6, 4}, {1, 3, 7, 5}, {0, 1, 5, 4}, {2, 3, 7, 6}, {0, 1, 3, 2}, {4, 5, 7, 6}};
+    for (const auto& face : faces) {
+        glm::ivec3 first(face[0], face[1], face[2]);
+        glm::ivec3 second(face[0], face[2], face[3]);
+        for (glm::ivec3 triangle : {first, second}) {
+            glm::vec3 a = vertices[triangle.x], b = vertices[triangle.y], c = vertices[triangle.z];
+            if (glm::dot(glm::cross(b - a, c - a), a + b + c) < 0.0f) {
+                std::swap(triangle.y, triangle.z);
+            }
+            triangles.push_back(triangle);
+        }
+    }
+}
+
+float boxDistance(const glm::vec3& p) {
+    glm::vec3 q = glm::abs(p) - kHalfExtents;
+    return std::min(std::max(q.x, std::max(q.y, q.z)), 0.0f) + glm::length(glm::max(q, glm::vec3(0.0f)));
+}
+
+float nextUnit(uint32_t& state) {
+    state = state * 1664525u + 1013904223u;
+    return static_cast<float>(state >> 8) / static_cast<float>(1u << 24);
+}
+
+void testDistanceMatchesAnalyticBox(const SdfCollider& sdf, float voxelSize, float bandWidth) {
+    uint32_t state = 7u;
+    std::vector<glm::vec3> points;
+    for (int i = 0; i < 2000; ++i) {
+        points.push_back(glm::vec3(1.6f * nextUnit(state) - 0.8f, 1.2f * nextUnit(state) - 0.6f,
+                                   1.4f * nextUnit(state) - 0.7f));
+    }
+
+    std::vector<float> distances(points.size());
+    std::vector<glm::vec3> gradients(points.size());
+    sdf.query(points.data(), static_cast<int>(points.size()), distances.data(), gradients.data());
+
+    for (size_t i = 0; i < points.size(); ++i) {
+        float expected = boxDistance(points[i]);
+
+        // 批次查詢與單點查詢一致
+        CHECK_NEAR(distances[i], sdf.distance(points[i]), 1e-5);
+
+        if (std::abs(expected) < bandWidth - 2.0f * voxelSize) {
+            // 帶內：三線性插值誤差在一個體素內
+            CHECK_NEAR(distances[i], expected, voxelSize);
+        } else if (std::abs(expected) > bandWidth + 2.0f * voxelSize) {
+            // 帶外：只保證符號，且不會比帶寬更近 (網格內截斷為帶寬)
+            CHECK((distances[i] > 0.0f) == (expected > 0.0f));
+            CHECK(std::abs(distances[i]) >= bandWidth - voxelSize);
+        }
+    }
+
+    // 面中心附近的梯度指向外法線
+    std::vector<glm::vec3> facePoints{glm::vec3(0.55f, 0.0f, 0.0f), glm::vec3(0.0f, -0.35f, 0.0f)};
+    float faceDistances[2];
+    glm::vec3 faceGradients[2];
+    sdf.query(facePoints.data(), 2, faceDistances, faceGradients);
+    CHECK(glm::normalize(faceGradients[0]).x > 0.95f);
+    CHECK(glm::normalize(faceGradients[1]).y < -0.95f);
+}
+
+void testDetect(SdfCollider& sdf) {
+    const float radius = 0.05f;
+    std::vector<glm::vec3> positions{glm::vec3(0.0f, 0.33f, 0.0f),     // 頂面外 0.03
+                                     glm::vec3(0.0f, 0.6f, 0.0f),      // 遠離
+                                     glm::vec3(0.52f, 0.0f, 0.1f)};    // 側面外 0.02
+    std::vector<OGCContact> contacts(1);    // 已有的接觸保留，新接觸追加
+    sdf.detect(positions, radius, contacts, ParallelSettings());
+
+    CHECK(contacts.size() == 3);
+    if (contacts.size() != 3) return;
+    CHECK(contacts[1].particleIndexA == 0 && contacts[1].particleIndexB == -1);
+    CHECK_NEAR(contacts[1].penetrationDepth, radius - 0.03, 0.01);
+    CHECK(contacts[1].contactNormal.y > 0.95f);
+    CHECK(contacts[2].particleIndexA == 2);
+    CHECK(contacts[2].contactNormal.x > 0.95f);
+}
+
+void testCache(const std::vector<glm::vec3>& vertices, const std::vector<glm::ivec3>& triangles,
+               const SdfCollider& reference) {
+    const char* path = "SdfColliderTest.cache";
+    std::remove(path);
+
+    SdfCollider written;
+    CHECK(written.build(vertices, triangles, 0.05f, 0.2f, path));
+    SdfCollider loaded;
+    CHECK(loaded.build(vertices, triangles, 0.05f, 0.2f, path));
+    CHECK(loaded.getResolution() == reference.getResolution());
+
+    glm::vec3 probe(0.1f, 0.25f, -0.2f);
+    CHECK_NEAR(loaded.distance(probe), reference.distance(probe), 1e-7);
+
+    // 輸入改變時快取失效，重新建立
+    std::vector<glm::vec3> moved = vertices;
+    for (glm::vec3& vertex : moved) vertex.y += 0.1f;
+    SdfCollider rebuilt;
+    CHECK(rebuilt.build(moved, triangles, 0.05f, 0.2f, path));
+    CHECK_NEAR(rebuilt.distance(glm::vec3(0.0f, 0.45f, 0.0f)), 0.05, 0.05);
+
+    std::remove(path);
+}
+
+} // namespace
+
+int main() {
+    std::vector<glm::vec3> vertices;
+    std::vector<glm::ivec3> triangles;
+    makeBox(vertices, triangles);
+
+    SdfCollider sdf;
+    CHECK(!sdf.isValid());
+    CHECK(sdf.build(vertices, triangles, 0.05f, 0.2f));
+    CHECK(sdf.isValid());
+
+    testDistanceMatchesAnalyticBox(sdf, 0.05f, 0.2f);
+    testDetect(sdf);
+    testCache(vertices, triangles, sdf);
+    return TEST_RESULT();
+}
@@ -0,0 +1,88 @@
+#include "TestSupport.h"
+#include "physics/ClothSimulation.h"
+#include "physics/SelfCollision.h"
+#include <algorithm>
+#include <random>
+#include <utility>
+
+using namespace Physics;
+
+namespace {
+
+std::vector<std::pair<int, int>> contactPairs(const std::vector<OGCContact>& contacts) {
+    std::vector<std::pair<int, int>> pairs;
+    for (const OGCContact& contact : contacts) {
+        pairs.emplace_back(contact.particleIndexA, contact.particleIndexB);
+    }
+    return pairs;
+}
+
+} // namespace
+
+int main() {
+    // 自碰撞預設關閉
+    ClothSimulation simulation;
+    CHECK(!simulation.isSelfCollisionEnabled());
+
+    // 對折的布條：上下兩層對應粒子在拓撲上相距超過排除環時產生接觸
+    {
+        const int width = 20;
+        std::vector<glm::vec3> positions(width);
+        for (int i = 0; i < width / 2; ++i) {
+            positions[i] = glm::vec3(0.1f * i, 0.0f, 0.0f);
+            positions[width - 1 - i] = glm::vec3(0.1f * i, 0.03f, 0.0f);
+        }
+
+        SelfCollision selfCollision(0.02f, 2);
+        selfCollision.setGridTopology(width, 1);
+        std::vector<OGCContact> contacts;
+        selfCollision.detect(positions, contacts, ParallelSettings(1, true));
+
+        // 環距離 19 - 2i > 2 的層間對：i = 0..8
+        CHECK(contacts.size() == 9);
+        for (const OGCContact& contact : contacts) {
+            CHECK(contact.particleIndexA + contact.particleIndexB == width - 1);
+            CHECK_NEAR(contact.penetrationDepth, 0.01f, 1e-5);
+            CHECK_NEAR(std::fabs(contact.contactNormal.y), 1.0f, 1e-5);
+        }
+    }
+
+    // 隨機點雲：與暴力配對結果相同，且與執行緒數無關
+    {
+        const int width = 50;
+        const int height = 40;
+        const float radius = 0.02f;
+        std::mt19937 random(7);
+        std::uniform_real_distribution<float> coordinate(0.0f, 0.6f);
+        std::vector<glm::vec3> positions(width * height);
+        for (glm::vec3& position : positions) {
+            position = glm::vec3(coordinate(random), coordinate(random), coordinate(random));
+        }
+
+        std::vector<std::pair<int, int>> expected;
+        for (int a = 0; a < width * height; ++a) {
+            for (int b = a + 1; b < width * height; ++b) {
+                bool neighbours = std::abs(a % width - b % width) <= 2 && std::abs(a / width - b / width) <= 2;
+                glm::vec3 delta = positions[a] - positions[b];
+                if (!neighbours && glm::dot(delta, delta) < 4.0f * radius * radius) {
+                    expected.emplace_back(a, b);
+                }
+            }
+        }
+        CHECK(!expected.empty());
+
+        SelfCollision selfCollision(radius, 2);
+        selfCollision.setGridTopology(width, height);
+        std::vector<OGCContact> serial;
+        std::vector<OGCContact> parallel;
+        selfCollision.detect(positions, serial, ParallelSettings(1, true));
+        selfCollision.detect(positions, parallel, ParallelSettings(4, true));
+
+        std::vector<std::pair<int, int>> found = contactPairs(serial);
+        CHECK(found == contactPairs(parallel));
+        std::sort(found.begin(), found.end());
+        CHECK(found == expected);
+    }
+
+    return TEST_RESULT();
+}
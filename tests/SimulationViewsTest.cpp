@@ -0,0 +1,80 @@
+#include "TestSupport.h"
+#include "physics/ClothSimulation.h"
+#include <cstdint>
+
+using namespace Physics;
+
+namespace {
+
+template <typename Simulation>
+bool positionsMatchParticles(const Simulation& simulation) {
+    Span<const glm::vec3> positions = simulation.getPositions();
+    if (positions.size() != simulation.getParticles().size()) return false;
+    for (size_t i = 0; i < positions.size(); ++i) {
+        if (positions[i] != glm::vec3(simulation.getParticles()[i]->getPosition())) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 位置視圖在 update / reset 後與粒子同步，且不重新配置；邊索引與約束一一對應
+ */
+template <typename Simulation>
+void testViews() {
+    Simulation simulation;
+    CHECK(simulation.getPositions().empty());
+    CHECK(simulation.getEdgeIndices().empty());
+    const uint64_t initialVersion = simulation.getTopologyVersion();
+
+    CHECK(simulation.initialize(10, 8));
+    const uint64_t version = simulation.getTopologyVersion();
+    CHECK(version > initialVersion);
+    CHECK(simulation.getPositions().size() == 80);
+    CHECK(positionsMatchParticles(simulation));
+
+    Span<const uint32_t> edges = simulation.getEdgeIndices();
+    const auto& constraints = simulation.getConstraints();
+    CHECK(edges.size() == 2 * constraints.size());
+    bool edgesMatch = true;
+    for (size_t i = 0; i < constraints.size(); ++i) {
+        edgesMatch = edgesMatch && edges[2 * i] == static_cast<uint32_t>(constraints[i].particleA) &&
+                     edges[2 * i + 1] == static_cast<uint32_t>(constraints[i].particleB) && edges[2 * i] < 80 &&
+                     edges[2 * i + 1] < 80;
+    }
+    CHECK(edgesMatch);
+
+    // 模擬步只更新內容：指標、邊索引與拓撲版本不變
+    const glm::vec3* data = simulation.getPositions().data();
+    glm::vec3 before = simulation.getPositions()[5];
+    for (int step = 0; step < 5; ++step) {
+        simulation.update(1.0f / 60.0f);
+    }
+    CHECK(simulation.getPositions().data() == data);
+    CHECK(simulation.getPositions()[5] != before);
+    CHECK(positionsMatchParticles(simulation));
+    CHECK(simulation.getEdgeIndices().data() == edges.data());
+    CHECK(simulation.getTopologyVersion() == version);
+
+    simulation.reset();
+    CHECK(simulation.getPositions()[5] == before);
+    CHECK(simulation.getTopologyVersion() == version);
+
+    // 拓撲改變時版本遞增
+    simulation.cleanup();
+    CHECK(simulation.getPositions().empty());
+    CHECK(simulation.getEdgeIndices().empty());
+    CHECK(simulation.getTopologyVersion() > version);
+    const uint64_t cleanedVersion = simulation.getTopologyVersion();
+    CHECK(simulation.initialize(4, 4));
+    CHECK(simulation.getTopologyVersion() > cleanedVersion);
+    CHECK(simulation.getPositions().size() == 16);
+    CHECK(positionsMatchParticles(simulation));
+}
+
+} // namespace
+
+int main() {
+    testViews<ClothSimulation>();
+    testViews<ClothSimulationD>();
+    return TEST_RESULT();
+}
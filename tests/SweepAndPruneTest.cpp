@@ -0,0 +1,136 @@
+#include "TestSupport.h"
+#include "physics/SweepAndPrune.h"
+#include <algorithm>
+#include <cfloat>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+using namespace Physics;
+
+namespace {
+
+float nextSigned(uint32_t& state) {
+    state = state * 1664525u + 1013904223u;
+    return static_cast<float>(state >> 8) / static_cast<float>(1u << 23) - 1.0f;
+}
+
+struct Box {
+    glm::vec3 boundsMin;
+    glm::vec3 boundsMax;
+};
+
+bool overlaps(const Box& a, const Box& b) {
+    return a.boundsMin.x <= b.boundsMax.x && b.boundsMin.x <= a.boundsMax.x &&
+           a.boundsMin.y <= b.boundsMax.y && b.boundsMin.y <= a.boundsMax.y &&
+           a.boundsMin.z <= b.boundsMax.z && b.boundsMin.z <= a.boundsMax.z;
+}
+
+std::vector<std::pair<int, int>> bruteForce(const std::vector<Box>& probes, const std::vector<Box>& colliders) {
+    std::vector<std::pair<int, int>> pairs;
+    for (int p = 0; p < static_cast<int>(probes.size()); ++p) {
+        for (int c = 0; c < static_cast<int>(colliders.size()); ++c) {
+            if (overlaps(probes[p], colliders[c])) pairs.push_back({p, c});
+        }
+    }
+    return pairs;
+}
+
+std::vector<std::pair<int, int>> sorted(const std::vector<SweepAndPrune::Pair>& pairs) {
+    std::vector<std::pair<int, int>> result;
+    for (const SweepAndPrune::Pair& pair : pairs) result.push_back({pair.probe, pair.collider});
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+void load(SweepAndPrune& sweep, const std::vector<Box>& probes, const std::vector<Box>& colliders) {
+    sweep.resize(static_cast<int>(probes.size()), static_cast<int>(colliders.size()));
+    for (size_t p = 0; p < probes.size(); ++p) {
+        sweep.setProbeBounds(static_cast<int>(p), probes[p].boundsMin, probes[p].boundsMax);
+    }
+    for (size_t c = 0; c < colliders.size(); ++c) {
+        sweep.setColliderBounds(static_cast<int>(c), colliders[c].boundsMin, colliders[c].boundsMax);
+    }
+}
+
+/**
+ * @brief 連貫運動下與暴力比對一致，交換次數遠少於首次排序，輸出順序與更新歷史無關
+ */
+void testMatchesBruteForce() {
+    uint32_t state = 13u;
+    auto randomBox = [&](float size) {
+        glm::vec3 center(2.0f * nextSigned(state), 2.0f * nextSigned(state), 2.0f * nextSigned(state));
+        glm::vec3 extent = size * (glm::vec3(1.2f) + glm::vec3(nextSigned(state), nextSigned(state), nextSigned(state)));
+        return Box{center - extent, center + extent};
+    };
+
+    std::vector<Box> probes, colliders;
+    for (int i = 0; i < 300; ++i) probes.push_back(randomBox(0.1f));
+    for (int i = 0; i < 40; ++i) colliders.push_back(randomBox(0.3f));
+    colliders.push_back(Box{glm::vec3(-FLT_MAX), glm::vec3(FLT_MAX)});      // 無界碰撞體 (平面)
+    // 端點恰好相接也算重疊
+    probes.push_back(Box{glm::vec3(5.0f), glm::vec3(6.0f)});
+    colliders.push_back(Box{glm::vec3(6.0f), glm::vec3(7.0f)});
+
+    SweepAndPrune sweep;
+    std::vector<SweepAndPrune::Pair> pairs;
+    load(sweep, probes, colliders);
+    sweep.update(pairs);
+    CHECK(sorted(pairs) == bruteForce(probes, colliders));
+    const int initialSwaps = sweep.getSwapCount();
+    CHECK(initialSwaps > 0);
+
+    for (int frame = 0; frame < 20; ++frame) {
+        for (Box& box : probes) {
+            glm::vec3 offset = 0.02f * glm::vec3(nextSigned(state), nextSigned(state), nextSigned(state));
+            box.boundsMin += offset;
+            box.boundsMax += offset;
+        }
+        for (size_t c = 0; c + 2 < colliders.size(); ++c) {
+            glm::vec3 offset(0.03f, 0.0f, -0.01f);
+            colliders[c].boundsMin += offset;
+            colliders[c].boundsMax += offset;
+        }
+        load(sweep, probes, colliders);
+        sweep.update(pairs);
+        CHECK(sorted(pairs) == bruteForce(probes, colliders));
+        CHECK(sweep.getSwapCount() < initialSwaps / 4);
+    }
+
+    // 全新的寬相從頭排序，輸出序列逐項相同
+    SweepAndPrune fresh;
+    std::vector<SweepAndPrune::Pair> freshPairs;
+    load(fresh, probes, colliders);
+    fresh.update(freshPairs);
+    bool sameOrder = freshPairs.size() == pairs.size();
+    for (size_t k = 0; sameOrder && k < pairs.size(); ++k) {
+        sameOrder = freshPairs[k].probe == pairs[k].probe && freshPairs[k].collider == pairs[k].collider;
+    }
+    CHECK(sameOrder);
+}
+
+/**
+ * @brief 同類物件不配對；數量改變時重建端點
+ */
+void testResize() {
+    SweepAndPrune sweep;
+    std::vector<Box> probes{Box{glm::vec3(0.0f), glm::vec3(1.0f)}, Box{glm::vec3(0.5f), glm::vec3(1.5f)}};
+    std::vector<Box> colliders;
+    std::vector<SweepAndPrune::Pair> pairs;
+    load(sweep, probes, colliders);
+    sweep.update(pairs);
+    CHECK(pairs.empty());
+
+    colliders.push_back(Box{glm::vec3(1.2f), glm::vec3(2.0f)});
+    load(sweep, probes, colliders);
+    sweep.update(pairs);
+    CHECK(pairs.size() == 1 && pairs[0].probe == 1 && pairs[0].collider == 0);
+}
+
+} // namespace
+
+int main() {
+    testMatchesBruteForce();
+    testResize();
+    return TEST_RESULT();
+}
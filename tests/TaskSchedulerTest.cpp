@@ -0,0 +1,271 @@
+#include "TestSupport.h"
+#include "physics/Parallel.h"
+#include "physics/TaskScheduler.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <time.h>
+#endif
+
+using namespace Physics;
+
+namespace {
+
+/**
+ * @brief 每個元素恰好被處理一次；確定性模式下區塊邊界只由 grainSize 決定
+ */
+void testChunkCoverage() {
+    for (int count : {0, 1, 63, 64, 65, 1000, 10007}) {
+        for (int threadCount : {1, 2, 4, 16}) {
+            for (bool deterministic : {true, false}) {
+                ParallelSettings settings(threadCount, deterministic, 64);
+                std::unique_ptr<std::atomic<int>[]> visits(new std::atomic<int>[count + 1]);
+                for (int i = 0; i <= count; ++i) visits[i] = 0;
+                std::atomic<bool> aligned{true};
+
+                parallelFor(count, settings, [&](int begin, int end) {
+                    if (deterministic && (begin % 64 != 0 || (end - begin != 64 && end != count))) {
+                        aligned = false;
+                    }
+                    for (int i = begin; i < end; ++i) visits[i].fetch_add(1);
+                });
+
+                bool exactlyOnce = true;
+                for (int i = 0; i < count; ++i) exactlyOnce = exactlyOnce && visits[i].load() == 1;
+                if (!exactlyOnce || !aligned) {
+                    std::fprintf(stderr, "count=%d threads=%d deterministic=%d\n", count, threadCount, deterministic);
+                }
+                CHECK(exactlyOnce);
+                CHECK(aligned);
+            }
+        }
+    }
+}
+
+/**
+ * @brief 巢狀平行迴圈 (內層在工作執行緒上提交) 完成且結果正確
+ */
+void testNestedParallelFor() {
+    const int outer = 32, inner = 2000;
+    std::vector<long> sums(outer, 0);
+    parallelFor(outer, ParallelSettings(4, true, 1), [&](int begin, int end) {
+        for (int o = begin; o < end; ++o) {
+            std::vector<long> partial(inner / 100, 0);
+            parallelFor(inner, ParallelSettings(4, true, 100), [&](int innerBegin, int innerEnd) {
+                long sum = 0;
+                for (int i = innerBegin; i < innerEnd; ++i) sum += i * (o + 1);
+                partial[innerBegin / 100] = sum;
+            });
+            for (long value : partial) sums[o] += value;
+        }
+    });
+
+    bool correct = true;
+    for (int o = 0; o < outer; ++o) {
+        correct = correct && sums[o] == static_cast<long>(inner) * (inner - 1) / 2 * (o + 1);
+    }
+    CHECK(correct);
+}
+
+struct CountTask {
+    std::atomic<int>* counter;
+    TaskScheduler* scheduler;
+    int children;
+};
+
+void countAndSpawn(void* data) {
+    CountTask& task = *static_cast<CountTask*>(data);
+    task.counter->fetch_add(1);
+    if (task.children == 0) return;
+
+    // 任務內再開一個群組：等待時只取回自己群組的任務
+    std::vector<CountTask> childData(task.children, CountTask{task.counter, task.scheduler, 0});
+    std::vector<Task> childTasks(task.children);
+    TaskGroup group(*task.scheduler);
+    for (int i = 0; i < task.children; ++i) {
+        childTasks[i].execute = &countAndSpawn;
+        childTasks[i].data = &childData[i];
+        group.run(childTasks[i]);
+    }
+    group.wait();
+}
+
+/**
+ * @brief 任務群組：等待所有任務 (含巢狀群組) 完成；工作執行緒只增不減
+ */
+void testTaskGroup() {
+    TaskScheduler& scheduler = TaskScheduler::instance();
+    scheduler.reserveWorkers(3);
+    CHECK(scheduler.getWorkerCount() >= 3);
+    scheduler.reserveWorkers(1);
+    CHECK(scheduler.getWorkerCount() >= 3);
+
+    std::atomic<int> counter{0};
+    const int parents = 50, children = 7;
+    std::vector<CountTask> data(parents, CountTask{&counter, &scheduler, children});
+    std::vector<Task> tasks(parents);
+    {
+        TaskGroup group(scheduler);
+        for (int i = 0; i < parents; ++i) {
+            tasks[i].execute = &countAndSpawn;
+            tasks[i].data = &data[i];
+            group.run(tasks[i]);
+        }
+        group.wait();
+        CHECK(counter.load() == parents * (children + 1));
+    }
+
+    // 沒有工作執行緒的排程器在提交時直接執行
+    TaskScheduler inlineScheduler;
+    CHECK(inlineScheduler.getWorkerCount() == 0);
+    std::atomic<int> inlineCounter{0};
+    CountTask inlineData{&inlineCounter, &inlineScheduler, 3};
+    Task inlineTask;
+    inlineTask.execute = &countAndSpawn;
+    inlineTask.data = &inlineData;
+    TaskGroup inlineGroup(inlineScheduler);
+    inlineGroup.run(inlineTask);
+    CHECK(inlineCounter.load() == 4);
+}
+
+/**
+ * @brief 依賴圖：每個節點都在所有前驅完成後才執行，圖可重複執行
+ */
+void testTaskGraphOrdering() {
+    TaskScheduler scheduler;
+    scheduler.configure(SchedulerSettings(4));
+
+    std::atomic<int> clock{0};
+    const int nodeCount = 24;
+    std::vector<int> finishedAt(nodeCount, -1);
+    std::vector<int> startedAt(nodeCount, -1);
+
+    TaskGraph graph;
+    for (int node = 0; node < nodeCount; ++node) {
+        graph.addNode([&, node] {
+            startedAt[node] = clock.fetch_add(1);
+            finishedAt[node] = clock.fetch_add(1);
+        });
+    }
+
+    // 菱形 0 → {1, 2} → 3，加上 3 → 4 → ... → 23 的鏈與跨越的捷徑
+    std::vector<std::pair<int, int>> edges{{0, 1}, {0, 2}, {1, 3}, {2, 3}};
+    for (int node = 3; node + 1 < nodeCount; ++node) edges.push_back({node, node + 1});
+    for (int node = 3; node + 5 < nodeCount; node += 4) edges.push_back({node, node + 5});
+    for (const auto& edge : edges) graph.addDependency(edge.first, edge.second);
+    CHECK(graph.getNodeCount() == nodeCount);
+
+    for (int run = 0; run < 50; ++run) {
+        std::fill(startedAt.begin(), startedAt.end(), -1);
+        graph.run(scheduler);
+
+        bool allRan = true;
+        for (int node = 0; node < nodeCount; ++node) allRan = allRan && startedAt[node] >= 0;
+        bool ordered = true;
+        for (const auto& edge : edges) ordered = ordered && finishedAt[edge.first] < startedAt[edge.second];
+        CHECK(allRan);
+        CHECK(ordered);
+    }
+
+    TaskGraph empty;
+    empty.run(scheduler);
+    CHECK(empty.getNodeCount() == 0);
+}
+
+/**
+ * @brief 執行緒數與綁定設定：configure 重建執行緒池，reserveWorkers 只增不減並同步設定
+ */
+void testConfigure() {
+    TaskScheduler scheduler;
+    CHECK(scheduler.getSettings().workerCount == 0 && !scheduler.getSettings().pinThreads);
+
+    scheduler.configure(SchedulerSettings(3, true, 0));
+    CHECK(scheduler.getWorkerCount() == 3);
+    CHECK(scheduler.getSettings().pinThreads && scheduler.getSettings().firstCore == 0);
+
+    std::atomic<int> counter{0};
+    std::vector<CountTask> data(20, CountTask{&counter, &scheduler, 2});
+    std::vector<Task> tasks(data.size());
+    {
+        TaskGroup group(scheduler);
+        for (size_t i = 0; i < data.size(); ++i) {
+            tasks[i].execute = &countAndSpawn;
+            tasks[i].data = &data[i];
+            group.run(tasks[i]);
+        }
+    }
+    CHECK(counter.load() == 60);
+
+    scheduler.configure(SchedulerSettings(1));
+    CHECK(scheduler.getWorkerCount() == 1);
+    CHECK(!scheduler.getSettings().pinThreads);
+    scheduler.reserveWorkers(2);
+    CHECK(scheduler.getWorkerCount() == 2 && scheduler.getSettings().workerCount == 2);
+
+    scheduler.configure(SchedulerSettings(TaskScheduler::kMaxWorkers + 10));
+    CHECK(scheduler.getWorkerCount() == TaskScheduler::kMaxWorkers);
+    scheduler.configure(SchedulerSettings(0));
+    CHECK(scheduler.getWorkerCount() == 0);
+}
+
+double threadCpuSeconds() {
+#ifdef __linux__
+    timespec now;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return now.tv_sec + 1e-9 * now.tv_nsec;
+#else
+    return 0.0;
+#endif
+}
+
+struct SleepTask {
+    std::atomic<bool> started{false};
+};
+
+void sleepAfterStart(void* data) {
+    static_cast<SleepTask*>(data)->started = true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+}
+
+/**
+ * @brief 任務被竊取後等待者休眠而非自旋：等待期間幾乎不消耗處理器時間
+ */
+void testWaitSleeps() {
+    TaskScheduler scheduler;
+    scheduler.configure(SchedulerSettings(1));
+
+    SleepTask data;
+    Task task;
+    task.execute = &sleepAfterStart;
+    task.data = &data;
+    TaskGroup group(scheduler);
+    group.run(task);
+    while (!data.started) std::this_thread::yield();     // 確保任務已在工作執行緒上
+
+    auto wallStart = std::chrono::steady_clock::now();
+    double cpuStart = threadCpuSeconds();
+    group.wait();
+    double cpu = threadCpuSeconds() - cpuStart;
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+
+    CHECK(wall > 0.1);
+    CHECK(cpu < 0.05);
+}
+
+} // namespace
+
+int main() {
+    testChunkCoverage();
+    testNestedParallelFor();
+    testTaskGroup();
+    testTaskGraphOrdering();
+    testConfigure();
+    testWaitSleeps();
+    return TEST_RESULT();
+}
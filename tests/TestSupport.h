@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cmath>
+#include <cstdio>
+
+/**
+ * @brief 最小測試支援：失敗時印出位置並計數，main 以 TEST_RESULT() 返回
+ */
+namespace Test {
+
+inline int& failureCount() {
+    static int count = 0;
+    return count;
+}
+
+} // namespace Test
+
+#define CHECK(condition)                                                                  \
+    do {                                                                                  \
+        if (!(condition)) {                                                               \
+            std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #condition); \
+            ++Test::failureCount();                                                       \
+        }                                                                                 \
+    } while (0)
+
+#define CHECK_NEAR(actual, expected, tolerance)                                           \
+    do {                                                                                  \
+        double checkActual = static_cast<double>(actual);                                 \
+        double checkExpected = static_cast<double>(expected);                             \
+        if (!(std::fabs(checkActual - checkExpected) <= (tolerance))) {                   \
+            std::fprintf(stderr, "%s:%d: CHECK_NEAR failed: %s = %g, expected %g\n",      \
+                         __FILE__, __LINE__, #actual, checkActual, checkExpected);        \
+            ++Test::failureCount();                                                       \
+        }                                                                                 \
+    } while (0)
+
+#define TEST_RESULT() (Test::failureCount() == 0 ? 0 : 1)
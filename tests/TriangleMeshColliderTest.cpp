@@ -0,0 +1,102 @@
+#include "TestSupport.h"
+#include "physics/Geometry.h"
+#include "physics/TriangleMeshCollider.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+using namespace Physics;
+
+namespace {
+
+/**
+ * @brief 起伏的網格曲面 (法線朝 +Y，逆時針為外側)
+ */
+void makeWavySurface(int resolution, std::vector<glm::vec3>& vertices, std::vector<glm::ivec3>& triangles) {
+    for (int z = 0; z <= resolution; ++z) {
+        for (int x = 0; x <= resolution; ++x) {
+            float u = static_cast<float>(x) / resolution * 2.0f - 1.0f;
+            float v = static_cast<float>(z) / resolution * 2.0f - 1.0f;
+            vertices.push_back(glm::vec3(u, 0.2f * std::sin(3.0f * u) * std::cos(2.0f * v), v));
+        }
+    }
+    int row = resolution + 1;
+    for (int z = 0; z < resolution; ++z) {
+        for (int x = 0; x < resolution; ++x) {
+            int i = z * row + x;
+            triangles.push_back(glm::ivec3(i, i + row, i + 1));
+            triangles.push_back(glm::ivec3(i + 1, i + row, i + row + 1));
+        }
+    }
+}
+
+float bruteForceDistance(const std::vector<glm::vec3>& vertices, const std::vector<glm::ivec3>& triangles,
+                         const glm::vec3& p) {
+    float best = std::numeric_limits<float>::max();
+    for (const glm::ivec3& t : triangles) {
+        const glm::vec3 &a = vertices[t.x], &b = vertices[t.y], &c = vertices[t.z];
+        glm::vec3 w = closestPointOnTriangle(p, a, b, c);
+        best = std::min(best, glm::length(p - (w.x * a + w.y * b + w.z * c)));
+    }
+    return best;
+}
+
+float nextSigned(uint32_t& state) {
+    state = state * 1664525u + 1013904223u;
+    return static_cast<float>(state >> 8) / static_cast<float>(1u << 23) - 1.0f;
+}
+
+} // namespace
+
+int main() {
+    std::vector<glm::vec3> vertices;
+    std::vector<glm::ivec3> triangles;
+    makeWavySurface(24, vertices, triangles);
+
+    TriangleMeshCollider mesh(vertices, triangles);
+    CHECK(mesh.getTriangleCount() == triangles.size());
+    CHECK(mesh.getNodeCount() > 1);
+
+    // 1. 最近點查詢與暴力搜尋一致，提示三角形不影響結果
+    uint32_t state = 99u;
+    int hint = -1;
+    for (int i = 0; i < 500; ++i) {
+        glm::vec3 p(1.2f * nextSigned(state), 0.5f * nextSigned(state), 1.2f * nextSigned(state));
+        float expected = bruteForceDistance(vertices, triangles, p);
+
+        CHECK_NEAR(mesh.distance(p), expected, 1e-5);
+
+        glm::vec3 closest;
+        bool found = mesh.closestPoint(p, std::numeric_limits<float>::max(), hint, closest);
+        CHECK(found);
+        CHECK(hint >= 0 && hint < static_cast<int>(triangles.size()));
+        CHECK_NEAR(glm::length(p - closest), expected, 1e-5);
+
+        // 搜尋半徑小於實際距離時找不到
+        int limitedHint = -1;
+        if (expected > 1e-3f) {
+            CHECK(!mesh.closestPoint(p, 0.5f * expected, limitedHint, closest));
+        }
+    }
+
+    // 2. 接觸：正面半徑內、背面穿入、遠離
+    const float radius = 0.05f;
+    glm::vec3 surface(0.0f, 0.0f, 0.0f);    // 曲面在原點高度為 0，法線朝 +Y 並向 -X 傾斜
+    OGCContact contact;
+    CHECK(mesh.generateContact(0, surface + glm::vec3(0.0f, 0.03f, 0.0f), radius, contact));
+    CHECK(contact.particleIndexA == 0 && contact.particleIndexB == -1);
+    CHECK(contact.contactNormal.y > 0.5f);
+    CHECK(contact.penetrationDepth > 0.0f && contact.penetrationDepth < radius);
+
+    OGCContact behind;
+    CHECK(mesh.generateContact(1, surface - glm::vec3(0.0f, 0.03f, 0.0f), radius, behind));
+    CHECK(behind.contactNormal.y > 0.5f);
+    CHECK(behind.penetrationDepth > radius);
+
+    OGCContact far;
+    CHECK(!mesh.generateContact(2, glm::vec3(0.0f, 0.5f, 0.0f), radius, far));
+
+    return TEST_RESULT();
+}
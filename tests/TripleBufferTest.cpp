@@ -0,0 +1,89 @@
+#include "TestSupport.h"
+#include "physics/TripleBuffer.h"
+#include <thread>
+#include <vector>
+
+using namespace Physics;
+
+namespace {
+
+struct Snapshot {
+    int sequence = 0;
+    std::vector<int> payload;   // 全部等於 sequence 時快照完整
+};
+
+/**
+ * @brief 單執行緒：讀者取得最新發布，未讀的舊快照被覆蓋，沒有新發布時沿用
+ */
+void testLatestWins() {
+    TripleBuffer<Snapshot> buffer;
+    CHECK(!buffer.hasUpdate());
+    CHECK(buffer.acquire().sequence == 0);
+
+    buffer.back().sequence = 1;
+    buffer.publish();
+    CHECK(buffer.hasUpdate());
+    CHECK(buffer.acquire().sequence == 1);
+    CHECK(!buffer.hasUpdate());
+    CHECK(buffer.acquire().sequence == 1);
+
+    for (int sequence = 2; sequence <= 4; ++sequence) {
+        buffer.back().sequence = sequence;
+        buffer.publish();
+    }
+    const Snapshot& latest = buffer.acquire();
+    CHECK(latest.sequence == 4);
+
+    // 寫者的後緩衝永遠不是讀者持有的槽位
+    buffer.back().sequence = 5;
+    CHECK(&buffer.back() != &latest);
+    CHECK(latest.sequence == 4);
+}
+
+/**
+ * @brief 並行：讀者看到的快照永遠完整且序號不倒退，最後一定看到最終快照
+ */
+void testConcurrent() {
+    TripleBuffer<Snapshot> buffer;
+    const int publishCount = 100000;
+    const size_t payloadSize = 64;
+
+    std::thread writer([&] {
+        for (int sequence = 1; sequence <= publishCount; ++sequence) {
+            Snapshot& snapshot = buffer.back();
+            snapshot.sequence = sequence;
+            snapshot.payload.assign(payloadSize, sequence);
+            buffer.publish();
+        }
+    });
+
+    int last = 0;
+    int observed = 0;
+    bool consistent = true;
+    bool monotonic = true;
+    while (last < publishCount) {
+        const Snapshot& snapshot = buffer.acquire();
+        if (snapshot.sequence == 0) continue;
+        monotonic = monotonic && snapshot.sequence >= last;
+        consistent = consistent && snapshot.payload.size() == payloadSize;
+        for (int value : snapshot.payload) {
+            consistent = consistent && value == snapshot.sequence;
+        }
+        observed += snapshot.sequence != last ? 1 : 0;
+        last = snapshot.sequence;
+    }
+    writer.join();
+
+    CHECK(consistent);
+    CHECK(monotonic);
+    CHECK(observed > 0);
+    CHECK(buffer.acquire().sequence == publishCount);
+}
+
+} // namespace
+
+int main() {
+    testLatestWins();
+    testConcurrent();
+    return TEST_RESULT();
+}